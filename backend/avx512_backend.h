@@ -0,0 +1,378 @@
+#ifndef VECGEOM_BACKEND_AVX512BACKEND_H_
+#define VECGEOM_BACKEND_AVX512BACKEND_H_
+
+#ifndef __AVX512F__
+  #error "The AVX-512 backend requires compiling with AVX-512F enabled."
+#endif
+#ifdef VECGEOM_FLOAT_PRECISION
+  #error "The AVX-512 backend is only implemented for double precision."
+#endif
+
+#include <immintrin.h>
+#include <iostream>
+#include "base/global.h"
+#include "base/lane_statistics.h"
+#include "volumes/kernel/basket.h"
+
+namespace vecgeom {
+
+struct Avx512Precision;
+struct Avx512Bool;
+
+/**
+ * Eight lane double precision backend written directly against AVX-512F
+ * intrinsics. Masks are held in opmask registers, so masked assignments are
+ * single masked moves and partial baskets are processed with masked loads
+ * and stores instead of padding.
+ */
+template <>
+struct Impl<kAvx512> {
+  typedef Avx512Precision precision_v;
+  typedef Avx512Bool      bool_v;
+  typedef Avx512Precision int_v;
+  constexpr static int kVectorSize = 8;
+  constexpr static bool early_returns = false;
+  constexpr static Precision kOne = 1;
+  constexpr static Precision kZero = 0;
+  constexpr static bool kTrue = true;
+  constexpr static bool kFalse = false;
+
+  VECGEOM_INLINE
+  static precision_v LoadUnaligned(Precision const *const source);
+
+  VECGEOM_INLINE
+  static void StoreUnaligned(precision_v const &value,
+                             Precision *const destination);
+};
+
+typedef Impl<kAvx512>::precision_v Avx512Precision;
+typedef Impl<kAvx512>::bool_v      Avx512Bool;
+
+struct Avx512Bool {
+
+  __mmask8 mask;
+
+  /**
+   * User should not assume any default value when constructing without
+   * arguments.
+   */
+  VECGEOM_INLINE
+  Avx512Bool() {}
+
+  VECGEOM_INLINE
+  Avx512Bool(const bool scalar) : mask(scalar ? 0xff : 0) {}
+
+  VECGEOM_INLINE
+  explicit Avx512Bool(const __mmask8 native) : mask(native) {}
+
+  /**
+   * \return Mask with the first lanes set, used for partial baskets.
+   */
+  VECGEOM_INLINE
+  static Avx512Bool First(const int lanes) {
+    return Avx512Bool(static_cast<__mmask8>((1u << lanes) - 1));
+  }
+
+  VECGEOM_INLINE
+  bool operator[](const int index) const { return (mask >> index) & 1; }
+
+  VECGEOM_INLINE
+  int count() const { return __builtin_popcount(mask); }
+
+  VECGEOM_INLINE
+  bool isFull() const { return mask == 0xff; }
+
+  VECGEOM_INLINE
+  bool isEmpty() const { return mask == 0; }
+
+  VECGEOM_INLINE
+  Avx512Bool& operator|=(Avx512Bool const &other) {
+    mask |= other.mask;
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  Avx512Bool& operator&=(Avx512Bool const &other) {
+    mask &= other.mask;
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  Avx512Bool operator||(Avx512Bool const &other) const {
+    return Avx512Bool(static_cast<__mmask8>(mask | other.mask));
+  }
+
+  VECGEOM_INLINE
+  Avx512Bool operator&&(Avx512Bool const &other) const {
+    return Avx512Bool(static_cast<__mmask8>(mask & other.mask));
+  }
+
+  VECGEOM_INLINE
+  Avx512Bool operator!() const {
+    return Avx512Bool(static_cast<__mmask8>(~mask));
+  }
+
+  friend inline
+  std::ostream& operator<<(std::ostream& os, Avx512Bool const &m) {
+    os << "[" << m[0];
+    for (int i = 1; i < 8; ++i) os << ", " << m[i];
+    os << "]";
+    return os;
+  }
+
+};
+
+struct Avx512Precision {
+
+  __m512d vec;
+
+  /**
+   * User should not assume any default value when constructing without
+   * arguments.
+   */
+  VECGEOM_INLINE
+  Avx512Precision() {}
+
+  VECGEOM_INLINE
+  Avx512Precision(const Precision scalar) : vec(_mm512_set1_pd(scalar)) {}
+
+  VECGEOM_INLINE
+  Avx512Precision(__m512d const &native) : vec(native) {}
+
+  VECGEOM_INLINE
+  static constexpr int Size() { return 8; }
+
+  VECGEOM_INLINE
+  Precision operator[](const int index) const {
+    Precision lanes[8] __attribute__((aligned(64)));
+    _mm512_store_pd(lanes, vec);
+    return lanes[index];
+  }
+
+  VECGEOM_INLINE
+  Avx512Precision& operator=(Precision const &scalar) {
+    vec = _mm512_set1_pd(scalar);
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  Avx512Precision& operator+=(Avx512Precision const &other) {
+    vec = _mm512_add_pd(vec, other.vec);
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  Avx512Precision& operator-=(Avx512Precision const &other) {
+    vec = _mm512_sub_pd(vec, other.vec);
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  Avx512Precision& operator*=(Avx512Precision const &other) {
+    vec = _mm512_mul_pd(vec, other.vec);
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  Avx512Precision& operator/=(Avx512Precision const &other) {
+    vec = _mm512_div_pd(vec, other.vec);
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  Avx512Precision operator-() const {
+    return _mm512_sub_pd(_mm512_setzero_pd(), vec);
+  }
+
+  // Binary operators accept scalars on either side by converting them to a
+  // broadcast vector
+
+  friend VECGEOM_INLINE
+  Avx512Precision operator+(Avx512Precision const &lhs,
+                            Avx512Precision const &rhs) {
+    return _mm512_add_pd(lhs.vec, rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  Avx512Precision operator-(Avx512Precision const &lhs,
+                            Avx512Precision const &rhs) {
+    return _mm512_sub_pd(lhs.vec, rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  Avx512Precision operator*(Avx512Precision const &lhs,
+                            Avx512Precision const &rhs) {
+    return _mm512_mul_pd(lhs.vec, rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  Avx512Precision operator/(Avx512Precision const &lhs,
+                            Avx512Precision const &rhs) {
+    return _mm512_div_pd(lhs.vec, rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  Avx512Bool operator<(Avx512Precision const &lhs,
+                       Avx512Precision const &rhs) {
+    return Avx512Bool(_mm512_cmp_pd_mask(lhs.vec, rhs.vec, _CMP_LT_OQ));
+  }
+
+  friend VECGEOM_INLINE
+  Avx512Bool operator<=(Avx512Precision const &lhs,
+                        Avx512Precision const &rhs) {
+    return Avx512Bool(_mm512_cmp_pd_mask(lhs.vec, rhs.vec, _CMP_LE_OQ));
+  }
+
+  friend VECGEOM_INLINE
+  Avx512Bool operator>(Avx512Precision const &lhs,
+                       Avx512Precision const &rhs) {
+    return Avx512Bool(_mm512_cmp_pd_mask(lhs.vec, rhs.vec, _CMP_GT_OQ));
+  }
+
+  friend VECGEOM_INLINE
+  Avx512Bool operator>=(Avx512Precision const &lhs,
+                        Avx512Precision const &rhs) {
+    return Avx512Bool(_mm512_cmp_pd_mask(lhs.vec, rhs.vec, _CMP_GE_OQ));
+  }
+
+  friend VECGEOM_INLINE
+  Avx512Bool operator==(Avx512Precision const &lhs,
+                        Avx512Precision const &rhs) {
+    return Avx512Bool(_mm512_cmp_pd_mask(lhs.vec, rhs.vec, _CMP_EQ_OQ));
+  }
+
+  friend VECGEOM_INLINE
+  Avx512Bool operator!=(Avx512Precision const &lhs,
+                        Avx512Precision const &rhs) {
+    return Avx512Bool(_mm512_cmp_pd_mask(lhs.vec, rhs.vec, _CMP_NEQ_UQ));
+  }
+
+  friend inline
+  std::ostream& operator<<(std::ostream& os, Avx512Precision const &v) {
+    os << "[" << v[0];
+    for (int i = 1; i < 8; ++i) os << ", " << v[i];
+    os << "]";
+    return os;
+  }
+
+};
+
+VECGEOM_INLINE
+Avx512Precision Impl<kAvx512>::LoadUnaligned(Precision const *const source) {
+  return _mm512_loadu_pd(source);
+}
+
+VECGEOM_INLINE
+void Impl<kAvx512>::StoreUnaligned(Avx512Precision const &value,
+                                   Precision *const destination) {
+  _mm512_storeu_pd(destination, value.vec);
+}
+
+VECGEOM_INLINE
+void CondAssign(Avx512Bool const &cond, Avx512Precision const &thenval,
+                Avx512Precision const &elseval, Avx512Precision *const output) {
+  output->vec = _mm512_mask_blend_pd(cond.mask, elseval.vec, thenval.vec);
+}
+
+VECGEOM_INLINE
+void CondAssign(Avx512Bool const &cond, Avx512Bool const &thenval,
+                Avx512Bool const &elseval, Avx512Bool *const output) {
+  output->mask = (thenval.mask & cond.mask) | (elseval.mask & ~cond.mask);
+}
+
+/**
+ * Then-values can be vectors or scalars, which are broadcast.
+ */
+template <typename Type>
+VECGEOM_INLINE
+void MaskedAssign(Avx512Bool const &cond, Type const &thenval,
+                  Avx512Precision *const output) {
+  VECGEOM_LANE_MASK(cond.count(), 8);
+  output->vec = _mm512_mask_mov_pd(output->vec, cond.mask,
+                                   Avx512Precision(thenval).vec);
+}
+
+VECGEOM_INLINE
+void MaskedAssign(Avx512Bool const &cond, Avx512Bool const &thenval,
+                  Avx512Bool *const output) {
+  VECGEOM_LANE_MASK(cond.count(), 8);
+  output->mask = (thenval.mask & cond.mask) | (output->mask & ~cond.mask);
+}
+
+VECGEOM_INLINE
+bool IsFull(Avx512Bool const &cond) {
+  const bool full = cond.isFull();
+  VECGEOM_LANE_CHECK(full);
+  return full;
+}
+
+VECGEOM_INLINE
+Avx512Precision Abs(Avx512Precision const &val) {
+  return _mm512_abs_pd(val.vec);
+}
+
+/**
+ * Uses the merging form with every lane selected, as the plain intrinsic
+ * passes an undefined pass-through register that trips -Wmaybe-uninitialized.
+ */
+VECGEOM_INLINE
+Avx512Precision Sqrt(Avx512Precision const &val) {
+  return _mm512_mask_sqrt_pd(val.vec, static_cast<__mmask8>(0xff), val.vec);
+}
+
+/**
+ * Stores the lanes selected by the mask contiguously to the destination.
+ * \return Number of values stored.
+ */
+VECGEOM_INLINE
+int CompressStore(Avx512Bool const &cond, Avx512Precision const &value,
+                  Precision *const destination) {
+  _mm512_mask_compressstoreu_pd(destination, cond.mask, value.vec);
+  return cond.count();
+}
+
+/**
+ * Loads contiguous values from the source into the lanes selected by the
+ * mask, keeping the remaining lanes of the output. Inverse of CompressStore.
+ * \return Number of values loaded.
+ */
+VECGEOM_INLINE
+int ExpandLoad(Avx512Bool const &cond, Precision const *const source,
+               Avx512Precision *const output) {
+  output->vec = _mm512_mask_expandloadu_pd(output->vec, cond.mask, source);
+  return cond.count();
+}
+
+// Partial chunks of baskets use masked memory accesses instead of padding
+
+template <>
+VECGEOM_INLINE
+Vector3D<Avx512Precision> LoadBasketChunk<kAvx512>(
+    SOA3D<Precision> const &basket, const int offset, const int lanes) {
+  const __mmask8 mask = Avx512Bool::First(lanes).mask;
+  return Vector3D<Avx512Precision>(
+    _mm512_maskz_loadu_pd(mask, basket.x() + offset),
+    _mm512_maskz_loadu_pd(mask, basket.y() + offset),
+    _mm512_maskz_loadu_pd(mask, basket.z() + offset)
+  );
+}
+
+template <>
+VECGEOM_INLINE
+Avx512Precision LoadBasketChunk<kAvx512>(Precision const *const basket,
+                                         const int offset, const int lanes) {
+  return _mm512_maskz_loadu_pd(Avx512Bool::First(lanes).mask,
+                               basket + offset);
+}
+
+template <>
+VECGEOM_INLINE
+void StoreBasketChunk<kAvx512>(Avx512Precision const &value, const int offset,
+                               const int lanes, Precision *const basket) {
+  _mm512_mask_storeu_pd(basket + offset, Avx512Bool::First(lanes).mask,
+                        value.vec);
+}
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_BACKEND_AVX512BACKEND_H_
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef VECGEOM_BACKEND_BACKEND_H_
+#define VECGEOM_BACKEND_BACKEND_H_
+
+#include "base/global.h"
+#include "backend/scalar_backend.h"
+
+/**
+ * Includes the vector backend selected when configuring, if any, and exposes
+ * it as kVectorImpl to code processing baskets in chunks of kVectorSize.
+ * VECGEOM_VECTOR_BACKEND is defined when such a backend is available.
+ */
+#if defined(VECGEOM_VC)
+  #include "backend/vc_backend.h"
+  #define VECGEOM_VECTOR_BACKEND
+#elif defined(VECGEOM_SIMD)
+  #include "backend/simd_backend.h"
+  #define VECGEOM_VECTOR_BACKEND
+#elif defined(VECGEOM_AVX512)
+  #include "backend/avx512_backend.h"
+  #define VECGEOM_VECTOR_BACKEND
+#endif
+
+#if defined(VECGEOM_MIXED_PRECISION) && \
+    (!defined(VECGEOM_SIMD) || defined(VECGEOM_FLOAT_PRECISION))
+  #error "Mixed precision requires the Simd backend in double precision."
+#endif
+
+#if defined(VECGEOM_MIXED_PRECISION) && defined(VECGEOM_ISA_DISPATCH)
+  #error "Mixed precision is not supported with runtime instruction dispatch."
+#endif
+
+#ifdef VECGEOM_VECTOR_BACKEND
+
+namespace vecgeom {
+
+#if defined(VECGEOM_VC)
+constexpr ImplType kVectorImpl = kVc;
+#elif defined(VECGEOM_SIMD)
+constexpr ImplType kVectorImpl = kSimd;
+#else
+constexpr ImplType kVectorImpl = kAvx512;
+#endif
+
+typedef Impl<kVectorImpl>::precision_v VectorPrecision;
+typedef Impl<kVectorImpl>::bool_v      VectorBool;
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_VECTOR_BACKEND
+
+#endif // VECGEOM_BACKEND_BACKEND_H_
\ No newline at end of file
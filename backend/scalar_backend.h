@@ -37,6 +37,16 @@ void MaskedAssign(const bool cond,
   *output = (cond) ? thenval : *output;
 }
 
+/**
+ * \return Whether the condition holds for all elements of the mask. Used to
+ *         exit kernels early independently of the backend.
+ */
+VECGEOM_CUDA_HEADER_BOTH
+VECGEOM_INLINE
+bool IsFull(const bool cond) {
+  return cond;
+}
+
 template <typename Type>
 VECGEOM_CUDA_HEADER_BOTH
 VECGEOM_INLINE
@@ -0,0 +1,498 @@
+#ifndef VECGEOM_BACKEND_SIMDBACKEND_H_
+#define VECGEOM_BACKEND_SIMDBACKEND_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <iostream>
+#include "base/global.h"
+#include "base/lane_statistics.h"
+
+/**
+ * Vector width in bytes. Defaults to the widest floating point registers
+ * enabled for the target, and can be overridden to build kernels at any
+ * power of two width. Translation units compiling kernels for runtime
+ * dispatch define VECGEOM_ISA_VARIANT, as their target differs from the rest
+ * of the library, and only use the fixed width backends.
+ */
+#ifndef VECGEOM_ISA_VARIANT
+#ifndef VECGEOM_SIMD_BYTES
+  #if defined(__AVX512F__)
+    #define VECGEOM_SIMD_BYTES 64
+  #elif defined(__AVX__)
+    #define VECGEOM_SIMD_BYTES 32
+  #else
+    #define VECGEOM_SIMD_BYTES 16
+  #endif
+#endif
+#endif
+
+namespace vecgeom {
+
+/**
+ * The instruction set tag keeps the types of kernels compiled for different
+ * targets distinct, so inline code is never shared between them.
+ */
+template <typename Type, int vec_size, ImplType isa>
+struct SimdVector;
+
+template <typename Type, int vec_size, ImplType isa>
+struct SimdMask;
+
+/**
+ * Integer type of the same width as a lane, as produced by comparisons of
+ * vector extension types.
+ */
+template <typename Type>
+struct SimdLane;
+
+template <>
+struct SimdLane<double> { typedef int64_t Integer; };
+
+template <>
+struct SimdLane<float> { typedef int32_t Integer; };
+
+template <>
+struct SimdLane<int> { typedef int32_t Integer; };
+
+/**
+ * Backend of the given width in bytes. Constants are scalars, which convert
+ * implicitly to vectors and masks, so no static initialization is compiled
+ * for the target instruction set. The lane type defaults to Precision. Other
+ * lane types still load from and store to Precision arrays, converting each
+ * element, so basket code is shared between them.
+ */
+template <int vec_bytes, ImplType isa, typename Type = Precision>
+struct SimdImpl {
+  constexpr static int kVectorSize = vec_bytes / sizeof(Type);
+  typedef SimdVector<int, kVectorSize, isa>  int_v;
+  typedef SimdVector<Type, kVectorSize, isa> precision_v;
+  typedef SimdMask<Type, kVectorSize, isa>   bool_v;
+  constexpr static bool early_returns = false;
+  constexpr static Type kOne = 1;
+  constexpr static Type kZero = 0;
+  constexpr static bool kTrue = true;
+  constexpr static bool kFalse = false;
+
+  VECGEOM_INLINE
+  static precision_v LoadUnaligned(Precision const *const source);
+
+  VECGEOM_INLINE
+  static void StoreUnaligned(precision_v const &value,
+                             Precision *const destination);
+};
+
+template <int vec_bytes, ImplType isa, typename Type>
+constexpr Type SimdImpl<vec_bytes, isa, Type>::kOne;
+template <int vec_bytes, ImplType isa, typename Type>
+constexpr Type SimdImpl<vec_bytes, isa, Type>::kZero;
+template <int vec_bytes, ImplType isa, typename Type>
+constexpr bool SimdImpl<vec_bytes, isa, Type>::kTrue;
+template <int vec_bytes, ImplType isa, typename Type>
+constexpr bool SimdImpl<vec_bytes, isa, Type>::kFalse;
+
+/**
+ * Widths compiled for runtime instruction set dispatch.
+ */
+template <>
+struct Impl<kSimdSse4> : public SimdImpl<16, kSimdSse4> {};
+
+template <>
+struct Impl<kSimdAvx2> : public SimdImpl<32, kSimdAvx2> {};
+
+template <>
+struct Impl<kSimdAvx512> : public SimdImpl<64, kSimdAvx512> {};
+
+#ifndef VECGEOM_ISA_VARIANT
+
+template <>
+struct Impl<kSimd> : public SimdImpl<VECGEOM_SIMD_BYTES, kSimd> {};
+
+constexpr int kVectorSize = Impl<kSimd>::kVectorSize;
+
+typedef Impl<kSimd>::int_v       SimdInt;
+typedef Impl<kSimd>::precision_v SimdPrecision;
+typedef Impl<kSimd>::bool_v      SimdBool;
+
+/**
+ * Single precision lanes of the same width, processing twice as many lanes as
+ * the double precision backend. Used by mixed precision kernels.
+ */
+template <>
+struct Impl<kSimdFloat> : public SimdImpl<VECGEOM_SIMD_BYTES, kSimdFloat,
+                                          float> {};
+
+#endif
+
+/**
+ * Lane mask with all bits of a lane set where the condition holds, matching
+ * the result of comparisons between vector extension types.
+ */
+template <typename Type, int vec_size, ImplType isa>
+struct SimdMask {
+
+  typedef SimdMask<Type, vec_size, isa> MaskType;
+  typedef typename SimdLane<Type>::Integer Lane;
+  typedef Lane Native __attribute__((vector_size(sizeof(Lane)*vec_size)));
+
+public:
+
+  Native vec;
+
+  /**
+   * User should not assume any default value when constructing without
+   * arguments.
+   */
+  VECGEOM_INLINE
+  SimdMask() {}
+
+  VECGEOM_INLINE
+  SimdMask(const bool scalar) {
+    const Native zero = {};
+    vec = zero - static_cast<Lane>(scalar);
+  }
+
+  VECGEOM_INLINE
+  SimdMask(Native const &native) : vec(native) {}
+
+  VECGEOM_INLINE
+  static constexpr int Size() { return vec_size; }
+
+  VECGEOM_INLINE
+  bool operator[](const int index) const { return vec[index] != 0; }
+
+  /**
+   * \return Number of lanes for which the condition holds.
+   */
+  VECGEOM_INLINE
+  int count() const {
+    int result = 0;
+    for (int i = 0; i < vec_size; ++i) result += (vec[i] != 0);
+    return result;
+  }
+
+  // Reductions are written without early exits, so the compiler can lower
+  // them to a few vector instructions instead of one branch per lane
+
+  VECGEOM_INLINE
+  bool isFull() const {
+    Lane all = ~Lane(0);
+    for (int i = 0; i < vec_size; ++i) all &= vec[i];
+    return all != 0;
+  }
+
+  VECGEOM_INLINE
+  bool isEmpty() const {
+    Lane any = 0;
+    for (int i = 0; i < vec_size; ++i) any |= vec[i];
+    return any == 0;
+  }
+
+  VECGEOM_INLINE
+  MaskType& operator|=(MaskType const &other) {
+    vec |= other.vec;
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  MaskType& operator&=(MaskType const &other) {
+    vec &= other.vec;
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  MaskType operator||(MaskType const &other) const {
+    return MaskType(vec | other.vec);
+  }
+
+  VECGEOM_INLINE
+  MaskType operator&&(MaskType const &other) const {
+    return MaskType(vec & other.vec);
+  }
+
+  VECGEOM_INLINE
+  MaskType operator|(MaskType const &other) const {
+    return MaskType(vec | other.vec);
+  }
+
+  VECGEOM_INLINE
+  MaskType operator&(MaskType const &other) const {
+    return MaskType(vec & other.vec);
+  }
+
+  VECGEOM_INLINE
+  MaskType operator!() const {
+    return MaskType(~vec);
+  }
+
+  friend inline
+  std::ostream& operator<<(std::ostream& os, MaskType const &m) {
+    os << "[" << m[0];
+    for (int i = 1; i < vec_size; ++i) os << ", " << m[i];
+    os << "]";
+    return os;
+  }
+
+};
+
+/**
+ * Wrapper around the vector extensions of GCC and Clang. Operations are
+ * lowered to the instruction set enabled for the target, or split into
+ * several registers for widths exceeding it, without depending on a vector
+ * library or compiler specific array notation.
+ */
+template <typename Type, int vec_size, ImplType isa>
+struct SimdVector {
+
+  typedef SimdVector<Type, vec_size, isa> VecType;
+  typedef SimdMask<Type, vec_size, isa> VecBool;
+  typedef Type Native __attribute__((vector_size(sizeof(Type)*vec_size)));
+
+public:
+
+  Native vec;
+
+  /**
+   * User should not assume any default value when constructing without
+   * arguments.
+   */
+  VECGEOM_INLINE
+  SimdVector() {}
+
+  VECGEOM_INLINE
+  SimdVector(const Type scalar) {
+    const Native zero = {};
+    vec = zero + scalar;
+  }
+
+  VECGEOM_INLINE
+  SimdVector(Native const &native) : vec(native) {}
+
+  /**
+   * Loads from memory without alignment requirements.
+   */
+  VECGEOM_INLINE
+  explicit SimdVector(Type const *const from) {
+    __builtin_memcpy(&vec, from, sizeof(vec));
+  }
+
+  VECGEOM_INLINE
+  static constexpr int Size() { return vec_size; }
+
+  VECGEOM_INLINE
+  void Store(Type *const destination) const {
+    __builtin_memcpy(destination, &vec, sizeof(vec));
+  }
+
+  VECGEOM_INLINE
+  Type operator[](const int index) const { return vec[index]; }
+
+  VECGEOM_INLINE
+  void Map(Type (*f)(const Type)) {
+    for (int i = 0; i < vec_size; ++i) vec[i] = f(vec[i]);
+  }
+
+  friend inline
+  std::ostream& operator<<(std::ostream& os, VecType const &v) {
+    os << "[" << v.vec[0];
+    for (int i = 1; i < vec_size; ++i) os << ", " << v.vec[i];
+    os << "]";
+    return os;
+  }
+
+  VECGEOM_INLINE
+  VecType& operator=(Type const &scalar) {
+    *this = VecType(scalar);
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  VecType& operator+=(VecType const &other) {
+    vec += other.vec;
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  VecType& operator-=(VecType const &other) {
+    vec -= other.vec;
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  VecType& operator*=(VecType const &other) {
+    vec *= other.vec;
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  VecType& operator/=(VecType const &other) {
+    vec /= other.vec;
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  VecType operator-() const {
+    return VecType(-vec);
+  }
+
+  // Binary operators accept scalars on either side by converting them to a
+  // broadcast vector
+
+  friend VECGEOM_INLINE
+  VecType operator+(VecType const &lhs, VecType const &rhs) {
+    return VecType(lhs.vec + rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  VecType operator-(VecType const &lhs, VecType const &rhs) {
+    return VecType(lhs.vec - rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  VecType operator*(VecType const &lhs, VecType const &rhs) {
+    return VecType(lhs.vec * rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  VecType operator/(VecType const &lhs, VecType const &rhs) {
+    return VecType(lhs.vec / rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  VecBool operator<(VecType const &lhs, VecType const &rhs) {
+    return VecBool(lhs.vec < rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  VecBool operator<=(VecType const &lhs, VecType const &rhs) {
+    return VecBool(lhs.vec <= rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  VecBool operator>(VecType const &lhs, VecType const &rhs) {
+    return VecBool(lhs.vec > rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  VecBool operator>=(VecType const &lhs, VecType const &rhs) {
+    return VecBool(lhs.vec >= rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  VecBool operator==(VecType const &lhs, VecType const &rhs) {
+    return VecBool(lhs.vec == rhs.vec);
+  }
+
+  friend VECGEOM_INLINE
+  VecBool operator!=(VecType const &lhs, VecType const &rhs) {
+    return VecBool(lhs.vec != rhs.vec);
+  }
+
+};
+
+template <int vec_bytes, ImplType isa, typename Type>
+VECGEOM_INLINE
+typename SimdImpl<vec_bytes, isa, Type>::precision_v
+SimdImpl<vec_bytes, isa, Type>::LoadUnaligned(Precision const *const source) {
+  typedef Precision Stored
+      __attribute__((vector_size(sizeof(Precision)*kVectorSize)));
+  Stored stored;
+  __builtin_memcpy(&stored, source, sizeof(stored));
+  return precision_v(
+    __builtin_convertvector(stored, typename precision_v::Native)
+  );
+}
+
+template <int vec_bytes, ImplType isa, typename Type>
+VECGEOM_INLINE
+void SimdImpl<vec_bytes, isa, Type>::StoreUnaligned(
+    precision_v const &value, Precision *const destination) {
+  typedef Precision Stored
+      __attribute__((vector_size(sizeof(Precision)*kVectorSize)));
+  const Stored stored = __builtin_convertvector(value.vec, Stored);
+  __builtin_memcpy(destination, &stored, sizeof(stored));
+}
+
+/**
+ * Selects bitwise between two vectors, which is valid for any lane type since
+ * mask lanes have either all or no bits set.
+ */
+template <typename Type, int vec_size, ImplType isa>
+VECGEOM_INLINE
+typename SimdVector<Type, vec_size, isa>::Native SimdBlend(
+    SimdMask<Type, vec_size, isa> const &cond,
+    SimdVector<Type, vec_size, isa> const &thenval,
+    SimdVector<Type, vec_size, isa> const &elseval) {
+  typedef typename SimdMask<Type, vec_size, isa>::Native Bits;
+  typedef typename SimdVector<Type, vec_size, isa>::Native Native;
+  const Bits bits = ((Bits)thenval.vec & cond.vec)
+                  | ((Bits)elseval.vec & ~cond.vec);
+  return (Native)bits;
+}
+
+template <typename Type, int vec_size, ImplType isa>
+VECGEOM_INLINE
+void CondAssign(SimdMask<Type, vec_size, isa> const &cond,
+                SimdVector<Type, vec_size, isa> const &thenval,
+                SimdVector<Type, vec_size, isa> const &elseval,
+                SimdVector<Type, vec_size, isa> *const output) {
+  output->vec = SimdBlend(cond, thenval, elseval);
+}
+
+template <typename Type, int vec_size, ImplType isa>
+VECGEOM_INLINE
+void CondAssign(SimdMask<Type, vec_size, isa> const &cond,
+                SimdMask<Type, vec_size, isa> const &thenval,
+                SimdMask<Type, vec_size, isa> const &elseval,
+                SimdMask<Type, vec_size, isa> *const output) {
+  output->vec = (thenval.vec & cond.vec) | (elseval.vec & ~cond.vec);
+}
+
+/**
+ * Then-values can be vectors or scalars, which are broadcast.
+ */
+template <typename Type1, typename Type, int vec_size, ImplType isa>
+VECGEOM_INLINE
+void MaskedAssign(SimdMask<Type, vec_size, isa> const &cond,
+                  Type1 const &thenval,
+                  SimdVector<Type, vec_size, isa> *const output) {
+  VECGEOM_LANE_MASK(cond.count(), vec_size);
+  output->vec = SimdBlend(cond, SimdVector<Type, vec_size, isa>(thenval),
+                          *output);
+}
+
+template <typename Type, int vec_size, ImplType isa>
+VECGEOM_INLINE
+void MaskedAssign(SimdMask<Type, vec_size, isa> const &cond,
+                  SimdMask<Type, vec_size, isa> const &thenval,
+                  SimdMask<Type, vec_size, isa> *const output) {
+  VECGEOM_LANE_MASK(cond.count(), vec_size);
+  output->vec = (thenval.vec & cond.vec) | (output->vec & ~cond.vec);
+}
+
+template <typename Type, int vec_size, ImplType isa>
+VECGEOM_INLINE
+bool IsFull(SimdMask<Type, vec_size, isa> const &cond) {
+  const bool full = cond.isFull();
+  VECGEOM_LANE_CHECK(full);
+  return full;
+}
+
+template <typename Type, int vec_size, ImplType isa>
+VECGEOM_INLINE
+SimdVector<Type, vec_size, isa> Abs(
+    SimdVector<Type, vec_size, isa> const &val) {
+  return SimdBlend(val < Type(0), -val, val);
+}
+
+template <typename Type, int vec_size, ImplType isa>
+VECGEOM_INLINE
+SimdVector<Type, vec_size, isa> Sqrt(
+    SimdVector<Type, vec_size, isa> const &val) {
+  SimdVector<Type, vec_size, isa> result(val);
+  for (int i = 0; i < vec_size; ++i) result.vec[i] = std::sqrt(val.vec[i]);
+  return result;
+}
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_BACKEND_SIMDBACKEND_H_
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <Vc/Vc>
 #include "base/global.h"
+#include "base/lane_statistics.h"
 
 namespace vecgeom {
 
@@ -12,10 +13,22 @@ struct Impl<kVc> {
   typedef Vc::Vector<Precision>       precision_v;
   typedef Vc::Vector<Precision>::Mask bool_v;
   constexpr static bool early_returns = false;
+  constexpr static int kVectorSize = precision_v::Size;
   const static precision_v kOne;
   const static precision_v kZero;
   const static bool_v kTrue;
   const static bool_v kFalse;
+
+  VECGEOM_INLINE
+  static precision_v LoadUnaligned(Precision const *const source) {
+    return precision_v(source, Vc::Unaligned);
+  }
+
+  VECGEOM_INLINE
+  static void StoreUnaligned(precision_v const &value,
+                             Precision *const destination) {
+    value.store(destination, Vc::Unaligned);
+  }
 };
 
 constexpr int kVectorSize = Impl<kVc>::precision_v::Size;
@@ -36,9 +49,21 @@ template <typename Type1, typename Type2>
 VECGEOM_INLINE
 void MaskedAssign(VcBool const &cond,
                   Type1 const &thenval, Type2 *const output) {
+  VECGEOM_LANE_MASK(cond.count(), kVectorSize);
   (*output)(cond) = thenval;
 }
 
+VECGEOM_INLINE
+bool IsFull(VcBool const &cond) {
+  #ifdef VECGEOM_LANE_STATISTICS
+  const bool full = cond.isFull();
+  VECGEOM_LANE_CHECK(full);
+  return full;
+  #else
+  return cond.isFull();
+  #endif
+}
+
 VECGEOM_INLINE
 VcPrecision Abs(VcPrecision const &val) {
   return Vc::abs(val);
@@ -42,7 +42,11 @@
 
 namespace vecgeom {
 
+#ifdef VECGEOM_AVX512
+const int kAlignmentBoundary = 64;
+#else
 const int kAlignmentBoundary = 32;
+#endif
 const double kDegToRad = M_PI/180.;
 const double kRadToDeg = 180./M_PI;
 const double kInfinity = INFINITY;
@@ -0,0 +1,205 @@
+#ifndef VECGEOM_BASE_INSTRUMENTATION_H_
+#define VECGEOM_BASE_INSTRUMENTATION_H_
+
+#include "base/global.h"
+
+/**
+ * Per kernel call counters and sampled timers, enabled by configuring with
+ * -DINSTRUMENTATION=ON. Entry points of placed volumes invoke
+ * VECGEOM_INSTRUMENT, which expands to nothing in regular builds.
+ */
+#if defined(VECGEOM_INSTRUMENTATION) && !defined(VECGEOM_NVCC)
+  #define VECGEOM_INSTRUMENT(shape, kernel, volume_id, points) \
+    vecgeom::KernelProbe vecgeom_kernel_probe(shape, kernel, volume_id, points)
+#else
+  #define VECGEOM_INSTRUMENT(shape, kernel, volume_id, points)
+#endif
+
+namespace vecgeom {
+
+enum InstrumentedShape {
+  kInstrumentedBox,
+  kInstrumentedShapeCount
+};
+
+/**
+ * Basket kernels count one call per basket and additionally the number of
+ * points processed.
+ */
+enum InstrumentedKernel {
+  kKernelInside,
+  kKernelDistanceToIn,
+  kKernelDistanceToOut,
+  kKernelInsideBasket,
+  kKernelDistanceToInBasket,
+  kKernelDistanceToOutBasket,
+  kKernelSafetyToIn,
+  kKernelSafetyToOut,
+  kInstrumentedKernelCount
+};
+
+} // End namespace vecgeom
+
+#if defined(VECGEOM_INSTRUMENTATION) && !defined(VECGEOM_NVCC)
+
+#include <stdint.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace vecgeom {
+
+struct KernelCounter {
+  uint64_t calls;
+  uint64_t points;
+  uint64_t sampled_calls;
+  uint64_t sampled_ns;
+};
+
+/**
+ * Counters of the calling thread. Each thread registers its counters on first
+ * use, and Instrumentation merges them on request, so updating them requires
+ * no synchronization. In turn, counters of other threads are only read while
+ * those threads do not execute kernels.
+ */
+class ThreadCounters {
+
+public:
+
+  /**
+   * One in this many calls is timed.
+   */
+  static const unsigned kSamplePeriod = 64;
+
+  KernelCounter shapes[kInstrumentedShapeCount][kInstrumentedKernelCount];
+  std::vector<KernelCounter> volumes[kInstrumentedKernelCount];
+  unsigned sample_clock;
+
+  static ThreadCounters& Instance();
+
+  VECGEOM_INLINE
+  KernelCounter& volume(const InstrumentedKernel kernel, const int id) {
+    std::vector<KernelCounter> &counters = volumes[kernel];
+    if (id >= static_cast<int>(counters.size())) {
+      const KernelCounter zero = {0, 0, 0, 0};
+      counters.resize(id + 1, zero);
+    }
+    return counters[id];
+  }
+
+  void Reset();
+
+  ~ThreadCounters();
+
+private:
+
+  ThreadCounters();
+
+  ThreadCounters(ThreadCounters const&);
+  ThreadCounters& operator=(ThreadCounters const&);
+
+};
+
+/**
+ * Counts a kernel call for the lifetime of the object and times a sample of
+ * calls.
+ */
+class KernelProbe {
+
+private:
+
+  typedef std::chrono::steady_clock Clock;
+
+  KernelCounter *shape_counter_;
+  KernelCounter *volume_counter_;
+  Clock::time_point start_;
+  bool sampled_;
+
+public:
+
+  VECGEOM_INLINE
+  KernelProbe(const InstrumentedShape shape, const InstrumentedKernel kernel,
+              const int volume_id, const unsigned points) {
+    ThreadCounters &counters = ThreadCounters::Instance();
+    shape_counter_ = &counters.shapes[shape][kernel];
+    volume_counter_ = (volume_id >= 0) ? &counters.volume(kernel, volume_id)
+                                       : NULL;
+    ++shape_counter_->calls;
+    shape_counter_->points += points;
+    if (volume_counter_) {
+      ++volume_counter_->calls;
+      volume_counter_->points += points;
+    }
+    sampled_ = ++counters.sample_clock >= ThreadCounters::kSamplePeriod;
+    if (sampled_) {
+      counters.sample_clock = 0;
+      start_ = Clock::now();
+    }
+  }
+
+  VECGEOM_INLINE
+  ~KernelProbe() {
+    if (!sampled_) return;
+    const uint64_t elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          Clock::now() - start_
+        ).count();
+    ++shape_counter_->sampled_calls;
+    shape_counter_->sampled_ns += elapsed;
+    if (volume_counter_) {
+      ++volume_counter_->sampled_calls;
+      volume_counter_->sampled_ns += elapsed;
+    }
+  }
+
+};
+
+/**
+ * Aggregates counters of all threads, including threads which have exited.
+ * The counters of running threads are plain thread local variables, and the
+ * per volume counters are grown by their thread on demand, so aggregating
+ * requires all other threads to be quiescent, e.g. between parallel runs.
+ * Aggregating while other threads execute kernels is a data race.
+ */
+class Instrumentation {
+
+public:
+
+  static char const *const shape_labels[];
+  static char const *const kernel_labels[];
+
+  /**
+   * \return Sum of counters of all threads per shape and kernel. Must not be
+   *         called while other threads are executing kernels.
+   */
+  static KernelCounter ShapeTotal(const InstrumentedShape shape,
+                                  const InstrumentedKernel kernel);
+
+  /**
+   * \return Sum of counters of all threads for a placed volume. Must not be
+   *         called while other threads are executing kernels.
+   */
+  static KernelCounter VolumeTotal(const int volume_id,
+                                   const InstrumentedKernel kernel);
+
+  /**
+   * Prints calls and estimated time per shape and kernel, followed by the
+   * placed volumes with the highest estimated time, with their translation
+   * and rotation codes if the geometry has been closed. Must not be called
+   * while other threads are executing kernels.
+   */
+  static void Print(std::ostream &os, const int volume_count = 10);
+
+  /**
+   * Resets the counters of all threads. Must not be called while other
+   * threads are executing kernels.
+   */
+  static void Reset();
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_INSTRUMENTATION
+
+#endif // VECGEOM_BASE_INSTRUMENTATION_H_
\ No newline at end of file
@@ -0,0 +1,182 @@
+#ifndef VECGEOM_BASE_LANESTATISTICS_H_
+#define VECGEOM_BASE_LANESTATISTICS_H_
+
+#include "base/global.h"
+#include "base/instrumentation.h"
+
+/**
+ * SIMD lane utilization statistics, enabled by configuring with
+ * -DLANE_STATISTICS=ON. Kernels open a scope with VECGEOM_LANE_SCOPE, and the
+ * mask operations of the Vc backend report to the innermost open scope of the
+ * calling thread: MaskedAssign records how many lanes are written, and IsFull
+ * records whether the kernel can exit early. Scalar instantiations of kernels
+ * open no scope, so calls and early exit rates only count vector calls. All
+ * macros expand to nothing in regular builds.
+ */
+#if defined(VECGEOM_LANE_STATISTICS) && !defined(VECGEOM_NVCC)
+  #define VECGEOM_LANE_SCOPE(it, shape, kernel) \
+    vecgeom::LaneScope vecgeom_lane_scope(shape, kernel, it != vecgeom::kScalar)
+  #define VECGEOM_LANE_MASK(active, width) \
+    vecgeom::LaneStatistics::RecordMask(active, width)
+  #define VECGEOM_LANE_CHECK(full) \
+    vecgeom::LaneStatistics::RecordCheck(full)
+#else
+  #define VECGEOM_LANE_SCOPE(it, shape, kernel)
+  #define VECGEOM_LANE_MASK(active, width)
+  #define VECGEOM_LANE_CHECK(full)
+#endif
+
+#if defined(VECGEOM_LANE_STATISTICS) && !defined(VECGEOM_NVCC)
+
+#include <stdint.h>
+#include <iostream>
+
+namespace vecgeom {
+
+struct LaneCounter {
+
+  /**
+   * Widest supported mask, corresponding to single precision AVX-512.
+   */
+  static const int kMaxLanes = 16;
+
+  /**
+   * Checks after the last are attributed to the last bin.
+   */
+  static const int kMaxChecks = 4;
+
+  uint64_t calls;
+  uint64_t checks;
+  /** Checks finding a full mask, allowing the kernel to return. */
+  uint64_t exits;
+  uint64_t exits_at[kMaxChecks];
+  uint64_t masked_assigns;
+  uint64_t active_lanes;
+  uint64_t total_lanes;
+  /** Number of masked assignments by number of active lanes. */
+  uint64_t lanes_histogram[kMaxLanes + 1];
+
+};
+
+/**
+ * Counters of the calling thread, registered on first use and merged on
+ * request.
+ */
+class LaneThreadCounters {
+
+public:
+
+  LaneCounter kernels[kInstrumentedShapeCount][kInstrumentedKernelCount];
+  LaneCounter *current;
+  int checks;
+
+  static LaneThreadCounters& Instance();
+
+  void Reset();
+
+  ~LaneThreadCounters();
+
+private:
+
+  LaneThreadCounters();
+
+  LaneThreadCounters(LaneThreadCounters const&);
+  LaneThreadCounters& operator=(LaneThreadCounters const&);
+
+};
+
+/**
+ * Attributes mask operations to a kernel for the lifetime of the object.
+ * Scopes may nest, in which case the innermost scope is counted. Scopes
+ * constructed as closed do nothing.
+ */
+class LaneScope {
+
+private:
+
+  LaneCounter *previous_;
+  int previous_checks_;
+  bool open_;
+
+public:
+
+  VECGEOM_INLINE
+  LaneScope(const InstrumentedShape shape, const InstrumentedKernel kernel,
+            const bool open) : open_(open) {
+    if (!open_) return;
+    LaneThreadCounters &counters = LaneThreadCounters::Instance();
+    previous_ = counters.current;
+    previous_checks_ = counters.checks;
+    counters.current = &counters.kernels[shape][kernel];
+    counters.checks = 0;
+    ++counters.current->calls;
+  }
+
+  VECGEOM_INLINE
+  ~LaneScope() {
+    if (!open_) return;
+    LaneThreadCounters &counters = LaneThreadCounters::Instance();
+    counters.current = previous_;
+    counters.checks = previous_checks_;
+  }
+
+};
+
+class LaneStatistics {
+
+public:
+
+  VECGEOM_INLINE
+  static void RecordMask(const int active, const int width) {
+    LaneThreadCounters &counters = LaneThreadCounters::Instance();
+    LaneCounter *const counter = counters.current;
+    if (!counter) return;
+    ++counter->masked_assigns;
+    counter->active_lanes += active;
+    counter->total_lanes += width;
+    ++counter->lanes_histogram[
+      (active < LaneCounter::kMaxLanes) ? active : LaneCounter::kMaxLanes
+    ];
+  }
+
+  VECGEOM_INLINE
+  static void RecordCheck(const bool full) {
+    LaneThreadCounters &counters = LaneThreadCounters::Instance();
+    LaneCounter *const counter = counters.current;
+    if (!counter) return;
+    ++counter->checks;
+    if (full) {
+      ++counter->exits;
+      ++counter->exits_at[(counters.checks < LaneCounter::kMaxChecks)
+                          ? counters.checks : LaneCounter::kMaxChecks - 1];
+    }
+    ++counters.checks;
+  }
+
+  /**
+   * \return Sum of counters of all threads, including threads which have
+   *         exited.
+   */
+  static LaneCounter Total(const InstrumentedShape shape,
+                           const InstrumentedKernel kernel);
+
+  /**
+   * Prints per kernel the fraction of active lanes in masked assignments with
+   * their distribution, and the rate at which full masks allow early exits,
+   * broken down by the position of the check in the kernel.
+   */
+  static void Print(std::ostream &os);
+
+  /**
+   * Resets the counters of all threads. Must not be called while other
+   * threads are executing kernels.
+   */
+  static void Reset();
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_LANE_STATISTICS
+
+#endif // VECGEOM_BASE_LANESTATISTICS_H_
\ No newline at end of file
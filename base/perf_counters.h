@@ -0,0 +1,171 @@
+#ifndef VECGEOM_BASE_PERFCOUNTERS_H_
+#define VECGEOM_BASE_PERFCOUNTERS_H_
+
+#include <stdint.h>
+#include <iostream>
+#include "base/global.h"
+
+namespace vecgeom {
+
+enum PerfEvent {
+  kPerfCycles,
+  kPerfInstructions,
+  kPerfBranchMisses,
+  kPerfL1Misses,
+  kPerfLlcMisses,
+  kPerfEventCount
+};
+
+/**
+ * Set of hardware events counted together by the kernel, so that ratios
+ * between them are consistent. Uses perf_event_open directly and counts user
+ * space events of the calling thread only. Events that cannot be opened are
+ * marked unavailable and are not part of the group.
+ */
+class PerfCounterGroup {
+
+public:
+
+  static const int kMaxEvents = 4;
+
+private:
+
+  int leader_;
+  int count_;
+  PerfEvent events_[kMaxEvents];
+  int fds_[kMaxEvents];
+  uint64_t values_[kMaxEvents];
+  bool running_;
+
+public:
+
+  PerfCounterGroup(PerfEvent const *const events, const int count);
+
+  ~PerfCounterGroup();
+
+  /**
+   * \return Whether any event of the group could be opened.
+   */
+  bool available() const { return leader_ >= 0; }
+
+  bool available(const PerfEvent event) const;
+
+  void Start();
+
+  /**
+   * Adds the events counted since the last call to Start() to the totals,
+   * scaled up if the kernel had to multiplex the group with others.
+   */
+  void Stop();
+
+  void Reset();
+
+  /**
+   * \return Accumulated count, or -1 if the event is unavailable.
+   */
+  double value(const PerfEvent event) const;
+
+private:
+
+  PerfCounterGroup(PerfCounterGroup const&);
+  PerfCounterGroup& operator=(PerfCounterGroup const&);
+
+};
+
+/**
+ * Counts all events of PerfEvent in two groups: cycles, instructions and
+ * branch misses, and L1 data and last level cache misses. When hardware
+ * counters are not accessible, for example in virtual machines or due to
+ * kernel restrictions, all values are reported as unavailable and counting is
+ * a no-op.
+ */
+class PerfCounters {
+
+private:
+
+  PerfCounterGroup core_;
+  PerfCounterGroup cache_;
+
+public:
+
+  PerfCounters();
+
+  bool available() const { return core_.available() || cache_.available(); }
+
+  bool available(const PerfEvent event) const {
+    return core_.available(event) || cache_.available(event);
+  }
+
+  void Start() {
+    core_.Start();
+    cache_.Start();
+  }
+
+  void Stop() {
+    cache_.Stop();
+    core_.Stop();
+  }
+
+  void Reset() {
+    core_.Reset();
+    cache_.Reset();
+  }
+
+  /**
+   * \return Accumulated count, or -1 if the event is unavailable.
+   */
+  double value(const PerfEvent event) const;
+
+  /**
+   * \return Instructions per cycle, or -1 if unavailable.
+   */
+  double Ipc() const;
+
+  static char const* label(const PerfEvent event);
+
+};
+
+/**
+ * Counts events for the lifetime of the scope.
+ */
+class PerfCounterScope {
+
+private:
+
+  PerfCounters &counters_;
+
+public:
+
+  PerfCounterScope(PerfCounters &counters) : counters_(counters) {
+    counters_.Start();
+  }
+
+  ~PerfCounterScope() { counters_.Stop(); }
+
+};
+
+/**
+ * Snapshot of counter values normalized per call, as reported by benchmarks.
+ * Unavailable values are negative.
+ */
+struct PerfSample {
+  double per_call[kPerfEventCount];
+  double ipc;
+
+  static PerfSample Create(PerfCounters const &counters, const double calls);
+
+  /**
+   * Prints IPC and misses per call, or nothing if counters are unavailable.
+   */
+  friend std::ostream& operator<<(std::ostream &os, PerfSample const &sample);
+
+  /**
+   * Prints the sample as members of a JSON object, starting with a comma.
+   * Unavailable values are written as null.
+   */
+  void PrintJson(std::ostream &os) const;
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_BASE_PERFCOUNTERS_H_
\ No newline at end of file
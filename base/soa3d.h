@@ -2,6 +2,7 @@
 #define VECGEOM_BASE_SOA3D_H_
 
 #include "base/global.h"
+#include "base/vector3d.h"
 
 namespace vecgeom {
 
@@ -21,38 +22,52 @@ public:
       :  size_(size), allocated_(false), x_(x), y_(y), z_(z) {}
 
   VECGEOM_CUDA_HEADER_BOTH
-  SOA3D() {
-    SOA3D(NULL, NULL, NULL, 0);
-  }
+  SOA3D() : size_(0), allocated_(false), x_(NULL), y_(NULL), z_(NULL) {}
 
-  SOA3D(const unsigned size) : size_(size), allocated_(true) {
-    x_ = static_cast<Type*>(_mm_malloc(sizeof(Type)*size_, kAlignmentBoundary));
-    y_ = static_cast<Type*>(_mm_malloc(sizeof(Type)*size_, kAlignmentBoundary));
-    z_ = static_cast<Type*>(_mm_malloc(sizeof(Type)*size_, kAlignmentBoundary));
+  SOA3D(const unsigned size) : size_(0), allocated_(false) {
+    Allocate(size);
   }
 
   ~SOA3D() {
     Deallocate();
   }
 
+  /**
+   * Allocates aligned memory for the given number of elements, releasing any
+   * memory previously owned by this object. Content is not initialized.
+   */
+  void Allocate(const unsigned size) {
+    Deallocate();
+    size_ = size;
+    allocated_ = true;
+    x_ = static_cast<Type*>(_mm_malloc(sizeof(Type)*size_, kAlignmentBoundary));
+    y_ = static_cast<Type*>(_mm_malloc(sizeof(Type)*size_, kAlignmentBoundary));
+    z_ = static_cast<Type*>(_mm_malloc(sizeof(Type)*size_, kAlignmentBoundary));
+  }
+
   void Deallocate() {
     if (allocated_) {
       _mm_free(x_);
       _mm_free(y_);
       _mm_free(z_);
     }
+    allocated_ = false;
+    x_ = NULL;
+    y_ = NULL;
+    z_ = NULL;
+    size_ = 0;
   }
 
-  VECGEOM_CUDA_HEADER_BOTH
-  SOA3D(SOA3D const &other) {
-    SOA3D(other.size);
-    const unsigned count = other.size;
-    for (int i = 0; i < count; ++i) {
-      x_[i] = other.z_[i];
+  /**
+   * Performs a deep copy into newly allocated memory.
+   */
+  SOA3D(SOA3D const &other) : size_(0), allocated_(false) {
+    Allocate(other.size_);
+    for (unsigned i = 0; i < size_; ++i) {
+      x_[i] = other.x_[i];
       y_[i] = other.y_[i];
       z_[i] = other.z_[i];
     }
-    size = count;
   }
 
   VECGEOM_CUDA_HEADER_BOTH
@@ -71,6 +86,30 @@ public:
   // Element access methods.
   // Can be used to manipulate content if necessary.
 
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  Type* x() { return x_; }
+
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  Type const* x() const { return x_; }
+
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  Type* y() { return y_; }
+
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  Type const* y() const { return y_; }
+
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  Type* z() { return z_; }
+
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  Type const* z() const { return z_; }
+
   VECGEOM_CUDA_HEADER_BOTH
   VECGEOM_INLINE
   Type& x(const int index) { return x_[index]; }
@@ -120,7 +159,7 @@ public:
    */
   VECGEOM_CUDA_HEADER_HOST
   SOA3D<Type> CopyToGpu() const {
-    const int count = size;
+    const int count = size_;
     const int mem_size = count*sizeof(Type);
     Type *x, *y, *z;
     cudaMalloc(static_cast<void**>(&x), mem_size);
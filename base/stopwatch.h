@@ -0,0 +1,49 @@
+#ifndef VECGEOM_BASE_STOPWATCH_H_
+#define VECGEOM_BASE_STOPWATCH_H_
+
+#include <chrono>
+#include "base/global.h"
+
+namespace vecgeom {
+
+/**
+ * Measures elapsed wall clock time with the highest resolution available.
+ * Host only.
+ */
+class Stopwatch {
+
+private:
+
+  typedef std::chrono::high_resolution_clock Clock;
+
+  Clock::time_point start_, stop_;
+
+public:
+
+  Stopwatch() : start_(Clock::now()), stop_(start_) {}
+
+  VECGEOM_INLINE
+  void Start() { start_ = Clock::now(); }
+
+  /**
+   * \return Elapsed time in seconds since the last call to Start().
+   */
+  VECGEOM_INLINE
+  double Stop() {
+    stop_ = Clock::now();
+    return Elapsed();
+  }
+
+  /**
+   * \return Time in seconds between the last calls to Start() and Stop().
+   */
+  VECGEOM_INLINE
+  double Elapsed() const {
+    return std::chrono::duration<double>(stop_ - start_).count();
+  }
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_BASE_STOPWATCH_H_
\ No newline at end of file
@@ -46,6 +46,8 @@ public:
   VECGEOM_CUDA_HEADER_BOTH
   TransformationMatrix(TransformationMatrix const &other);
 
+  virtual ~TransformationMatrix() {}
+
   // Accessors
 
   virtual int memory_size() const { return sizeof(*this); }
@@ -114,6 +116,15 @@ public:
                    const Precision rot6, const Precision rot7,
                    const Precision rot8);
 
+  /**
+   * Composes this matrix with a matrix given in the local frame of this one,
+   * so the result transforms points of the master frame of this matrix
+   * directly into the local frame of the other. Rotation and translation are
+   * only multiplied where the codes of either matrix require it.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  void MultiplyFromRight(TransformationMatrix const &rhs);
+
   // Generation of template parameter codes
 
   VECGEOM_CUDA_HEADER_BOTH
@@ -217,7 +228,7 @@ void TransformationMatrix::DoRotation(Vector3D<InputType> const &master,
   if (code == 0x16A) {
     (*local)[0] = master[1]*rot[3] + master[2]*rot[6];
     (*local)[1] = master[0]*rot[1];
-    (*local)[2] = master[2]*rot[5] + master[2]*rot[8];
+    (*local)[2] = master[1]*rot[5] + master[2]*rot[8];
     return;
   }
   if (code == 0x155) {
@@ -353,8 +364,9 @@ void TransformationMatrix::Transform(Vector3D<InputType> const &master,
   }
 
   // General case
-  DoTranslation(master, local);
-  DoRotation<rot_code>(master, local);
+  Vector3D<InputType> translated;
+  DoTranslation(master, &translated);
+  DoRotation<rot_code>(translated, local);
 
 }
 
@@ -9,7 +9,10 @@ typedef float Precision;
 typedef double Precision;
 #endif
 
-enum ImplType { kVc, kCuda, kScalar, kCilk };
+enum ImplType {
+  kVc, kCuda, kScalar, kSimd, kSimdSse4, kSimdAvx2, kSimdAvx512, kAvx512,
+  kSimdFloat
+};
 
 template <ImplType it>
 struct Impl;
@@ -41,6 +44,10 @@ class TransformationMatrix;
 
 class GeoManager;
 
+class NavigationState;
+
+class SimpleNavigator;
+
 #ifdef VECGEOM_CUDA
 class CudaManager;
 #endif
@@ -35,6 +35,12 @@ public:
     return vec[index];
   }
 
+  void reserve(const int size) {
+    vec.reserve(size);
+    begin_ptr = &vec[0];
+    end_ptr = &vec[size_];
+  }
+
   void push_back(Type const &item) {
     vec.push_back(item);
     size_ = vec.size();
@@ -42,6 +48,16 @@ public:
     end_ptr = &vec[size()];
   }
 
+  /**
+   * Removes all elements, keeping the allocated memory.
+   */
+  void clear() {
+    vec.clear();
+    size_ = 0;
+    begin_ptr = &vec[0];
+    end_ptr = &vec[0];
+  }
+
 private:
 
   class VectorIterator : public Iterator<Type> {
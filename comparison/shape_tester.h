@@ -4,63 +4,139 @@
 #include <iostream>
 #include <vector>
 #include "base/global.h"
+#include "base/perf_counters.h"
 #include "base/soa3d.h"
+#ifdef VECGEOM_COMPARISON
 #include "comparison/volume_converter.h"
+#endif
 
 namespace vecgeom {
 
-enum BenchmarkType {kSpecialized, kPlaced, kUSolids, kRoot};
+/**
+ * Code paths that can be benchmarked. Specialized and Placed call the scalar
+ * virtual methods of specialized and unspecialized placed volumes for every
+ * point. Vectorized passes the full basket to the basket methods, which use
+ * the vector backend if one was compiled in. PlacedVectorized does the same
+ * for unspecialized volumes, whose kernels are subject to runtime instruction
+ * set dispatch. USolids and ROOT are only available when building with
+ * comparison enabled.
+ */
+enum BenchmarkType {kSpecialized, kPlaced, kVectorized, kPlacedVectorized,
+                    kUSolids, kRoot};
+
+/**
+ * Methods that can be benchmarked. DistanceToOut is evaluated from points
+ * sampled inside each volume, given in its local frame.
+ */
+enum BenchmarkMethod {kInside, kDistanceToIn, kDistanceToOut};
 
 struct ShapeBenchmark {
 public:
-  const double elapsed;
-  const BenchmarkType type;
+  double elapsed;
+  BenchmarkType type;
+  BenchmarkMethod method;
+  unsigned repetitions;
+  unsigned volumes;
+  unsigned points;
+  double bias;
+  /** Results deviating from the reference path, or zero if not checked. */
+  unsigned mismatches;
+  /** Hardware counters per call, negative where unavailable. */
+  PerfSample counters;
   static char const *const benchmark_labels[];
-  const unsigned repetitions;
-  const unsigned volumes;
-  const unsigned points;
-  const double bias;
+  static char const *const method_labels[];
+
+  double calls() const {
+    return static_cast<double>(repetitions) * volumes * points;
+  }
+
+  /**
+   * \return Number of calls per second.
+   */
+  double throughput() const { return calls() / elapsed; }
+
+  /**
+   * \return Average time spent per call in nanoseconds.
+   */
+  double time_per_call() const { return 1e9 * elapsed / calls(); }
+
   friend std::ostream& operator<<(std::ostream &os,
-                                        ShapeBenchmark const &benchmark) {
-    os << benchmark.elapsed << "s | " << benchmark.volumes << " "
-       << ShapeBenchmark::benchmark_labels[benchmark.type] << " volumes, "
-       << benchmark.points << " points, " << benchmark.bias
-       << " bias, repeated " << benchmark.repetitions << " times.";
+                                  ShapeBenchmark const &benchmark) {
+    os << ShapeBenchmark::benchmark_labels[benchmark.type] << " "
+       << ShapeBenchmark::method_labels[benchmark.method] << ": "
+       << benchmark.elapsed << "s | " << benchmark.throughput()
+       << " calls/s, " << benchmark.time_per_call() << " ns/call | "
+       << benchmark.volumes << " volumes, " << benchmark.points
+       << " points, " << benchmark.bias << " bias, repeated "
+       << benchmark.repetitions << " times, " << benchmark.mismatches
+       << " mismatches.";
+    if (benchmark.counters.ipc >= 0) os << " | " << benchmark.counters;
     return os;
   }
 };
 
+/**
+ * Benchmarks the daughters of a world volume along all available code paths.
+ * Points are sampled uniformly inside the world and outside all daughters.
+ * Directions point towards a random daughter with a probability given by the
+ * bias, and are isotropic otherwise. The pools hold pool_multiplier times the
+ * number of points per basket, and each repetition picks a basket from the
+ * pool to reduce cache effects. Points are given in the frame of the world, so
+ * only the first level of daughters is benchmarked.
+ */
 class ShapeTester {
 
 private:
 
   LogicalVolume const *world_ = NULL;
-  std::vector<VolumeConverter> volumes_;
+  std::vector<VPlacedVolume const*> volumes_;
+  std::vector<VPlacedVolume const*> unspecialized_;
+  #ifdef VECGEOM_COMPARISON
+  std::vector<VolumeConverter*> converted_;
+  #endif
   unsigned n_vols_ = 0;
   unsigned n_points_ = 1<<10;
   unsigned repetitions_ = 1e3;
   double bias_ = 0.8;
   unsigned pool_multiplier_ = 1;
+  Precision tolerance_ = 1e-9;
   std::vector<ShapeBenchmark> results_;
   unsigned verbose_ = 0;
   SOA3D<Precision> point_pool_, dir_pool_;
-  double *steps_ = NULL;
+  // Local points inside each volume, laid out per volume like the output
+  SOA3D<Precision> inside_pool_;
+  Precision *steps_ = NULL;
+  std::vector<unsigned> offsets_;
+  PerfCounters counters_;
 
 public:
 
-  void BenchmarkAll();
-  void BenchmarkPlaced();
+  /**
+   * Runs every available code path for all methods and compares the results
+   * of each path to the specialized path.
+   * \return Total number of mismatches detected.
+   */
+  unsigned BenchmarkAll();
   void BenchmarkSpecialized();
+  void BenchmarkPlaced();
+  void BenchmarkVectorized();
+  void BenchmarkPlacedVectorized();
+  #ifdef VECGEOM_COMPARISON
   void BenchmarkUSolids();
-  void BenchmarkROOT();
+  void BenchmarkRoot();
+  #endif
 
+  /**
+   * Removes and returns the last result. Reports an error and returns an
+   * empty result if there are no results.
+   */
   ShapeBenchmark PopResult();
   std::vector<ShapeBenchmark> PopResults();
-  
+
   ShapeTester() {}
 
   ShapeTester(LogicalVolume const *const world) : world_(world) {}
-  
+
   ~ShapeTester();
 
   // Accessors
@@ -75,6 +151,8 @@ public:
 
   unsigned pool_multiplier() const { return pool_multiplier_; }
 
+  Precision tolerance() const { return tolerance_; }
+
   unsigned verbose() const { return verbose_; }
 
   std::vector<ShapeBenchmark> results() const { return results_; }
@@ -93,32 +171,78 @@ public:
 
   void set_pool_multiplier(const unsigned pool_multiplier_);
 
+  /**
+   * \param tolerance Relative tolerance used when comparing distances between
+   *                  code paths.
+   */
+  void set_tolerance(const Precision tolerance) { tolerance_ = tolerance; }
+
   void set_verbose(const unsigned verbose) { verbose_ = verbose; }
 
 private:
-    
-  void ConvertVolumes(LogicalVolume const *vol);
+
+  ShapeTester(ShapeTester const&);
+  ShapeTester& operator=(ShapeTester const&);
+
+  void ConvertVolumes();
+
+  void ClearVolumes();
+
+  bool PrepareBenchmark();
+
+  void FillBiasedDirections();
+
+  /**
+   * Samples points inside each volume in its local frame by rejection from
+   * its bounding box.
+   */
+  void FillInsidePoints();
 
   ShapeBenchmark GenerateBenchmark(const double elapsed,
-                                   const BenchmarkType type) const;
+                                   const BenchmarkType type,
+                                   const BenchmarkMethod method) const;
+
+  void RunBenchmark(const BenchmarkType type, const BenchmarkMethod method,
+                    bool *const inside, Precision *const distances);
+
+  double RunScalar(std::vector<VPlacedVolume const*> const &volumes,
+                   const BenchmarkMethod method, bool *const inside,
+                   Precision *const distances) const;
+
+  double RunVectorized(std::vector<VPlacedVolume const*> const &volumes,
+                       const BenchmarkMethod method, bool *const inside,
+                       Precision *const distances);
+
+  #ifdef VECGEOM_COMPARISON
+  double RunUSolids(const BenchmarkMethod method, bool *const inside,
+                    Precision *const distances) const;
+
+  double RunRoot(const BenchmarkMethod method, bool *const inside,
+                 Precision *const distances) const;
+  #endif
 
-  ShapeBenchmark RunPlaced(double *distances) const;
+  unsigned CompareInside(bool const *const reference,
+                         bool const *const inside) const;
 
-  ShapeBenchmark RunUnplaced(double *distances) const;
+  unsigned CompareDistances(Precision const *const reference,
+                            Precision const *const distances) const;
 
-  ShapeBenchmark RunUSolids(double *distances) const;
+  /**
+   * Output is stored per volume for the entire pool, so results of different
+   * code paths can be compared element by element.
+   */
+  unsigned output_size() const { return n_vols_*n_points_*pool_multiplier_; }
 
-  ShapeBenchmark RunROOT(double *distances) const;
+  Precision* AllocateDistances() const;
 
-  void PrepareBenchmark();
+  bool* AllocateInside() const;
 
-  double* AllocateDistance() const {
-    return (double*) _mm_malloc(n_points_*pool_multiplier_*sizeof(double),
-                                kAlignmentBoundary);
+  static void FreeDistances(Precision *distances) {
+    _mm_free(distances);
   }
 
-  static void FreeDistance(double *distance) {
-    _mm_free(distance);
+  static void FreeInside(bool *inside) {
+    delete[] inside;
   }
 
 };
@@ -0,0 +1,135 @@
+#ifndef VECGEOM_MANAGEMENT_GDMLIMPORTER_H_
+#define VECGEOM_MANAGEMENT_GDMLIMPORTER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "base/global.h"
+#include "base/vector3d.h"
+
+namespace vecgeom {
+
+/**
+ * Imports geometry from the subset of GDML consisting of constants, positions
+ * and rotations in the define section, box solids, volumes with physvols in
+ * the structure section, and the world reference in the setup section.
+ *
+ * The file is read with a streaming XML parser that only stores the
+ * parameters of each element. Solids and transformation matrices with equal
+ * parameters are deduplicated, and the resulting unique objects are
+ * constructed in parallel. Finally daughters are placed in bulk for each
+ * volume. Lengths are converted to millimeters and angles to radians.
+ *
+ * The importer owns all created objects, so it must outlive the geometry.
+ */
+class GdmlImporter {
+
+public:
+
+  struct SolidRecord {
+    std::string name;
+    int type;
+    Precision parameters[3];
+  };
+
+  struct PhysvolRecord {
+    int volume;
+    Vector3D<Precision> position;
+    Vector3D<Precision> rotation;
+  };
+
+  struct VolumeRecord {
+    std::string name;
+    int solid;
+    std::vector<PhysvolRecord> daughters;
+  };
+
+private:
+
+  int threads_;
+  int verbose_;
+
+  // Parsed content
+  std::map<std::string, Precision> constants_;
+  std::map<std::string, Vector3D<Precision> > positions_;
+  std::map<std::string, Vector3D<Precision> > rotations_;
+  std::map<std::string, int> solid_names_;
+  std::map<std::string, int> volume_names_;
+  std::vector<SolidRecord> solids_;
+  std::vector<VolumeRecord> volumes_;
+  std::string world_name_;
+
+  // Constructed geometry
+  std::vector<VUnplacedVolume*> unplaced_;
+  std::vector<TransformationMatrix*> matrices_;
+  std::vector<LogicalVolume*> logical_;
+  LogicalVolume const *world_;
+
+public:
+
+  GdmlImporter();
+
+  ~GdmlImporter();
+
+  /**
+   * Parses the file and constructs the contained geometry.
+   * \return Pointer to the world volume, or NULL if the file could not be
+   *         imported.
+   */
+  LogicalVolume const* Import(char const *const file_name);
+
+  LogicalVolume const* world() const { return world_; }
+
+  /**
+   * \return Number of unique unplaced volumes after deduplication.
+   */
+  int unplaced_count() const { return unplaced_.size(); }
+
+  /**
+   * \return Number of unique transformation matrices after deduplication.
+   */
+  int matrix_count() const { return matrices_.size(); }
+
+  int logical_count() const { return logical_.size(); }
+
+  int threads() const { return threads_; }
+
+  /**
+   * \param threads Number of threads used for construction. Values below one
+   *                use all available hardware threads.
+   */
+  void set_threads(const int threads);
+
+  void set_verbose(const int verbose) { verbose_ = verbose; }
+
+  // Called by the XML parser
+
+  bool StartElement(std::string const &name,
+                    std::map<std::string, std::string> const &attributes);
+
+  bool EndElement(std::string const &name);
+
+private:
+
+  GdmlImporter(GdmlImporter const&);
+  GdmlImporter& operator=(GdmlImporter const&);
+
+  void Clear();
+
+  bool Construct();
+
+  bool Evaluate(std::string const &expression, Precision *const value) const;
+
+  bool ReadVector(std::map<std::string, std::string> const &attributes,
+                  const bool angle, Vector3D<Precision> *const vector) const;
+
+  // Parser state
+  std::string section_;
+  int current_volume_;
+  PhysvolRecord *current_physvol_;
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_MANAGEMENT_GDMLIMPORTER_H_
\ No newline at end of file
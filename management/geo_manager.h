@@ -2,21 +2,43 @@
 #define VECGEOM_MANAGEMENT_GEOMANAGER_H_
 
 #include <iostream>
-#include <list>
+#include <map>
+#include <set>
+#include <vector>
 #include "base/types.h"
 
 namespace vecgeom {
 
 /**
- * Singleton class that maintains a list of all instatiated placed volumes.
+ * Placements from which a daughter created by flattening assemblies was
+ * derived, identified by their ids.
+ */
+struct FlattenedOrigin {
+  /** Outermost assembly placement that was replaced in the mother. */
+  int assembly;
+  /** Daughter of the innermost assembly that was copied into the mother. */
+  int original;
+};
+
+/**
+ * Singleton class that maintains a table of all instatiated placed volumes.
  * Will assign each placed volume a unique id that identifies them globally.
+ *
+ * Registration and deregistration are safe to perform from multiple threads
+ * without locking. Ids are assigned atomically, while the volumes themselves
+ * are kept in per-thread staging buffers that are merged into the global
+ * table by CloseGeometry(). The same buffers hold daughters placed with
+ * LogicalVolume::PlaceDaughterConcurrently. Only the first registration of
+ * each thread takes a lock, to create its buffer.
  */
 class GeoManager {
 
 protected:
 
-  int counter;
-  std::list<VPlacedVolume const*> volumes_;
+  std::vector<VPlacedVolume const*> volumes_;
+  bool flatten_assemblies_;
+  int max_flattened_daughters_;
+  std::map<int, FlattenedOrigin> origins_;
 
 public:
 
@@ -25,33 +47,91 @@ public:
     return instance;
   }
 
-  std::list<VPlacedVolume const*> const& volumes() {
-    return volumes_;
+  /**
+   * Table of placed volumes indexed by their id. Entries of deleted volumes
+   * are NULL. Volumes staged by any thread are merged into the table first,
+   * along with concurrently placed daughters, as done by CloseGeometry(). Like
+   * closing the geometry, this must not be called while other threads are
+   * constructing geometry.
+   */
+  std::vector<VPlacedVolume const*> const& volumes();
+
+  /**
+   * \return Number of ids assigned so far, including volumes which are still
+   *         staged.
+   */
+  int volume_count() const;
+
+  bool flatten_assemblies() const { return flatten_assemblies_; }
+
+  int max_flattened_daughters() const { return max_flattened_daughters_; }
+
+  /**
+   * Enables replacing placements of assemblies by the daughters of the
+   * assembly when closing the geometry, which removes one level of
+   * navigation per assembly. Disabled by default.
+   * \param max_daughters Placements of assemblies are only replaced if they
+   *                     expand into at most this many daughters, so the
+   *                     daughter loops of the mothers stay short.
+   */
+  void set_flatten_assemblies(const bool flatten,
+                              const int max_daughters = 8) {
+    flatten_assemblies_ = flatten;
+    max_flattened_daughters_ = max_daughters;
   }
 
+  /**
+   * \return Placements a daughter was derived from when flattening
+   *         assemblies, or NULL if it was placed directly. Origins of deleted
+   *         daughters are dropped by the next call to CloseGeometry().
+   */
+  FlattenedOrigin const* Origin(VPlacedVolume const *const volume) const;
+
+  /**
+   * Merges the staging buffers of all threads, adding registered volumes to
+   * the volume table and concurrently placed daughters to their mothers.
+   * Daughters are appended in the order of their ids. If enabled, then
+   * flattens the assemblies placed in all placed logical volumes. Drops the
+   * flattening origins of deleted volumes. When built with runtime
+   * instruction set dispatch, also binds the basket kernels on the first
+   * call. Also rebuilds the face neighbors of all placed logical volumes.
+   * Must not be called while other threads are constructing geometry.
+   */
+  void CloseGeometry();
+
 private:
 
-  GeoManager() {
-    counter = 0;
-  }
+  GeoManager() : flatten_assemblies_(false), max_flattened_daughters_(8) {}
 
   GeoManager(GeoManager const&);
   GeoManager& operator=(GeoManager const&);
 
-  int RegisterVolume(VPlacedVolume const *const volume) {
-    volumes_.push_back(volume);
-    return counter++;
-  }
+  int RegisterVolume(VPlacedVolume const *const volume);
 
   /**
    * Deregistering will not change the counter, as gaps in the id don't have any
-   * practical consequence.
+   * practical consequence. Volumes that are still staged are recorded as
+   * deleted in the buffer of the calling thread and skipped when merging.
+   * Volumes already in the table must not be deleted while the geometry is
+   * being closed.
    */
-  void DeregisterVolume(VPlacedVolume const *const volume) {
-    volumes_.remove(volume);
-  }
+  void DeregisterVolume(VPlacedVolume const *const volume);
+
+  void StagePlacement(LogicalVolume *const mother,
+                      VPlacedVolume const *const daughter);
+
+  void MergeStagingBuffers();
+
+  /**
+   * \return Logical volumes of all volumes in the volume table.
+   */
+  std::set<LogicalVolume const*> PlacedLogicalVolumes() const;
+
+  void RecordOrigin(VPlacedVolume const *const volume, const int assembly,
+                    const int original);
 
   friend class VPlacedVolume;
+  friend class LogicalVolume;
 
 };
 
@@ -0,0 +1,136 @@
+#ifndef VECGEOM_MANAGEMENT_GEOMETRYGENERATOR_H_
+#define VECGEOM_MANAGEMENT_GEOMETRYGENERATOR_H_
+
+#include <map>
+#include <vector>
+#include "base/global.h"
+#include "base/vector3d.h"
+
+namespace vecgeom {
+
+/**
+ * Classes of shapes in a generated geometry. Only boxes are available, so the
+ * classes vary the aspect ratio from cubes to flat slabs and long bars.
+ */
+enum GeneratedShape {
+  kGeneratedCube,
+  kGeneratedSlab,
+  kGeneratedBar,
+  kGeneratedShapeCount
+};
+
+/**
+ * Generates synthetic hierarchical geometries of scalable complexity for
+ * benchmarking. Every volume above the deepest level contains the same number
+ * of daughters, arranged on a regular grid so they never overlap. The class
+ * of each daughter is drawn from the shape mix, and a fraction of daughters is
+ * placed with a random rotation. Logical volumes are shared between all
+ * placements with equal parameters, so the number of objects created grows
+ * slowly with depth while the number of reachable volumes grows
+ * exponentially.
+ *
+ * The generator owns all created objects, so it must outlive the geometry.
+ */
+class GeometryGenerator {
+
+private:
+
+  int depth_;
+  int daughters_;
+  Precision shape_mix_[kGeneratedShapeCount];
+  Precision rotation_fraction_;
+  Precision world_size_;
+  unsigned seed_;
+  unsigned random_state_;
+
+  std::vector<VUnplacedVolume*> unplaced_;
+  std::vector<TransformationMatrix*> matrices_;
+  std::vector<LogicalVolume*> logical_;
+  std::map<std::vector<Precision>, LogicalVolume*> logical_cache_;
+  LogicalVolume *world_logical_;
+  VPlacedVolume *world_;
+
+public:
+
+  GeometryGenerator();
+
+  ~GeometryGenerator();
+
+  /**
+   * Discards any previously generated geometry and generates a new one.
+   * \return Placed world volume, or NULL if the parameters are invalid.
+   */
+  VPlacedVolume const* Generate();
+
+  VPlacedVolume const* world() const { return world_; }
+
+  int depth() const { return depth_; }
+
+  int daughters() const { return daughters_; }
+
+  Precision shape_mix(const GeneratedShape shape) const {
+    return shape_mix_[shape];
+  }
+
+  Precision rotation_fraction() const { return rotation_fraction_; }
+
+  Precision world_size() const { return world_size_; }
+
+  int logical_count() const { return logical_.size(); }
+
+  int matrix_count() const { return matrices_.size(); }
+
+  /**
+   * \return Number of volumes reachable by navigation, including the world.
+   */
+  long TouchableCount() const;
+
+  /**
+   * \param depth Number of levels below the world volume.
+   */
+  void set_depth(const int depth) { depth_ = depth; }
+
+  void set_daughters(const int daughters) { daughters_ = daughters; }
+
+  /**
+   * Sets the relative weight of a shape class. Weights need not be
+   * normalized.
+   */
+  void set_shape_mix(const GeneratedShape shape, const Precision weight) {
+    shape_mix_[shape] = weight;
+  }
+
+  void set_rotation_fraction(const Precision rotation_fraction) {
+    rotation_fraction_ = rotation_fraction;
+  }
+
+  /**
+   * \param world_size Half length of the cubic world volume.
+   */
+  void set_world_size(const Precision world_size) { world_size_ = world_size; }
+
+  void set_seed(const unsigned seed) { seed_ = seed; }
+
+private:
+
+  GeometryGenerator(GeometryGenerator const&);
+  GeometryGenerator& operator=(GeometryGenerator const&);
+
+  void Clear();
+
+  /**
+   * Returns a logical volume with the given dimensions containing generated
+   * daughters down to the deepest level, reusing existing volumes.
+   */
+  LogicalVolume* GenerateVolume(Vector3D<Precision> const &dimensions,
+                                const int level);
+
+  Precision RandomUniform();
+
+  GeneratedShape RandomShape();
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_MANAGEMENT_GEOMETRYGENERATOR_H_
\ No newline at end of file
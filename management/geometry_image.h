@@ -0,0 +1,185 @@
+#ifndef VECGEOM_MANAGEMENT_GEOMETRYIMAGE_H_
+#define VECGEOM_MANAGEMENT_GEOMETRYIMAGE_H_
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include "base/global.h"
+
+namespace vecgeom {
+
+class DaughterBounds;
+class FaceNeighbors;
+
+/**
+ * Offset and layout of one homogeneous table of objects in a geometry image.
+ * Each entry occupies stride bytes, which is large enough to hold both the
+ * stored record and the object constructed from it.
+ */
+struct ImageSection {
+  uint64_t offset;
+  uint64_t count;
+  uint64_t stride;
+};
+
+/**
+ * Fixed size header at the start of every geometry image. The type sizes are
+ * stored to reject images written by an incompatible build, as objects are
+ * constructed in place in the image memory.
+ */
+struct ImageHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t precision_size;
+  uint32_t pointer_size;
+  uint32_t logical_size;
+  uint32_t matrix_size;
+  uint64_t size;
+  uint64_t world;
+  ImageSection unplaced;
+  ImageSection matrices;
+  ImageSection logical;
+  ImageSection placed;
+  ImageSection daughters;
+  ImageSection replicas;
+};
+
+enum ImageVolumeType { kImageBox = 1 };
+
+/**
+ * Header of a shared memory segment holding a relocated geometry image. The
+ * image itself starts at the first page boundary after this header.
+ */
+struct SharedImageHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t address;
+  uint64_t image_offset;
+  uint64_t image_size;
+};
+
+/**
+ * Versioned, position independent binary representation of a closed geometry.
+ * All references between objects are stored as byte offsets from the start of
+ * the image, so an image file can be mapped to any address. Loading consists
+ * of a single pass constructing each object in place from its record, which
+ * mostly amounts to setting up virtual table pointers and resolving offsets.
+ *
+ * Objects loaded from an image are owned by the image and are never deleted
+ * individually. The mapping is released when the image is destructed.
+ *
+ * Daughter bounds and face neighbors only depend on the stored geometry, so
+ * they are not stored but built on the heap of each process that loads or
+ * attaches to an image, and are owned by the image as well.
+ */
+class GeometryImage {
+
+public:
+
+  static const uint32_t kMagic = 0x49474556; // "VEGI"
+  static const uint32_t kVersion = 4;
+
+private:
+
+  void *base_;
+  size_t size_;
+  LogicalVolume const *world_;
+  std::vector<DaughterBounds*> bounds_;
+  std::vector<FaceNeighbors*> neighbors_;
+
+public:
+
+  GeometryImage() : base_(NULL), size_(0), world_(NULL) {}
+
+  ~GeometryImage();
+
+  /**
+   * Serializes the geometry hierarchy below the given volume to a file.
+   * \return False if the geometry contains unsupported volumes or
+   *         parametrised placements, or if the file could not be written.
+   */
+  static bool Write(LogicalVolume const *const world,
+                    char const *const file_name);
+
+  /**
+   * Maps an image file to memory and constructs the contained geometry.
+   * \return Pointer to the world volume, or NULL if the image was rejected.
+   */
+  LogicalVolume const* Load(char const *const file_name);
+
+  /**
+   * Loads an image file into a new named shared memory segment and constructs
+   * the geometry there, after which the segment is made read-only. Other
+   * processes can then attach to the geometry with AttachShared() without
+   * holding their own copy.
+   * \return Pointer to the world volume, or NULL on failure.
+   */
+  LogicalVolume const* CreateShared(char const *const file_name,
+                                    char const *const segment_name);
+
+  /**
+   * Maps a geometry placed in shared memory by CreateShared(). Objects in the
+   * segment point to each other by absolute address, so the segment must be
+   * mapped at the address used by the creating process, which is verified.
+   * Virtual table pointers differ between processes of position independent
+   * executables, so they are fixed up in a private copy-on-write mapping,
+   * which is then made read-only. The attaching process must use a build
+   * with the same layout of the stored types.
+   * \return Pointer to the world volume, or NULL if the segment could not be
+   *         attached.
+   */
+  LogicalVolume const* AttachShared(char const *const segment_name);
+
+  /**
+   * Removes the name of a shared segment. Processes that are attached keep
+   * their mapping until they release it.
+   */
+  static bool RemoveShared(char const *const segment_name);
+
+  /**
+   * Constructs the geometry contained in an image which is already present in
+   * writable memory. The memory must stay valid for the lifetime of the
+   * geometry and is not released by this class. No daughter bounds or face
+   * neighbors are built, so the navigator skips both.
+   * \return Pointer to the world volume, or NULL if the image was rejected.
+   */
+  static LogicalVolume const* Relocate(void *const base, const size_t size);
+
+  /**
+   * Checks the header and every record of an image before anything is
+   * constructed in it.
+   * \return False if the image is not compatible, or if any section or stored
+   *         offset lies outside the image or does not refer to an entry of
+   *         the expected kind.
+   */
+  static bool Validate(ImageHeader const *const header, const size_t size);
+
+  LogicalVolume const* world() const { return world_; }
+
+  size_t size() const { return size_; }
+
+private:
+
+  GeometryImage(GeometryImage const&);
+  GeometryImage& operator=(GeometryImage const&);
+
+  void Unmap();
+
+  /**
+   * Replaces the virtual table pointers of all polymorphic objects of a
+   * relocated image by those of this process.
+   * \return Pointer to the world volume.
+   */
+  static LogicalVolume const* FixVirtualTables(char *const image);
+
+  /**
+   * Builds the daughter bounds and face neighbors of every logical volume of
+   * a relocated image.
+   */
+  void BuildAcceleration(char *const image);
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_MANAGEMENT_GEOMETRYIMAGE_H_
\ No newline at end of file
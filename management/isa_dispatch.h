@@ -0,0 +1,148 @@
+#ifndef VECGEOM_MANAGEMENT_ISADISPATCH_H_
+#define VECGEOM_MANAGEMENT_ISADISPATCH_H_
+
+#include "base/global.h"
+
+#ifdef VECGEOM_ISA_DISPATCH
+
+#include <iostream>
+
+namespace vecgeom {
+
+/**
+ * Instruction sets for which basket kernels can be compiled in addition to
+ * the baseline, which is the vector backend selected when configuring.
+ */
+enum InstructionSet {
+  kInstructionSetBaseline,
+  kInstructionSetSse4,
+  kInstructionSetAvx2,
+  kInstructionSetAvx512,
+  kInstructionSetCount
+};
+
+/**
+ * Basket kernels of the box for general transformations. NULL entries are
+ * not compiled for an instruction set.
+ */
+struct BoxBasketKernels {
+
+  typedef void (*InsideKernel)(Vector3D<Precision> const &dimensions,
+                               TransformationMatrix const &matrix,
+                               SOA3D<Precision> const &points,
+                               bool *const output);
+
+  typedef void (*DistanceToInKernel)(Vector3D<Precision> const &dimensions,
+                                     TransformationMatrix const &matrix,
+                                     SOA3D<Precision> const &positions,
+                                     SOA3D<Precision> const &directions,
+                                     Precision const *const step_max,
+                                     Precision *const output);
+
+  typedef void (*DistanceToOutKernel)(Vector3D<Precision> const &dimensions,
+                                      SOA3D<Precision> const &positions,
+                                      SOA3D<Precision> const &directions,
+                                      Precision *const output);
+
+  InsideKernel inside;
+  DistanceToInKernel distance_to_in;
+  DistanceToOutKernel distance_to_out;
+
+};
+
+/**
+ * Kernels compiled for each instruction set, defined in separate translation
+ * units built with the corresponding target flags.
+ */
+BoxBasketKernels BoxBasketKernelsSse4();
+BoxBasketKernels BoxBasketKernelsAvx2();
+BoxBasketKernels BoxBasketKernelsAvx512();
+
+/**
+ * Singleton binding basket kernels to the best variant supported by the
+ * processor, as detected with CPUID. Binding is performed once when the
+ * geometry is closed, after which placed volumes call the bound kernels
+ * through function pointers. Until then, or for kernels without a variant
+ * for any supported instruction set, the baseline is used.
+ *
+ * The highest instruction set considered can be lowered by setting the
+ * environment variable VECGEOM_ISA to baseline, sse4, avx2 or avx512.
+ */
+class IsaDispatch {
+
+private:
+
+  InstructionSet detected_;
+  InstructionSet limit_;
+  InstructionSet box_inside_;
+  InstructionSet box_distance_to_in_;
+  InstructionSet box_distance_to_out_;
+  BoxBasketKernels box_;
+  bool bound_;
+
+public:
+
+  static char const *const labels[];
+
+  static IsaDispatch& Instance() {
+    static IsaDispatch instance;
+    return instance;
+  }
+
+  /**
+   * \return Highest instruction set supported by both the processor and the
+   *         operating system.
+   */
+  static InstructionSet Detect();
+
+  /**
+   * Binds every kernel to the best variant not exceeding the detected
+   * instruction set and the limit given by VECGEOM_ISA. Performed only once
+   * unless forced. Must not be called while kernels are executing.
+   */
+  void Bind(const bool force = false);
+
+  /**
+   * Binds every kernel to the best variant not exceeding the given limit or
+   * the detected instruction set.
+   */
+  void Bind(const InstructionSet limit);
+
+  bool bound() const { return bound_; }
+
+  InstructionSet detected() const { return detected_; }
+
+  InstructionSet limit() const { return limit_; }
+
+  /**
+   * \return Kernels to use for boxes. Entries are NULL where the baseline
+   *         should be used. Used by all placed boxes, including specialized
+   *         ones.
+   */
+  BoxBasketKernels const& box() const { return box_; }
+
+  /**
+   * Replaces the bound box kernels, e.g. to substitute instrumented kernels
+   * when testing. Must not be called while kernels are executing.
+   */
+  void set_box(BoxBasketKernels const &box) { box_ = box; }
+
+  /**
+   * Prints the detected instruction set and the variant bound per kernel.
+   */
+  void Print(std::ostream &os) const;
+
+private:
+
+  IsaDispatch();
+
+  IsaDispatch(IsaDispatch const&);
+  IsaDispatch& operator=(IsaDispatch const&);
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_ISA_DISPATCH
+
+#endif // VECGEOM_MANAGEMENT_ISADISPATCH_H_
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef VECGEOM_MANAGEMENT_PARALLELBASKET_H_
+#define VECGEOM_MANAGEMENT_PARALLELBASKET_H_
+
+#include "base/global.h"
+#include "base/soa3d.h"
+#include "management/thread_pool.h"
+
+namespace vecgeom {
+
+/**
+ * Parallel versions of the basket entry points for large numbers of points,
+ * such as material scans and validation. Baskets are split into chunks that
+ * are processed on a thread pool, with results written in place to the
+ * output arrays. Chunks are views into the input, so no data is copied.
+ *
+ * Chunk sizes are multiples of the number of elements per alignment
+ * boundary, so chunks of aligned baskets remain aligned for the vector
+ * kernels. The default size keeps the inputs and outputs of a chunk within
+ * the first level data cache.
+ */
+class ParallelBasket {
+
+public:
+
+  static const int kDefaultChunkSize = 512;
+
+private:
+
+  ThreadPool *pool_;
+  int chunk_size_;
+  Schedule schedule_;
+
+public:
+
+  /**
+   * Uses the shared pool of ThreadPool::Instance().
+   */
+  ParallelBasket();
+
+  explicit ParallelBasket(ThreadPool &pool);
+
+  ThreadPool& pool() const { return *pool_; }
+
+  int chunk_size() const { return chunk_size_; }
+
+  Schedule schedule() const { return schedule_; }
+
+  /**
+   * \param chunk_size Points per chunk, rounded up to a multiple of the
+   *                   number of elements per alignment boundary.
+   */
+  void set_chunk_size(const int chunk_size);
+
+  void set_schedule(const Schedule schedule) { schedule_ = schedule; }
+
+  /**
+   * \return Number of chunks a basket of the given size is split into.
+   */
+  int chunks(const int size) const {
+    return (size + chunk_size_ - 1) / chunk_size_;
+  }
+
+  void Inside(VPlacedVolume const &volume, SOA3D<Precision> const &points,
+              bool *const output) const;
+
+  void DistanceToIn(VPlacedVolume const &volume,
+                    SOA3D<Precision> const &positions,
+                    SOA3D<Precision> const &directions,
+                    Precision const *const step_max,
+                    Precision *const output) const;
+
+  /**
+   * Locates the deepest volume containing each point.
+   * \param world Volume to start from.
+   * \param points Points in the frame of the mother of the world.
+   * \param max_level Maximum depth of the geometry including the world.
+   * \param output Located volume per point, or NULL if outside the world.
+   */
+  void Locate(VPlacedVolume const *const world,
+              SOA3D<Precision> const &points, const int max_level,
+              VPlacedVolume const **const output) const;
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_MANAGEMENT_PARALLELBASKET_H_
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef VECGEOM_MANAGEMENT_THREADPOOL_H_
+#define VECGEOM_MANAGEMENT_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "base/global.h"
+
+namespace vecgeom {
+
+/**
+ * Assignment of chunks to threads. Static scheduling gives each thread a
+ * contiguous range of chunks, which suits uniform work. Dynamic scheduling
+ * lets threads take the next unprocessed chunk, which balances work of
+ * varying cost.
+ */
+enum Schedule { kScheduleStatic, kScheduleDynamic };
+
+/**
+ * Pool of worker threads processing chunks of work in parallel. Workers are
+ * started on construction and wait between calls to Run(), so the pool can
+ * be reused for many calls at little cost. The calling thread takes part in
+ * processing.
+ *
+ * Calls to Run() from different threads are serialized. Calls from within a
+ * running task are processed serially by the calling thread.
+ */
+class ThreadPool {
+
+public:
+
+  typedef std::function<void(int)> Task;
+
+private:
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable finish_;
+  unsigned generation_;
+  int running_;
+  bool stop_;
+
+  // Current call
+  Task const *task_;
+  int chunks_;
+  Schedule schedule_;
+  std::atomic<int> next_chunk_;
+
+public:
+
+  /**
+   * \param threads Number of threads including the calling thread. Values
+   *                below one use all available hardware threads.
+   */
+  explicit ThreadPool(const int threads = 0);
+
+  ~ThreadPool();
+
+  /**
+   * Pool using all hardware threads, shared by the parallel entry points by
+   * default. Started on first use.
+   */
+  static ThreadPool& Instance();
+
+  /**
+   * \return Number of threads processing chunks, including the caller.
+   */
+  int threads() const { return workers_.size() + 1; }
+
+  /**
+   * \return Whether the calling thread is processing a chunk of any pool, in
+   *         which case calls to Run() are processed serially.
+   */
+  static bool InTask();
+
+  /**
+   * Runs the task once for every chunk index in [0, chunks), distributed over
+   * all threads, and returns when all chunks are processed.
+   */
+  void Run(const int chunks, Task const &task,
+           const Schedule schedule = kScheduleDynamic);
+
+private:
+
+  ThreadPool(ThreadPool const&);
+  ThreadPool& operator=(ThreadPool const&);
+
+  void Work(const int thread);
+
+  /**
+   * Processes the chunks of the current call assigned to a thread.
+   */
+  void Process(const int thread);
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_MANAGEMENT_THREADPOOL_H_
\ No newline at end of file
@@ -0,0 +1,151 @@
+#ifndef VECGEOM_NAVIGATION_BASKETIZER_H_
+#define VECGEOM_NAVIGATION_BASKETIZER_H_
+
+#include <deque>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+#include "base/global.h"
+#include "base/soa3d.h"
+#include "base/vector3d.h"
+#include "navigation/navigation_state.h"
+#include "navigation/simple_navigator.h"
+
+namespace vecgeom {
+
+/**
+ * Regroups tracks handed over one at a time into baskets of tracks located in
+ * the same logical volume, so scalar transport can use the basket navigation
+ * methods. Each track is transformed to the local frame of its volume and
+ * stored in the aligned SOA3D buffers of the bucket of that volume. A bucket
+ * is emitted when it reaches the basket size, or when its oldest track has
+ * waited for the flush deadline, counted in tracks added to the basketizer
+ * since. Emitting a bucket computes the distance to the next boundary for all
+ * its tracks and scatters the results to the output arrays, indexed by the
+ * slot given for each track.
+ */
+class Basketizer {
+
+public:
+
+  struct Statistics {
+    long tracks;
+    long baskets;
+    long deadline_flushes;
+
+    double mean_basket_size() const {
+      return baskets ? static_cast<double>(tracks) / baskets : 0;
+    }
+  };
+
+private:
+
+  struct Bucket {
+    VPlacedVolume const *volume;
+    SOA3D<Precision> points, directions;
+    std::vector<Precision> step_max;
+    std::vector<int> slots;
+    long opened;
+
+    Bucket(const int capacity)
+        : volume(NULL), points(capacity), directions(capacity),
+          step_max(capacity), opened(0) {
+      slots.reserve(capacity);
+    }
+  };
+
+  int basket_size_;
+  long deadline_;
+  long clock_;
+  std::map<LogicalVolume const*, Bucket*> buckets_;
+  // Opening time of non-empty buckets, oldest first
+  std::deque<std::pair<long, Bucket*> > pending_;
+  SimpleNavigator navigator_;
+  std::vector<Precision> steps_;
+  std::vector<VPlacedVolume const*> next_volumes_;
+  Precision *output_steps_;
+  VPlacedVolume const **output_next_volumes_;
+  Statistics statistics_;
+
+public:
+
+  /**
+   * \param basket_size Number of tracks at which a bucket is emitted.
+   * \param deadline Number of added tracks after which a bucket is emitted
+   *                 regardless of its size. Zero disables the deadline.
+   */
+  Basketizer(const int basket_size = 16, const long deadline = 0);
+
+  ~Basketizer();
+
+  int basket_size() const { return basket_size_; }
+
+  long deadline() const { return deadline_; }
+
+  /**
+   * Emits all pending tracks before changing the basket size.
+   */
+  void set_basket_size(const int basket_size);
+
+  /**
+   * Buckets holding tracks when the deadline is enabled count from the time
+   * their oldest track was added.
+   */
+  void set_deadline(const long deadline);
+
+  /**
+   * \param steps Output distance per slot, at most the step_max of the track.
+   * \param next_volumes Output daughter hit per slot, or NULL if the track
+   *                     leaves its volume or is limited by step_max.
+   */
+  void set_output(Precision *const steps,
+                  VPlacedVolume const **const next_volumes) {
+    output_steps_ = steps;
+    output_next_volumes_ = next_volumes;
+  }
+
+  /**
+   * Adds a track to the bucket of its current volume, which requires the
+   * output to be set with set_output(). Tracks outside the
+   * world get an infinite step immediately. Results of this or other tracks
+   * are written to the output when their bucket is emitted, which can happen
+   * during this call.
+   * \param slot Index in the output arrays.
+   * \param point Position in the global frame.
+   * \param direction Direction in the global frame.
+   * \param state Location of the track.
+   */
+  void Add(const int slot, Vector3D<Precision> const &point,
+           Vector3D<Precision> const &direction,
+           NavigationState const &state,
+           const Precision step_max = kInfinity);
+
+  /**
+   * Emits all buckets holding tracks.
+   */
+  void Flush();
+
+  /**
+   * \return Number of tracks added whose results are not yet available.
+   */
+  int pending() const;
+
+  Statistics const& statistics() const { return statistics_; }
+
+  void PrintStatistics(std::ostream &os) const;
+
+private:
+
+  Basketizer(Basketizer const&);
+  Basketizer& operator=(Basketizer const&);
+
+  void Emit(Bucket &bucket);
+
+  void ClearBuckets();
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_NAVIGATION_BASKETIZER_H_
\ No newline at end of file
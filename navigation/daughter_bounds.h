@@ -0,0 +1,108 @@
+#ifndef VECGEOM_NAVIGATION_DAUGHTERBOUNDS_H_
+#define VECGEOM_NAVIGATION_DAUGHTERBOUNDS_H_
+
+#include <limits>
+#include <vector>
+#include "base/global.h"
+#include "base/vector3d.h"
+#include "backend/backend.h"
+#include "backend/scalar_backend.h"
+
+namespace vecgeom {
+
+/**
+ * Distance returned for rays missing a bounding sphere. Finite, since
+ * comparisons against infinity are not reliable with -ffast-math.
+ */
+const Precision kBoundsMiss = std::numeric_limits<Precision>::max();
+
+/**
+ * Computes the distance along a ray to enter a sphere, which is zero if the
+ * origin of the ray is inside the sphere and kBoundsMiss if the ray misses it.
+ */
+template <ImplType it>
+VECGEOM_INLINE
+void SphereDistanceToIn(
+    Vector3D<typename Impl<it>::precision_v> const &center,
+    typename Impl<it>::precision_v const &radius,
+    Vector3D<Precision> const &point,
+    Vector3D<Precision> const &direction,
+    typename Impl<it>::precision_v *const distance) {
+
+  typedef typename Impl<it>::precision_v Float;
+
+  const Float to_x = center[0] - point[0];
+  const Float to_y = center[1] - point[1];
+  const Float to_z = center[2] - point[2];
+  // Projection of the center on the ray, and squared distance of the origin
+  // to the sphere, negative inside
+  const Float projection =
+      to_x*direction[0] + to_y*direction[1] + to_z*direction[2];
+  const Float outside = to_x*to_x + to_y*to_y + to_z*to_z - radius*radius;
+  Float discriminant = projection*projection - outside;
+  const typename Impl<it>::bool_v miss =
+      outside > 0 && (discriminant < 0 || projection < 0);
+  MaskedAssign(discriminant < 0, Impl<it>::kZero, &discriminant);
+  *distance = projection - Sqrt(discriminant);
+  MaskedAssign(outside <= 0, Impl<it>::kZero, distance);
+  MaskedAssign(miss, kBoundsMiss, distance);
+}
+
+/**
+ * Bounding spheres of the daughters of a logical volume in its frame, stored
+ * as structure of arrays padded to a multiple of the vector size. Provides
+ * lower bounds of the distance to enter each daughter along a ray, computed
+ * over several daughters at once with the vector backend if available, so the
+ * navigator only calls the exact DistanceToIn of daughters that can limit a
+ * step.
+ */
+class DaughterBounds {
+
+public:
+
+  /**
+   * Number of daughters processed per call to DistanceToIn(), which is a
+   * multiple of every vector size.
+   */
+  static const int kChunkSize = 64;
+
+private:
+
+  int size_;
+  std::vector<Precision> x_, y_, z_, radius_;
+
+public:
+
+  DaughterBounds() : size_(0) {}
+
+  int size() const { return size_; }
+
+  /**
+   * Appends the bounding sphere of the next daughter, slightly enlarged so
+   * the bounds stay conservative under rounding.
+   * \param center Center of the sphere in the frame of the mother.
+   */
+  void Add(Vector3D<Precision> const &center, const Precision radius);
+
+  /**
+   * Removes the bounds of all daughters.
+   */
+  void Clear();
+
+  /**
+   * Computes lower bounds of the distance to enter the daughters in the range
+   * [first, first + kChunkSize), as far as they exist. Entries past the last
+   * daughter are undefined.
+   * \param point Point in the frame of the mother.
+   * \param direction Direction in the frame of the mother.
+   * \param output Output array of kChunkSize elements.
+   */
+  void DistanceToIn(Vector3D<Precision> const &point,
+                    Vector3D<Precision> const &direction, const int first,
+                    Precision *const output) const;
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_NAVIGATION_DAUGHTERBOUNDS_H_
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef VECGEOM_NAVIGATION_FACENEIGHBORS_H_
+#define VECGEOM_NAVIGATION_FACENEIGHBORS_H_
+
+#include <vector>
+#include "base/global.h"
+
+namespace vecgeom {
+
+/**
+ * Adjacency of the daughters of a logical volume, giving for each face of each
+ * daughter the sibling found just outside the center of the face. A track
+ * leaving a daughter through a face usually enters that sibling, so the
+ * navigator can try it with a single Inside() test before relocating from the
+ * mother. Neighbors are only a guess and must be confirmed by the caller.
+ */
+class FaceNeighbors {
+
+private:
+
+  struct Entry {
+    int id;
+    int offset;
+    int faces;
+  };
+
+  // Sorted by the id of the daughter
+  std::vector<Entry> entries_;
+  std::vector<VPlacedVolume const*> neighbors_;
+
+  static bool CompareId(Entry const &a, Entry const &b) { return a.id < b.id; }
+
+public:
+
+  FaceNeighbors() {}
+
+  /**
+   * Rebuilds the table for the current daughters of the volume, testing the
+   * center of every face of every daughter against all its siblings.
+   */
+  void Build(LogicalVolume const *const mother);
+
+  int size() const { return entries_.size(); }
+
+  /**
+   * \return Sibling bordering the face of the daughter, or NULL if the face
+   *         borders the mother or the daughter is not in the table.
+   */
+  VPlacedVolume const* Neighbor(VPlacedVolume const *const daughter,
+                                const int face) const;
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_NAVIGATION_FACENEIGHBORS_H_
\ No newline at end of file
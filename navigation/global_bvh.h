@@ -0,0 +1,162 @@
+#ifndef VECGEOM_NAVIGATION_GLOBALBVH_H_
+#define VECGEOM_NAVIGATION_GLOBALBVH_H_
+
+#include <cstddef>
+#include <vector>
+#include "base/global.h"
+#include "base/transformation_matrix.h"
+#include "base/vector3d.h"
+#include "navigation/navigation_state.h"
+
+namespace vecgeom {
+
+/**
+ * Bounding volume hierarchy over the axis-aligned bounding boxes of all
+ * touchable volumes below a world, in the global frame. Each touchable keeps
+ * its mother in the index and the composed transformation from the global
+ * frame to the frame in which it is placed, so a point is located by a single
+ * query instead of descending the geometry level by level, and the full path
+ * is restored from the touchable found. Each copy of a replica is a touchable
+ * of its own, which shares the placement of the cell and carries its index.
+ *
+ * Intermediate volumes are indexed along with the leaves, so points in the
+ * gaps between daughters are located by the same query. The deepest touchable
+ * containing the point is returned, which matches descending the hierarchy as
+ * long as daughters do not overlap and are contained in their mothers.
+ *
+ * The index holds one entry per touchable volume, which can be many times the
+ * number of placed volumes, so memory_size() reports its footprint.
+ * Geometries with more touchables than the given maximum are not indexed.
+ * The geometry must not change while the index is in use.
+ */
+class GlobalBvh {
+
+public:
+
+  static const long kDefaultMaxTouchables = 1<<22;
+
+  /**
+   * Maximum number of touchables per leaf node.
+   */
+  static const int kLeafSize = 4;
+
+  /**
+   * Maximum depth of indexed paths, which bounds the path restored on the
+   * stack.
+   */
+  static const int kMaxLevel = 64;
+
+private:
+
+  struct Touchable {
+    VPlacedVolume const *volume;
+    // Index of the touchable of the mother, -1 for the world
+    int parent;
+    // Level at which the volume is pushed to a state, 1 for the world
+    int level;
+    // Index of the replica copy, -1 for volumes placed individually
+    int copy;
+    // Transformation from the global frame to the frame of the mother, moved
+    // to the copy for replica copies
+    TransformationMatrix to_placement;
+    // Bounding box in the global frame
+    Precision lower[3], upper[3];
+  };
+
+  struct Node {
+    Precision lower[3], upper[3];
+    // Inner nodes have no touchables, and their children are stored at first
+    // and first + 1. Leaves hold order_[first, first + count).
+    int first;
+    int count;
+  };
+
+  class CompareCenter;
+
+  VPlacedVolume const *world_;
+  int max_level_;
+  std::vector<Touchable> touchables_;
+  std::vector<int> order_;
+  std::vector<Node> nodes_;
+
+public:
+
+  explicit GlobalBvh(VPlacedVolume const *const world,
+                     const long max_touchables = kDefaultMaxTouchables);
+
+  VPlacedVolume const* world() const { return world_; }
+
+  /**
+   * \return Whether the geometry could be indexed.
+   */
+  bool built() const { return !nodes_.empty(); }
+
+  int touchable_count() const { return touchables_.size(); }
+
+  int node_count() const { return nodes_.size(); }
+
+  /**
+   * \return Deepest level of any indexed touchable.
+   */
+  int max_level() const { return max_level_; }
+
+  /**
+   * \return Bytes allocated by the index.
+   */
+  size_t memory_size() const;
+
+  /**
+   * Locates the deepest touchable containing a point, with the same outputs
+   * as SimpleNavigator::LocatePoint() starting from the world.
+   * \param point Point in the global frame.
+   * \param local_point Output point in the frame of the located volume.
+   * \param state Empty state to which the path of the located volume is
+   *              pushed.
+   * \return Located volume, or NULL if the point is outside the world.
+   */
+  VPlacedVolume const* LocatePoint(Vector3D<Precision> const &point,
+                                   Vector3D<Precision> &local_point,
+                                   NavigationState &state) const;
+
+private:
+
+  GlobalBvh(GlobalBvh const&);
+  GlobalBvh& operator=(GlobalBvh const&);
+
+  /**
+   * Appends the touchables of the daughters of a touchable, depth first.
+   * \return False if the maximum number of touchables or the maximum level
+   *         is exceeded.
+   */
+  bool AddDaughters(const int parent, const long max_touchables);
+
+  /**
+   * Computes the bounding box of a touchable from its transformation.
+   */
+  void SetBounds(const int index);
+
+  /**
+   * Builds the subtree of a node over order_[begin, end) by splitting at the
+   * median center of the bounding boxes along the axis in which the centers
+   * are spread the most.
+   */
+  void BuildNode(const int node, const int begin, const int end);
+
+  /**
+   * \return Whether a touchable is deeper than another, or at the same level
+   *         and found first when descending the hierarchy.
+   */
+  bool Precedes(const int a, const int b) const;
+
+  /**
+   * Sorts candidate touchables so that preceding ones come first.
+   * \return First candidate containing the point, or -1 if none does.
+   */
+  int FirstContaining(Vector3D<Precision> const &point,
+                      int *const candidates, const int count) const;
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_NAVIGATION_GLOBALBVH_H_
\ No newline at end of file
@@ -0,0 +1,143 @@
+#ifndef VECGEOM_NAVIGATION_GLOBALTRANSFORMCACHE_H_
+#define VECGEOM_NAVIGATION_GLOBALTRANSFORMCACHE_H_
+
+#include <atomic>
+#include <vector>
+#include "base/global.h"
+#include "base/transformation_matrix.h"
+#include "base/vector3d.h"
+#include "navigation/navigation_state.h"
+
+namespace vecgeom {
+
+/**
+ * Transformation from the global frame to the local frame of a touchable
+ * volume, composed along its path, with translation and rotation codes
+ * classified once so points are converted by a single specialized transform
+ * regardless of depth.
+ */
+struct GlobalTransform {
+  TransformationMatrix matrix;
+  TranslationCode trans_code;
+  RotationCode rot_code;
+
+  VECGEOM_INLINE
+  Vector3D<Precision> Transform(Vector3D<Precision> const &point) const;
+
+  VECGEOM_INLINE
+  Vector3D<Precision> TransformDirection(
+      Vector3D<Precision> const &direction) const;
+};
+
+/**
+ * Cache of global transformations shared between threads, indexed by a
+ * compact path id. Touchable volumes are numbered in depth first order below
+ * the world, so the id of a path is the sum of an offset per placed volume
+ * along it, and all ids lie in [0, touchable_count()). Copies of a replica
+ * share a placement, which adds its offset plus the index of the copy times
+ * the number of touchable volumes per copy.
+ *
+ * Entries are composed on first use and published with a compare-and-swap,
+ * after which lookups are a single atomic load. The geometry must not change
+ * while the cache is in use. Geometries with more touchable volumes than the
+ * maximum number of entries are not cached, and lookups return NULL.
+ */
+class GlobalTransformCache {
+
+public:
+
+  static const long kDefaultMaxEntries = 1<<24;
+
+private:
+
+  VPlacedVolume const *world_;
+  long touchable_count_;
+  // Offset of the path id per placed volume id, -1 for volumes outside the
+  // hierarchy of the world
+  std::vector<long> offsets_;
+  // Touchable volumes per copy for placements shared by replica copies, zero
+  // for other volumes
+  std::vector<long> strides_;
+  mutable std::vector<std::atomic<GlobalTransform const*> > entries_;
+  mutable std::atomic<long> filled_;
+
+public:
+
+  explicit GlobalTransformCache(VPlacedVolume const *const world,
+                                const long max_entries = kDefaultMaxEntries);
+
+  ~GlobalTransformCache();
+
+  VPlacedVolume const* world() const { return world_; }
+
+  long touchable_count() const { return touchable_count_; }
+
+  /**
+   * \return Number of transformations composed so far.
+   */
+  long filled() const { return filled_.load(std::memory_order_relaxed); }
+
+  /**
+   * \return Id of the path formed by the first levels of the state, or -1 if
+   *         the path is not covered by the cache.
+   */
+  long PathId(NavigationState const &state, const int level) const;
+
+  /**
+   * \return Transformation from the global frame to the frame of the volume at
+   *         the given level, which is the local frame of state.At(level-1),
+   *         or NULL if the path is not covered by the cache.
+   */
+  GlobalTransform const* Lookup(NavigationState const &state,
+                                const int level) const;
+
+  /**
+   * \return Transformation to the local frame of the top volume of the state,
+   *         or NULL if the path is not covered by the cache.
+   */
+  GlobalTransform const* Lookup(NavigationState const &state) const {
+    return Lookup(state, state.level());
+  }
+
+private:
+
+  GlobalTransformCache(GlobalTransformCache const&);
+  GlobalTransformCache& operator=(GlobalTransformCache const&);
+
+  static GlobalTransform* Compose(NavigationState const &state,
+                                  const int level);
+
+};
+
+Vector3D<Precision> GlobalTransform::Transform(
+    Vector3D<Precision> const &point) const {
+  if (trans_code == translation::kOrigin) {
+    if (rot_code == rotation::kIdentity) return point;
+    if (rot_code == rotation::kDiagonal) {
+      return matrix.Transform<translation::kOrigin, rotation::kDiagonal>(point);
+    }
+    return matrix.Transform<translation::kOrigin, 0>(point);
+  }
+  if (rot_code == rotation::kIdentity) {
+    return matrix.Transform<translation::kTranslation,
+                            rotation::kIdentity>(point);
+  }
+  if (rot_code == rotation::kDiagonal) {
+    return matrix.Transform<translation::kTranslation,
+                            rotation::kDiagonal>(point);
+  }
+  return matrix.Transform<translation::kTranslation, 0>(point);
+}
+
+Vector3D<Precision> GlobalTransform::TransformDirection(
+    Vector3D<Precision> const &direction) const {
+  if (rot_code == rotation::kIdentity) return direction;
+  if (rot_code == rotation::kDiagonal) {
+    return matrix.TransformRotation<rotation::kDiagonal>(direction);
+  }
+  return matrix.TransformRotation<0>(direction);
+}
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_NAVIGATION_GLOBALTRANSFORMCACHE_H_
\ No newline at end of file
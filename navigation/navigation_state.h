@@ -0,0 +1,373 @@
+#ifndef VECGEOM_NAVIGATION_NAVIGATIONSTATE_H_
+#define VECGEOM_NAVIGATION_NAVIGATIONSTATE_H_
+
+#include <cassert>
+#include "base/global.h"
+#include "base/transformation_matrix.h"
+#include "base/vector3d.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+/**
+ * Path of placed volumes from the world down to the volume containing a track.
+ * The first element is the placed world volume. An empty path means the track
+ * is outside the world. Copies of a replica share a single placement, so each
+ * level also carries the index of the copy, which is -1 for volumes placed
+ * individually.
+ *
+ * The state also caches the last isotropic safety computed for the track and
+ * the global point it was computed at. Any change of the path invalidates it.
+ *
+ * Optionally, the state carries a stack of the point and direction of the
+ * track transformed to the frame of each level, so moving up a level costs no
+ * transformation and moving down costs a single one. Entries are valid up to
+ * local_level(), and popping volumes off the path discards the entries of
+ * their frames.
+ */
+class NavigationState {
+
+private:
+
+  int max_level_;
+  int level_;
+  VPlacedVolume const **path_;
+  int *copies_;
+  Precision safety_;
+  Vector3D<Precision> safety_point_;
+  // Points followed by directions per level, level zero being the global
+  // frame. NULL if the state does not track local points.
+  Vector3D<Precision> *local_;
+  int local_level_;
+
+public:
+
+  /**
+   * \param max_level Maximum depth of the path, which must be at least the
+   *                  depth of the geometry including the world volume.
+   * \param track_local Whether to carry the point and direction of the track
+   *                    in the frame of each level.
+   */
+  NavigationState(const int max_level, const bool track_local = false)
+      : max_level_(max_level), level_(0),
+        path_(new VPlacedVolume const*[max_level]),
+        copies_(new int[max_level]), safety_(0),
+        local_(track_local ? new Vector3D<Precision>[2*(max_level+1)] : NULL),
+        local_level_(-1) {}
+
+  NavigationState(NavigationState const &other)
+      : max_level_(other.max_level_), level_(other.level_),
+        path_(new VPlacedVolume const*[other.max_level_]),
+        copies_(new int[other.max_level_]), safety_(other.safety_),
+        safety_point_(other.safety_point_),
+        local_(other.local_ ? new Vector3D<Precision>[2*(max_level_+1)]
+                            : NULL),
+        local_level_(-1) {
+    for (int i = 0; i < level_; ++i) {
+      path_[i] = other.path_[i];
+      copies_[i] = other.copies_[i];
+    }
+    CopyLocal(other);
+  }
+
+  ~NavigationState() {
+    delete[] path_;
+    delete[] copies_;
+    delete[] local_;
+  }
+
+  /**
+   * Copies the path of another state. Both states must have the same maximum
+   * depth.
+   */
+  VECGEOM_INLINE
+  NavigationState& operator=(NavigationState const &other) {
+    assert(max_level_ == other.max_level_);
+    level_ = other.level_;
+    for (int i = 0; i < level_; ++i) {
+      path_[i] = other.path_[i];
+      copies_[i] = other.copies_[i];
+    }
+    safety_ = other.safety_;
+    safety_point_ = other.safety_point_;
+    CopyLocal(other);
+    return *this;
+  }
+
+  VECGEOM_INLINE
+  int max_level() const { return max_level_; }
+
+  /**
+   * \return Number of volumes in the path.
+   */
+  VECGEOM_INLINE
+  int level() const { return level_; }
+
+  VECGEOM_INLINE
+  bool IsOutside() const { return level_ == 0; }
+
+  VECGEOM_INLINE
+  VPlacedVolume const* At(const int index) const { return path_[index]; }
+
+  /**
+   * \return Index of the replica copy at the given position of the path, or
+   *         -1 if the volume there is placed individually.
+   */
+  VECGEOM_INLINE
+  int CopyAt(const int index) const { return copies_[index]; }
+
+  /**
+   * \return Deepest volume in the path, or NULL if outside the world.
+   */
+  VECGEOM_INLINE
+  VPlacedVolume const* Top() const {
+    return (level_ > 0) ? path_[level_-1] : NULL;
+  }
+
+  /**
+   * \param copy Index of the copy if the volume is the placement shared by
+   *             the copies of a replica, -1 otherwise.
+   */
+  VECGEOM_INLINE
+  void Push(VPlacedVolume const *const volume, const int copy = -1) {
+    assert(level_ < max_level_);
+    copies_[level_] = copy;
+    path_[level_++] = volume;
+    safety_ = 0;
+  }
+
+  VECGEOM_INLINE
+  void Pop() {
+    if (level_ > 0) --level_;
+    safety_ = 0;
+    if (local_level_ > level_) local_level_ = level_;
+  }
+
+  VECGEOM_INLINE
+  void Clear() {
+    level_ = 0;
+    safety_ = 0;
+    if (local_level_ > 0) local_level_ = 0;
+  }
+
+  VECGEOM_INLINE
+  bool tracks_local() const { return local_ != NULL; }
+
+  /**
+   * \return Deepest level with a valid local point and direction, or -1 if
+   *         none are stored.
+   */
+  VECGEOM_INLINE
+  int local_level() const { return local_level_; }
+
+  /**
+   * Makes the given global point and direction the base of the local stack.
+   * Entries already stored are kept if they were computed for the same point
+   * and direction.
+   * \return False if the state does not track local points.
+   */
+  VECGEOM_INLINE
+  bool SetGlobal(Vector3D<Precision> const &point,
+                 Vector3D<Precision> const &direction) {
+    if (!local_) return false;
+    if (!MatchesGlobal(point, direction)) {
+      local_[0] = point;
+      local_[max_level_+1] = direction;
+      local_level_ = 0;
+    }
+    return true;
+  }
+
+  /**
+   * \return Whether the local stack was computed for the given global point
+   *         and direction.
+   */
+  VECGEOM_INLINE
+  bool MatchesGlobal(Vector3D<Precision> const &point,
+                     Vector3D<Precision> const &direction) const {
+    if (local_level_ < 0) return false;
+    Vector3D<Precision> const &stored = local_[0];
+    Vector3D<Precision> const &stored_dir = local_[max_level_+1];
+    return stored[0] == point[0] && stored[1] == point[1] &&
+           stored[2] == point[2] && stored_dir[0] == direction[0] &&
+           stored_dir[1] == direction[1] && stored_dir[2] == direction[2];
+  }
+
+  /**
+   * Extends the local stack down to the current level, transforming once per
+   * missing level. Requires the global point to be set.
+   */
+  VECGEOM_INLINE
+  void UpdateLocal() {
+    assert(local_level_ >= 0);
+    Vector3D<Precision> *const directions = local_ + max_level_ + 1;
+    for (; local_level_ < level_; ++local_level_) {
+      TransformationMatrix const *const matrix = path_[local_level_]->matrix();
+      local_[local_level_+1] = TransformPoint(
+        *matrix, ToPlacementFrame(local_level_, local_[local_level_])
+      );
+      directions[local_level_+1] =
+          TransformDirection(*matrix, directions[local_level_]);
+    }
+  }
+
+  /**
+   * Moves the point at every stored level along its direction.
+   */
+  VECGEOM_INLINE
+  void AdvanceLocal(const Precision distance) {
+    Vector3D<Precision> const *const directions = local_ + max_level_ + 1;
+    for (int i = 0; i <= local_level_; ++i) {
+      local_[i] += directions[i]*distance;
+    }
+  }
+
+  /**
+   * \return Point in the frame of the given level, which must not exceed
+   *         local_level().
+   */
+  VECGEOM_INLINE
+  Vector3D<Precision> const& LocalPoint(const int level) const {
+    assert(level <= local_level_);
+    return local_[level];
+  }
+
+  VECGEOM_INLINE
+  Vector3D<Precision> const& LocalDirection(const int level) const {
+    assert(level <= local_level_);
+    return local_[max_level_+1+level];
+  }
+
+  /**
+   * Caches the isotropic safety of the track at a global point.
+   */
+  VECGEOM_INLINE
+  void SetSafety(Vector3D<Precision> const &point, const Precision safety) {
+    safety_ = safety;
+    safety_point_ = point;
+  }
+
+  VECGEOM_INLINE
+  void InvalidateSafety() { safety_ = 0; }
+
+  /**
+   * \return Cached safety reduced by the distance the track has moved since,
+   *         which is not positive if no safety is cached.
+   */
+  VECGEOM_INLINE
+  Precision RemainingSafety(Vector3D<Precision> const &point) const {
+    if (safety_ <= 0) return 0;
+    return safety_ - (point - safety_point_).Length();
+  }
+
+  /**
+   * Transforms a global point to the frame of the volume at the given level,
+   * which is the local frame of At(level-1). Level zero is the global frame.
+   */
+  VECGEOM_INLINE
+  Vector3D<Precision> TransformToLevel(Vector3D<Precision> const &point,
+                                       const int level) const {
+    Vector3D<Precision> local = point;
+    for (int i = 0; i < level; ++i) {
+      local = TransformPoint(*path_[i]->matrix(), ToPlacementFrame(i, local));
+    }
+    return local;
+  }
+
+  VECGEOM_INLINE
+  Vector3D<Precision> TransformDirectionToLevel(
+      Vector3D<Precision> const &direction, const int level) const {
+    Vector3D<Precision> local = direction;
+    for (int i = 0; i < level; ++i) {
+      local = TransformDirection(*path_[i]->matrix(), local);
+    }
+    return local;
+  }
+
+  /**
+   * \return Global point transformed to the local frame of Top().
+   */
+  VECGEOM_INLINE
+  Vector3D<Precision> GlobalToLocal(Vector3D<Precision> const &point) const {
+    return TransformToLevel(point, level_);
+  }
+
+  VECGEOM_INLINE
+  Vector3D<Precision> GlobalToLocalDirection(
+      Vector3D<Precision> const &direction) const {
+    return TransformDirectionToLevel(direction, level_);
+  }
+
+  VECGEOM_INLINE
+  bool operator==(NavigationState const &other) const {
+    if (level_ != other.level_) return false;
+    for (int i = 0; i < level_; ++i) {
+      if (path_[i] != other.path_[i] || copies_[i] != other.copies_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  VECGEOM_INLINE
+  bool operator!=(NavigationState const &other) const {
+    return !(*this == other);
+  }
+
+  /**
+   * Moves a point in the frame of At(index-1) to the frame in which the
+   * placement at the given index stands, which differs only for replica
+   * copies.
+   */
+  VECGEOM_INLINE
+  Vector3D<Precision> ToPlacementFrame(const int index,
+                                       Vector3D<Precision> const &point) const {
+    if (copies_[index] < 0) return point;
+    return path_[index-1]->logical_volume()->replica()->ToCopy(
+      point, copies_[index]
+    );
+  }
+
+private:
+
+  /**
+   * Transforms a point to the frame of a placement, skipping translation and
+   * rotation where the matrix has none, as specialized placements do.
+   */
+  VECGEOM_INLINE
+  static Vector3D<Precision> TransformPoint(
+      TransformationMatrix const &matrix, Vector3D<Precision> const &point) {
+    if (matrix.IsIdentity()) return point;
+    if (!matrix.HasRotation()) {
+      return matrix.Transform<translation::kTranslation,
+                              rotation::kIdentity>(point);
+    }
+    if (!matrix.HasTranslation()) {
+      return matrix.Transform<translation::kOrigin, 0>(point);
+    }
+    return matrix.Transform<translation::kTranslation, 0>(point);
+  }
+
+  VECGEOM_INLINE
+  static Vector3D<Precision> TransformDirection(
+      TransformationMatrix const &matrix,
+      Vector3D<Precision> const &direction) {
+    if (!matrix.HasRotation()) return direction;
+    return matrix.TransformRotation<0>(direction);
+  }
+
+  VECGEOM_INLINE
+  void CopyLocal(NavigationState const &other) {
+    if (!local_) return;
+    local_level_ = other.local_ ? other.local_level_ : -1;
+    for (int i = 0; i <= local_level_; ++i) {
+      local_[i] = other.local_[i];
+      local_[max_level_+1+i] = other.local_[max_level_+1+i];
+    }
+  }
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_NAVIGATION_NAVIGATIONSTATE_H_
\ No newline at end of file
@@ -0,0 +1,257 @@
+#ifndef VECGEOM_NAVIGATION_SIMPLENAVIGATOR_H_
+#define VECGEOM_NAVIGATION_SIMPLENAVIGATOR_H_
+
+#include "base/global.h"
+#include "base/soa3d.h"
+#include "base/vector3d.h"
+#include "navigation/global_bvh.h"
+#include "navigation/global_transform_cache.h"
+#include "navigation/navigation_state.h"
+
+namespace vecgeom {
+
+/**
+ * Navigates tracks through a hierarchy of placed volumes by testing all
+ * daughters of the current volume. Scalar methods operate on global
+ * coordinates and a navigation state, while the basket method operates on
+ * points in the local frame of a common volume, allowing tracks in different
+ * placements of the same logical volume to be processed together.
+ *
+ * The navigator holds a workspace for basket processing and should not be
+ * shared between threads.
+ */
+class SimpleNavigator {
+
+public:
+
+  /**
+   * Distance by which tracks are moved past a boundary after a step, so
+   * they are located on the far side of it.
+   */
+  static const Precision kPushDistance;
+
+private:
+
+  Precision *workspace_;
+  unsigned workspace_size_;
+  bool culling_;
+  bool neighbor_lookup_;
+  bool safety_caching_;
+  GlobalTransformCache const *transform_cache_;
+  GlobalBvh const *global_bvh_;
+
+public:
+
+  SimpleNavigator()
+      : workspace_(NULL), workspace_size_(0), culling_(true),
+        neighbor_lookup_(true), safety_caching_(false),
+        transform_cache_(NULL), global_bvh_(NULL) {}
+
+  ~SimpleNavigator();
+
+  bool culling() const { return culling_; }
+
+  /**
+   * \param culling Whether scalar steps skip the exact DistanceToIn of
+   *                daughters whose bounding sphere is not closer than the
+   *                best distance found so far. Culling does not change
+   *                results.
+   */
+  void set_culling(const bool culling) { culling_ = culling; }
+
+  bool neighbor_lookup() const { return neighbor_lookup_; }
+
+  /**
+   * \param neighbor_lookup Whether scalar steps leaving a daughter through a
+   *                        face first test the sibling bordering that face,
+   *                        as given by the face neighbors of the mother,
+   *                        before relocating from the mother. The lookup does
+   *                        not change results for geometries without
+   *                        overlaps.
+   */
+  void set_neighbor_lookup(const bool neighbor_lookup) {
+    neighbor_lookup_ = neighbor_lookup;
+  }
+
+  bool safety_caching() const { return safety_caching_; }
+
+  /**
+   * \param safety_caching Whether scalar steps limited by step_max compute
+   *                       the safety at their start point and cache it in the
+   *                       next state. Computing it costs a second pass over
+   *                       the daughters, which only pays off for tracks
+   *                       taking several short steps in the same volume.
+   */
+  void set_safety_caching(const bool safety_caching) {
+    safety_caching_ = safety_caching;
+  }
+
+  GlobalTransformCache const* transform_cache() const {
+    return transform_cache_;
+  }
+
+  /**
+   * \param cache Cache of global transformations used by the scalar methods
+   *              to convert global points and directions to local frames, or
+   *              NULL to compose the transformations along the path on every
+   *              conversion. Can be shared between navigators.
+   */
+  void set_transform_cache(GlobalTransformCache const *const cache) {
+    transform_cache_ = cache;
+  }
+
+  GlobalBvh const* global_bvh() const { return global_bvh_; }
+
+  /**
+   * \param bvh Index of the touchable volumes of a world used by
+   *            LocatePoint() to locate points from that world into an empty
+   *            state with a single query, or NULL to descend level by level.
+   *            Can be shared between navigators.
+   */
+  void set_global_bvh(GlobalBvh const *const bvh) { global_bvh_ = bvh; }
+
+  /**
+   * Locates the deepest volume containing a point, descending from the given
+   * volume, which is pushed to the state if it contains the point. Queries
+   * the global BVH instead if one is set for the volume and the state is
+   * empty.
+   * \param volume Volume to start from.
+   * \param point Point in the frame of the mother of the volume.
+   * \param local_point Output point in the frame of the located volume.
+   * \param state State to which the path below its current top is pushed.
+   * \return Located volume, or NULL if the volume does not contain the point.
+   */
+  VPlacedVolume const* LocatePoint(VPlacedVolume const *const volume,
+                                   Vector3D<Precision> const &point,
+                                   Vector3D<Precision> &local_point,
+                                   NavigationState &state) const;
+
+  /**
+   * Locates a point after it has moved, reusing the path of the state. Volumes
+   * that no longer contain the point are popped before descending again.
+   * \param global_point Point in the global frame.
+   * \return Located volume, or NULL if the point left the world.
+   */
+  VPlacedVolume const* Relocate(Vector3D<Precision> const &global_point,
+                                NavigationState &state) const;
+
+  /**
+   * Computes the distance to the next boundary from a global point inside the
+   * top volume of the current state, moves the point across it and locates
+   * the point in the new volume.
+   *
+   * Steps which, including the push distance, end within the safety cached
+   * by the current state return step_max without any geometry computation.
+   * If safety caching is enabled, steps limited by step_max cache the safety
+   * at the global point in the next state, so subsequent short steps in the
+   * same volume can skip the computation until the safety is used up.
+   *
+   * If the states track local points, the stack of the next state is moved to
+   * global_point + global_dir*(step + kPushDistance), where the next state is
+   * located. Stepping from that point reuses the stack, so only levels entered
+   * since the last step are transformed.
+   * \param next_state Output state after the step.
+   * \return Length of the step, which is at most step_max.
+   */
+  Precision FindNextBoundaryAndStep(Vector3D<Precision> const &global_point,
+                                    Vector3D<Precision> const &global_dir,
+                                    NavigationState const &current_state,
+                                    NavigationState &next_state,
+                                    const Precision step_max) const;
+
+  /**
+   * Computes the isotropic safety of a global point inside the top volume of
+   * the state, which is the distance to the closest boundary of the top
+   * volume and its daughters in any direction or an underestimate of it, and
+   * caches it in the state.
+   * \return Safety, zero if the point is outside the world or on a boundary.
+   */
+  Precision ComputeSafety(Vector3D<Precision> const &global_point,
+                          NavigationState &state) const;
+
+  /**
+   * Computes the distance to the next boundary for a basket of tracks inside
+   * the given volume.
+   * \param volume Volume containing all tracks. Only its logical volume is
+   *               used, so any placement of it can be passed.
+   * \param points Positions in the local frame of the volume.
+   * \param directions Directions in the local frame of the volume.
+   * \param step_max Maximum step per track.
+   * \param steps Output distance per track, at most step_max.
+   * \param next_volumes Output daughter hit by each track, or NULL if the
+   *                     track leaves the volume or is limited by step_max.
+   *                     Copies of a replica all report their shared
+   *                     placement, so the copy entered must be found by
+   *                     relocating the track.
+   */
+  void FindNextBoundary(VPlacedVolume const *const volume,
+                        SOA3D<Precision> const &points,
+                        SOA3D<Precision> const &directions,
+                        Precision const *const step_max,
+                        Precision *const steps,
+                        VPlacedVolume const **const next_volumes);
+
+private:
+
+  SimpleNavigator(SimpleNavigator const&);
+  SimpleNavigator& operator=(SimpleNavigator const&);
+
+  /**
+   * Descends through the daughters of the top volume of the state.
+   * \param local_point Point in the frame of the top volume, which is updated
+   *                    to the frame of the located volume.
+   * \param track_local Whether the point is the local point stored for the
+   *                    top level of the state, in which case the stack is
+   *                    extended while descending.
+   */
+  VPlacedVolume const* LocateDaughters(Vector3D<Precision> &local_point,
+                                       NavigationState &state,
+                                       const bool track_local = false) const;
+
+  /**
+   * Relocates the state after its local stack has been moved across a
+   * boundary, testing the stored points instead of transforming the global
+   * point at every level.
+   */
+  void RelocateLocal(NavigationState &state) const;
+
+  /**
+   * Moves the state from its top volume to the sibling bordering the face
+   * the track left through, if that sibling contains the point.
+   * \param point Point after the step in the frame of the mother.
+   * \param track_local Whether the local stack of the state is valid for the
+   *                    point, and is to be extended.
+   * \return Whether the state was moved.
+   */
+  bool EnterNeighbor(Vector3D<Precision> const &point, const int face,
+                     NavigationState &state, const bool track_local) const;
+
+  /**
+   * \param local_point Point in the local frame of the volume.
+   */
+  Precision Safety(VPlacedVolume const *const volume,
+                   Vector3D<Precision> const &local_point) const;
+
+  /**
+   * Transforms a global point to the frame of the volume at the given level
+   * of the state, using the transformation cache if available.
+   */
+  Vector3D<Precision> TransformToLevel(Vector3D<Precision> const &point,
+                                       NavigationState const &state,
+                                       const int level) const {
+    if (transform_cache_) {
+      if (GlobalTransform const *const transform =
+              transform_cache_->Lookup(state, level)) {
+        return transform->Transform(point);
+      }
+    }
+    return state.TransformToLevel(point, level);
+  }
+
+  Precision* Workspace(const unsigned size);
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_NAVIGATION_SIMPLENAVIGATOR_H_
\ No newline at end of file
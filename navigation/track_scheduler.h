@@ -0,0 +1,209 @@
+#ifndef VECGEOM_NAVIGATION_TRACKSCHEDULER_H_
+#define VECGEOM_NAVIGATION_TRACKSCHEDULER_H_
+
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "base/global.h"
+#include "base/vector3d.h"
+#include "navigation/navigation_state.h"
+
+namespace vecgeom {
+
+/**
+ * Tracks located in the same logical volume, processed together by the
+ * basket navigation methods. Refers to tracks by their index in the
+ * scheduler.
+ */
+struct TrackBasket {
+  int volume;
+  std::vector<int> tracks;
+};
+
+/**
+ * Double ended queue of baskets for work stealing, after Chase and Lev as
+ * formulated for weak memory models by Le et al. The owning thread pushes and
+ * pops at the bottom without locking, while other threads steal from the top
+ * with a single compare-and-swap. The capacity is fixed, which suffices as
+ * every track is held by at most one basket at a time.
+ */
+class BasketDeque {
+
+private:
+
+  std::atomic<long> top_;
+  std::atomic<long> bottom_;
+  std::vector<std::atomic<TrackBasket*> > buffer_;
+  long mask_;
+
+public:
+
+  /**
+   * \param capacity Maximum number of baskets held, rounded up to a power of
+   *                 two.
+   */
+  explicit BasketDeque(const int capacity);
+
+  /**
+   * Only called by the owning thread.
+   */
+  void Push(TrackBasket *const basket);
+
+  /**
+   * Only called by the owning thread.
+   * \return Most recently pushed basket, or NULL if empty.
+   */
+  TrackBasket* Pop();
+
+  /**
+   * Can be called by any thread.
+   * \return Least recently pushed basket, or NULL if empty or lost to a
+   *         concurrent pop or steal.
+   */
+  TrackBasket* Steal();
+
+private:
+
+  BasketDeque(BasketDeque const&);
+  BasketDeque& operator=(BasketDeque const&);
+
+};
+
+/**
+ * Multithreaded transport of neutral tracks through a geometry, organized in
+ * baskets of tracks located in the same logical volume. Each worker thread
+ * collects the tracks it has stepped into baskets per destination volume.
+ * Baskets reaching the configured size are pushed to the work stealing deque
+ * of the worker, from which it pops its own baskets, and idle workers steal
+ * baskets from others. Workers without any full basket available emit their
+ * partially filled baskets, so all tracks make progress.
+ *
+ * Every step moves a track to the next boundary and past it by the push
+ * distance of the navigator, and relocates it. Tracks are transported until
+ * they leave the world or reach the maximum number of steps.
+ */
+class TrackScheduler {
+
+public:
+
+  struct Statistics {
+    long baskets;
+    long steps;
+    long steals;
+    long flushes;
+
+    double mean_basket_size() const {
+      return baskets ? static_cast<double>(steps) / baskets : 0;
+    }
+  };
+
+private:
+
+  VPlacedVolume const *world_;
+  int max_level_;
+  int threads_;
+  int basket_size_;
+  int max_steps_;
+
+  // Tracks
+  std::vector<Vector3D<Precision> > positions_;
+  std::vector<Vector3D<Precision> > directions_;
+  std::vector<NavigationState> states_;
+  std::vector<int> steps_;
+  std::vector<Precision> lengths_;
+
+  // Logical volumes reachable from the world, indexing the baskets
+  std::map<LogicalVolume const*, int> volume_index_;
+
+  std::atomic<long> alive_;
+  Statistics statistics_;
+
+public:
+
+  /**
+   * \param max_level Maximum depth of the geometry including the world.
+   */
+  TrackScheduler(VPlacedVolume const *const world, const int max_level);
+
+  int threads() const { return threads_; }
+
+  int basket_size() const { return basket_size_; }
+
+  int max_steps() const { return max_steps_; }
+
+  /**
+   * \param threads Number of worker threads. Values below one use all
+   *                available hardware threads.
+   */
+  void set_threads(const int threads);
+
+  /**
+   * \param basket_size Number of tracks at which baskets are emitted.
+   */
+  void set_basket_size(const int basket_size) {
+    basket_size_ = (basket_size > 0) ? basket_size : 1;
+  }
+
+  void set_max_steps(const int max_steps) { max_steps_ = max_steps; }
+
+  /**
+   * Locates a new track in the world.
+   * \return Index of the track.
+   */
+  int AddTrack(Vector3D<Precision> const &position,
+               Vector3D<Precision> const &direction);
+
+  int track_count() const { return positions_.size(); }
+
+  Vector3D<Precision> const& position(const int track) const {
+    return positions_[track];
+  }
+
+  NavigationState const& state(const int track) const {
+    return states_[track];
+  }
+
+  /**
+   * \return Number of steps the track has taken.
+   */
+  int steps(const int track) const { return steps_[track]; }
+
+  /**
+   * \return Length travelled by the track, excluding push distances.
+   */
+  Precision length(const int track) const { return lengths_[track]; }
+
+  /**
+   * Transports all tracks until they leave the world or reach the maximum
+   * number of steps. When called from within a ThreadPool task, all tracks
+   * are transported by the calling thread.
+   */
+  void Transport();
+
+  /**
+   * \return Counters of the last call to Transport().
+   */
+  Statistics const& statistics() const { return statistics_; }
+
+  void PrintStatistics(std::ostream &os) const;
+
+private:
+
+  TrackScheduler(TrackScheduler const&);
+  TrackScheduler& operator=(TrackScheduler const&);
+
+  void IndexVolumes(LogicalVolume const *const volume);
+
+  /**
+   * \return Whether the track is inside the world and can take more steps.
+   */
+  bool Active(const int track) const;
+
+  friend class TransportWorker;
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_NAVIGATION_TRACKSCHEDULER_H_
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "navigation/basketizer.h"
+
+#include <algorithm>
+#include <cassert>
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+Basketizer::Basketizer(const int basket_size, const long deadline)
+    : basket_size_((basket_size > 0) ? basket_size : 1),
+      deadline_(deadline), clock_(0), steps_(basket_size_),
+      next_volumes_(basket_size_), output_steps_(NULL),
+      output_next_volumes_(NULL) {
+  statistics_.tracks = 0;
+  statistics_.baskets = 0;
+  statistics_.deadline_flushes = 0;
+}
+
+Basketizer::~Basketizer() {
+  ClearBuckets();
+}
+
+void Basketizer::ClearBuckets() {
+  for (std::map<LogicalVolume const*, Bucket*>::iterator i = buckets_.begin();
+       i != buckets_.end(); ++i) {
+    delete i->second;
+  }
+  buckets_.clear();
+  pending_.clear();
+}
+
+void Basketizer::set_basket_size(const int basket_size) {
+  Flush();
+  ClearBuckets();
+  basket_size_ = (basket_size > 0) ? basket_size : 1;
+  steps_.resize(basket_size_);
+  next_volumes_.resize(basket_size_);
+}
+
+void Basketizer::set_deadline(const long deadline) {
+  deadline_ = deadline;
+  pending_.clear();
+  if (deadline_ <= 0) return;
+  // Buckets opened while the deadline was disabled have no pending entry
+  for (std::map<LogicalVolume const*, Bucket*>::iterator i = buckets_.begin();
+       i != buckets_.end(); ++i) {
+    if (!i->second->slots.empty()) {
+      pending_.push_back(std::make_pair(i->second->opened, i->second));
+    }
+  }
+  std::sort(pending_.begin(), pending_.end());
+}
+
+void Basketizer::Add(const int slot, Vector3D<Precision> const &point,
+                     Vector3D<Precision> const &direction,
+                     NavigationState const &state,
+                     const Precision step_max) {
+  assert(output_steps_ && output_next_volumes_ &&
+         "Basketizer output must be set before adding tracks.");
+  ++clock_;
+  if (state.IsOutside()) {
+    output_steps_[slot] = kInfinity;
+    output_next_volumes_[slot] = NULL;
+  } else {
+    VPlacedVolume const *const volume = state.Top();
+    ++statistics_.tracks;
+    Bucket *&bucket = buckets_[volume->logical_volume()];
+    if (!bucket) bucket = new Bucket(basket_size_);
+    const int index = bucket->slots.size();
+    if (!index) {
+      bucket->volume = volume;
+      bucket->opened = clock_;
+      if (deadline_ > 0) pending_.push_back(std::make_pair(clock_, bucket));
+    }
+    bucket->points.Set(index, state.GlobalToLocal(point));
+    bucket->directions.Set(index, state.GlobalToLocalDirection(direction));
+    bucket->step_max[index] = step_max;
+    bucket->slots.push_back(slot);
+    if (index + 1 >= basket_size_) Emit(*bucket);
+  }
+  if (deadline_ <= 0) return;
+  while (!pending_.empty() && pending_.front().first + deadline_ <= clock_) {
+    Bucket &bucket = *pending_.front().second;
+    // Entries of buckets emitted and refilled since are stale
+    if (bucket.opened == pending_.front().first && !bucket.slots.empty()) {
+      Emit(bucket);
+      ++statistics_.deadline_flushes;
+    }
+    pending_.pop_front();
+  }
+}
+
+void Basketizer::Emit(Bucket &bucket) {
+  const int size = bucket.slots.size();
+  const SOA3D<Precision> points(bucket.points.x(), bucket.points.y(),
+                                bucket.points.z(), size);
+  const SOA3D<Precision> directions(bucket.directions.x(),
+                                    bucket.directions.y(),
+                                    bucket.directions.z(), size);
+  navigator_.FindNextBoundary(bucket.volume, points, directions,
+                              &bucket.step_max[0], &steps_[0],
+                              &next_volumes_[0]);
+  for (int i = 0; i < size; ++i) {
+    output_steps_[bucket.slots[i]] = steps_[i];
+    output_next_volumes_[bucket.slots[i]] = next_volumes_[i];
+  }
+  bucket.slots.clear();
+  ++statistics_.baskets;
+}
+
+void Basketizer::Flush() {
+  for (std::map<LogicalVolume const*, Bucket*>::iterator i = buckets_.begin();
+       i != buckets_.end(); ++i) {
+    if (!i->second->slots.empty()) Emit(*i->second);
+  }
+  pending_.clear();
+}
+
+int Basketizer::pending() const {
+  int count = 0;
+  for (std::map<LogicalVolume const*, Bucket*>::const_iterator
+       i = buckets_.begin(); i != buckets_.end(); ++i) {
+    count += i->second->slots.size();
+  }
+  return count;
+}
+
+void Basketizer::PrintStatistics(std::ostream &os) const {
+  os << "Basketized " << statistics_.tracks << " tracks into "
+     << statistics_.baskets << " baskets of "
+     << statistics_.mean_basket_size() << " tracks on average, "
+     << statistics_.deadline_flushes << " emitted by deadline.\n";
+}
+
+} // End namespace vecgeom
\ No newline at end of file
@@ -1,15 +1,69 @@
+#include <cstdlib>
+#include "base/stopwatch.h"
 #include "comparison/shape_tester.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+#include "volumes/unplaced_box.h"
+#ifdef VECGEOM_COMPARISON
+#include "TGeoShape.h"
+#include "VUSolid.hh"
+#endif
 
 namespace vecgeom {
 
 const char * const ShapeBenchmark::benchmark_labels[] = {
   "Specialized",
   "Placed",
+  "Vectorized",
+  "PlacedVectorized",
   "USolids",
   "ROOT"
 };
 
+const char * const ShapeBenchmark::method_labels[] = {
+  "Inside",
+  "DistanceToIn",
+  "DistanceToOut"
+};
+
+namespace {
+
+const BenchmarkMethod kMethods[] = {kInside, kDistanceToIn, kDistanceToOut};
+const int kMethodCount = 3;
+
+#ifdef VECGEOM_COMPARISON
+const BenchmarkType kTypes[] = {kSpecialized, kPlaced, kVectorized,
+                                kPlacedVectorized, kUSolids, kRoot};
+const int kTypeCount = 6;
+#else
+const BenchmarkType kTypes[] = {kSpecialized, kPlaced, kVectorized,
+                                kPlacedVectorized};
+const int kTypeCount = 4;
+#endif
+
+// Distances at or beyond this value are considered a miss, as ROOT and USolids
+// report misses with large finite values.
+const Precision kMissDistance = 1e30;
+
+Precision RandomUniform() {
+  return static_cast<Precision>(rand()) / RAND_MAX;
+}
+
+Vector3D<Precision> RandomDirection() {
+  Vector3D<Precision> direction;
+  Precision length;
+  do {
+    for (int i = 0; i < 3; ++i) direction[i] = 2.*RandomUniform() - 1.;
+    length = direction.Length();
+  } while (length > 1. || length < kNearZero);
+  direction /= length;
+  return direction;
+}
+
+} // End anonymous namespace
+
 ShapeTester::~ShapeTester() {
+  ClearVolumes();
   if (steps_) _mm_free(steps_);
 }
 
@@ -21,251 +75,516 @@ void ShapeTester::set_pool_multiplier(const unsigned pool_multiplier) {
   pool_multiplier_ = pool_multiplier;
 }
 
-// void ShapeTester::GenerateVolumePointers(PhysicalVolume const *const vol) {
-
-//   if (vol != world) {
-//     VolumePointers pointers;
-//     pointers.fastgeom = vol;
-//     pointers.usolids = vol->GetAsUnplacedUSolid();
-//     pointers.root = vol->GetAsUnplacedROOTSolid();
-//     volumes.push_back(pointers);
-//   }
-
-//   std::list<PhysicalVolume const*> const *daughters = vol->GetDaughterList();
-//   if (!daughters || !daughters->size()) return;
-//   for (auto d : *daughters) {
-//     GenerateVolumePointers(d);
-//   }
-
-//   n_vols = volumes.size();
-
-// }
-
-// ShapeBenchmark ShapeTester::GenerateBenchmark(const double elapsed,
-//                                               const BenchmarkType type) const {
-//   const ShapeBenchmark benchmark = {
-//     .elapsed = elapsed,
-//     .type = type,
-//     .repetitions = reps,
-//     .volumes = (const unsigned) volumes.size(),
-//     .points = n_points,
-//     .bias = bias
-//   };
-//   return benchmark;
-// }
-
-// ShapeBenchmark ShapeTester::RunPlaced(double* distances) const {
-//   if (verbose) std::cout << "Running Placed benchmark...";
-//   StopWatch timer;
-//   timer.Start();
-//   for (int r = 0; r < reps; ++r) {
-//     const int index = (rand() % pool_multiplier) * n_points;
-//     Vectors3DSOA points(point_pool, index, n_points);
-//     Vectors3DSOA dirs(dir_pool, index, n_points);
-//     for (int v = 0; v < n_vols; ++v) {
-//       volumes[v].fastgeom->DistanceToIn(points, dirs, steps, &distances[index]);
-//     }
-//   }
-//   timer.Stop();
-//   const double elapsed = timer.getDeltaSecs();
-//   if (verbose) std::cout << " Finished in " << elapsed << "s.\n";
-//   return GenerateBenchmark(elapsed, kPlaced);
-// }
-
-// ShapeBenchmark ShapeTester::RunUnplaced(double *distances) const {
-//   if (verbose) std::cout << "Running Unplaced benchmark...";
-//   Vectors3DSOA point_pool_transform(point_pool);
-//   Vectors3DSOA dir_pool_transform(dir_pool);
-//   StopWatch timer;
-//   timer.Start();
-//   for (int r = 0; r < reps; ++r) {
-//     const int index = (rand() % pool_multiplier) * n_points;
-//     Vectors3DSOA points(point_pool, index, n_points);
-//     Vectors3DSOA dirs(dir_pool, index, n_points);
-//     Vectors3DSOA points_transform(point_pool_transform, index, n_points);
-//     Vectors3DSOA dirs_transform(dir_pool_transform, index, n_points);
-//     for (int v = 0; v < n_vols; ++v) {
-//       PhysicalVolume const *unplaced =
-//           volumes[v].fastgeom->GetAsUnplacedVolume();
-//       TransformationMatrix const *matrix = volumes[v].fastgeom->getMatrix();
-//       matrix->MasterToLocal(points, points_transform);
-//       matrix->MasterToLocalVec(dirs, dirs_transform);
-//       unplaced->DistanceToIn(
-//         points_transform, dirs_transform, steps, &distances[index]
-//       );
-//     }
-//   }
-//   timer.Stop();
-//   const double elapsed = timer.getDeltaSecs();
-//   if (verbose) std::cout << " Finished in " << elapsed << "s.\n";
-//   return GenerateBenchmark(elapsed, kUnplaced);
-// }
-
-// ShapeBenchmark ShapeTester::RunUSolids(double* distances) const {
-//   std::vector<Vector3D> point_pool_vec(n_points * pool_multiplier);
-//   std::vector<Vector3D> dir_pool_vec(n_points * pool_multiplier);
-//   point_pool.toStructureOfVector3D(point_pool_vec);
-//   dir_pool.toStructureOfVector3D(dir_pool_vec);
-//   if (verbose) std::cout << "Running USolids benchmark...";
-//   StopWatch timer;
-//   timer.Start();
-//   for (int r = 0; r < reps; ++r) {
-//     const int index = (rand() % pool_multiplier) * n_points;
-//     for (int v = 0; v < n_vols; ++v) {
-//       TransformationMatrix const *matrix = volumes[v].fastgeom->getMatrix();
-//       for (int p = 0; p < n_points; ++p) {
-//         Vector3D point_local, dir_local;
-//         matrix->MasterToLocal<1,-1>(point_pool_vec[index+p], point_local);
-//         matrix->MasterToLocalVec<-1>(dir_pool_vec[index+p], dir_local);
-//         distances[index+p] = volumes[v].usolids->DistanceToIn(
-//           reinterpret_cast<UVector3 const&>(point_local),
-//           reinterpret_cast<UVector3 const&>(dir_local), steps[p]
-//         );
-//       }
-//     }
-//   }
-//   timer.Stop();
-//   const double elapsed = timer.getDeltaSecs();
-//   if (verbose) std::cout << " Finished in " << elapsed << "s.\n";
-//   return GenerateBenchmark(elapsed, kUSolids);
-// }
-
-// ShapeBenchmark ShapeTester::RunROOT(double *distances) const {
-//   std::vector<Vector3D> point_pool_vec(n_points * pool_multiplier);
-//   std::vector<Vector3D> dir_pool_vec(n_points * pool_multiplier);
-//   point_pool.toStructureOfVector3D(point_pool_vec);
-//   dir_pool.toStructureOfVector3D(dir_pool_vec);
-//   if (verbose) std::cout << "Running ROOT benchmark...";
-//   StopWatch timer;
-//   timer.Start();
-//   for (int r = 0; r < reps; ++r) {
-//     const int index = (rand() % pool_multiplier) * n_points;
-//     for (int v = 0; v < n_vols; ++v) {
-//       TGeoMatrix const *matrix =
-//           volumes[v].fastgeom->getMatrix()->GetAsTGeoMatrix();
-//       for (int p = 0; p < n_points; ++p) {
-//         Vector3D point_local, dir_local;
-//         matrix->MasterToLocal(&point_pool_vec[index+p].x, &point_local.x);
-//         matrix->MasterToLocalVect(&dir_pool_vec[index+p].x, &dir_local.x);
-//         distances[index+p] =
-//             volumes[v].root->DistFromOutside(&point_local.x, &dir_local.x,
-//                                              3, steps[p], 0);
-//       }
-//     }
-//   }
-//   timer.Stop();
-//   const double elapsed = timer.getDeltaSecs();
-//   if (verbose) std::cout << " Finished in " << elapsed << "s.\n";
-//   return GenerateBenchmark(elapsed, kROOT);
-// }
-
-// void ShapeTester::PrepareBenchmark() {
-
-//   // Allocate memory
-//   if (steps) _mm_free(steps);
-//   point_pool.dealloc();
-//   dir_pool.dealloc();
-//   point_pool.alloc(n_points * pool_multiplier);
-//   dir_pool.alloc(n_points * pool_multiplier);
-//   steps = (double*) _mm_malloc(n_points*sizeof(double),
-//                                kAlignmentBoundary);
-//   for (int i = 0; i < n_points; ++i) steps[i] = Utils::kInfinity;
-
-//   // Generate pointers to volume objects
-//   volumes.clear();
-//   GenerateVolumePointers(world);
-//   world->fillWithRandomPoints(point_pool, n_points * pool_multiplier);
-//   world->fillWithBiasedDirections(point_pool, dir_pool,
-//                                   n_points * pool_multiplier, bias);
-
-// }
-
-// void ShapeTester::BenchmarkAll() {
-
-//   PrepareBenchmark();
-
-//   // Allocate output memory
-//   double *distances_placed   = AllocateDistance();
-//   double *distances_unplaced = AllocateDistance();
-//   double *distances_usolids  = AllocateDistance();
-//   double *distances_root     = AllocateDistance();
-
-//   // Run all four benchmarks
-//   results.push_back(RunPlaced(distances_placed));
-//   results.push_back(RunUnplaced(distances_unplaced));
-//   results.push_back(RunUSolids(distances_usolids));
-//   results.push_back(RunROOT(distances_root));
-
-//   // Compare results
-//   unsigned mismatches = 0;
-//   const double precision = 1e-12;
-//   for (int i = 0; i < n_points * pool_multiplier; ++i) {
-//     const bool root_mismatch =
-//         abs(distances_placed[i] - distances_root[i]) > precision &&
-//         !(distances_placed[i] == Utils::kInfinity && distances_root[i] == 1e30);
-//     const bool usolids_mismatch =
-//         abs(distances_placed[i] - distances_usolids[i]) > precision &&
-//         !(distances_placed[i] == Utils::kInfinity &&
-//           distances_usolids[i] == UUtils::kInfinity);
-//     if (root_mismatch || usolids_mismatch) {
-//       if (!mismatches) std::cout << "Placed / USolids / ROOT\n";
-//       std::cout << distances_placed[i]  << " / "
-//                 << distances_usolids[i] << " / "
-//                 << distances_root[i]    << std::endl;
-//       mismatches++;
-//     }
-//   }
-//   if (verbose) {
-//     std::cout << mismatches << " / " << n_points * pool_multiplier
-//               << " mismatches detected.\n";
-//   }
-
-//   // Clean up memory
-//   FreeDistance(distances_placed);
-//   FreeDistance(distances_unplaced);
-//   FreeDistance(distances_usolids);
-//   FreeDistance(distances_root);
-// }
-
-// void ShapeTester::BenchmarkPlaced() {
-//   PrepareBenchmark();
-//   double *distances = AllocateDistance();
-//   results.push_back(RunPlaced(distances));
-//   FreeDistance(distances);
-// }
-
-// void ShapeTester::BenchmarkUnplaced() {
-//   PrepareBenchmark();
-//   double *distances = AllocateDistance();
-//   results.push_back(RunUnplaced(distances));
-//   FreeDistance(distances);
-// }
-
-// void ShapeTester::BenchmarkUSolids() {
-//   PrepareBenchmark();
-//   double *distances = AllocateDistance();
-//   results.push_back(RunUnplaced(distances));
-//   FreeDistance(distances);
-// }
-
-
-// void ShapeTester::BenchmarkROOT() {
-//   PrepareBenchmark();
-//   double *distances = AllocateDistance();
-//   results.push_back(RunROOT(distances));
-//   FreeDistance(distances);
-// }
-
-// ShapeBenchmark ShapeTester::PopResult() {
-//   ShapeBenchmark result = results.back();
-//   results.pop_back();
-//   return result;
-// }
-
-// std::vector<ShapeBenchmark> ShapeTester::PopResults() {
-//   std::vector<ShapeBenchmark> results_ = results;
-//   results.clear();
-//   return results_;
-// }
+void ShapeTester::ClearVolumes() {
+  for (unsigned v = 0; v < unspecialized_.size(); ++v) {
+    delete unspecialized_[v];
+  }
+  #ifdef VECGEOM_COMPARISON
+  for (unsigned v = 0; v < converted_.size(); ++v) delete converted_[v];
+  converted_.clear();
+  #endif
+  volumes_.clear();
+  unspecialized_.clear();
+  n_vols_ = 0;
+}
+
+void ShapeTester::ConvertVolumes() {
+  ClearVolumes();
+  for (Iterator<Daughter> i = world_->daughters().begin();
+       i != world_->daughters().end(); ++i) {
+    VPlacedVolume const *const daughter = *i;
+    volumes_.push_back(daughter);
+    unspecialized_.push_back(
+      daughter->unplaced_volume()->PlaceVolumeUnspecialized(
+        daughter->logical_volume(), daughter->matrix()
+      )
+    );
+    #ifdef VECGEOM_COMPARISON
+    converted_.push_back(new VolumeConverter(daughter));
+    #endif
+  }
+  n_vols_ = volumes_.size();
+}
+
+bool ShapeTester::PrepareBenchmark() {
+
+  if (!world_) {
+    std::cerr << "No world volume set for shape benchmark.\n";
+    return false;
+  }
+  UnplacedBox const *const world_box =
+      dynamic_cast<UnplacedBox const*>(world_->unplaced_volume());
+  if (!world_box) {
+    std::cerr << "World volume must be a box to sample points.\n";
+    return false;
+  }
+
+  ConvertVolumes();
+  if (!n_vols_) {
+    std::cerr << "World volume has no daughters to benchmark.\n";
+    return false;
+  }
+
+  // Allocate memory
+  const unsigned pool_size = n_points_*pool_multiplier_;
+  point_pool_.Allocate(pool_size);
+  dir_pool_.Allocate(pool_size);
+  inside_pool_.Allocate(n_vols_*pool_size);
+  if (steps_) _mm_free(steps_);
+  steps_ = static_cast<Precision*>(
+    _mm_malloc(n_points_*sizeof(Precision), kAlignmentBoundary)
+  );
+  for (unsigned i = 0; i < n_points_; ++i) steps_[i] = kInfinity;
+
+  // Sample points in the world outside of all daughters. Gives up after a
+  // number of attempts in case daughters fill the world.
+  const int max_attempts = 1000;
+  for (unsigned i = 0; i < pool_size; ++i) {
+    Vector3D<Precision> point;
+    bool contained = false;
+    int attempts = 0;
+    do {
+      for (int j = 0; j < 3; ++j) {
+        point[j] = (2.*RandomUniform() - 1.) * world_box->dimensions()[j];
+      }
+      contained = false;
+      for (unsigned v = 0; v < n_vols_ && !contained; ++v) {
+        contained = volumes_[v]->Inside(point);
+      }
+    } while (contained && ++attempts < max_attempts);
+    point_pool_.Set(i, point);
+  }
+  FillBiasedDirections();
+  FillInsidePoints();
+
+  // The same baskets are used by every code path to allow comparison
+  offsets_.resize(repetitions_);
+  for (unsigned r = 0; r < repetitions_; ++r) {
+    offsets_[r] = (rand() % pool_multiplier_) * n_points_;
+  }
+
+  return true;
+}
+
+void ShapeTester::FillBiasedDirections() {
+  for (unsigned i = 0; i < point_pool_.size(); ++i) {
+    Vector3D<Precision> direction;
+    if (RandomUniform() < bias_) {
+      VPlacedVolume const *const target = volumes_[rand() % n_vols_];
+      direction = target->matrix()->Translation() - point_pool_[i];
+      if (direction.Length() < kNearZero) direction = RandomDirection();
+      direction.Normalize();
+    } else {
+      direction = RandomDirection();
+    }
+    dir_pool_.Set(i, direction);
+  }
+}
+
+void ShapeTester::FillInsidePoints() {
+  const unsigned pool_size = n_points_*pool_multiplier_;
+  const int max_attempts = 1000;
+  for (unsigned v = 0; v < n_vols_; ++v) {
+    const Vector3D<Precision> extent =
+        volumes_[v]->unplaced_volume()->BoundingExtent();
+    for (unsigned i = 0; i < pool_size; ++i) {
+      Vector3D<Precision> point;
+      int attempts = 0;
+      do {
+        for (int j = 0; j < 3; ++j) {
+          point[j] = (2.*RandomUniform() - 1.) * extent[j];
+        }
+      } while (volumes_[v]->SafetyToOut(point) <= 0 &&
+               ++attempts < max_attempts);
+      inside_pool_.Set(v*pool_size + i, point);
+    }
+  }
+}
+
+ShapeBenchmark ShapeTester::GenerateBenchmark(
+    const double elapsed,
+    const BenchmarkType type,
+    const BenchmarkMethod method) const {
+  const ShapeBenchmark benchmark = {
+    elapsed,
+    type,
+    method,
+    repetitions_,
+    n_vols_,
+    n_points_,
+    bias_,
+    0,
+    PerfSample::Create(counters_, static_cast<double>(repetitions_)
+                                  * n_vols_ * n_points_)
+  };
+  return benchmark;
+}
+
+void ShapeTester::RunBenchmark(const BenchmarkType type,
+                               const BenchmarkMethod method,
+                               bool *const inside,
+                               Precision *const distances) {
+  if (verbose_) {
+    std::cout << "Running " << ShapeBenchmark::benchmark_labels[type] << " "
+              << ShapeBenchmark::method_labels[method] << " benchmark...";
+  }
+  for (unsigned i = 0; i < output_size(); ++i) {
+    inside[i] = false;
+    distances[i] = -1;
+  }
+  double elapsed = 0;
+  counters_.Reset();
+  counters_.Start();
+  switch (type) {
+    case kSpecialized:
+      elapsed = RunScalar(volumes_, method, inside, distances);
+      break;
+    case kPlaced:
+      elapsed = RunScalar(unspecialized_, method, inside, distances);
+      break;
+    case kVectorized:
+      elapsed = RunVectorized(volumes_, method, inside, distances);
+      break;
+    case kPlacedVectorized:
+      elapsed = RunVectorized(unspecialized_, method, inside, distances);
+      break;
+    #ifdef VECGEOM_COMPARISON
+    case kUSolids:
+      elapsed = RunUSolids(method, inside, distances);
+      break;
+    case kRoot:
+      elapsed = RunRoot(method, inside, distances);
+      break;
+    #endif
+    default:
+      std::cerr << "Benchmark type unavailable in this build.\n";
+      return;
+  }
+  counters_.Stop();
+  if (verbose_) std::cout << " Finished in " << elapsed << "s.\n";
+  results_.push_back(GenerateBenchmark(elapsed, type, method));
+}
+
+double ShapeTester::RunScalar(std::vector<VPlacedVolume const*> const &volumes,
+                              const BenchmarkMethod method,
+                              bool *const inside,
+                              Precision *const distances) const {
+  const unsigned pool_size = n_points_*pool_multiplier_;
+  Stopwatch timer;
+  timer.Start();
+  for (unsigned r = 0; r < repetitions_; ++r) {
+    const unsigned index = offsets_[r];
+    for (unsigned v = 0; v < n_vols_; ++v) {
+      const unsigned output = v*pool_size + index;
+      if (method == kInside) {
+        for (unsigned p = 0; p < n_points_; ++p) {
+          inside[output+p] = volumes[v]->Inside(point_pool_[index+p]);
+        }
+      } else if (method == kDistanceToIn) {
+        for (unsigned p = 0; p < n_points_; ++p) {
+          distances[output+p] = volumes[v]->DistanceToIn(
+            point_pool_[index+p], dir_pool_[index+p], steps_[p]
+          );
+        }
+      } else {
+        for (unsigned p = 0; p < n_points_; ++p) {
+          distances[output+p] = volumes[v]->DistanceToOut(
+            inside_pool_[output+p], dir_pool_[index+p]
+          );
+        }
+      }
+    }
+  }
+  return timer.Stop();
+}
+
+double ShapeTester::RunVectorized(
+    std::vector<VPlacedVolume const*> const &volumes,
+    const BenchmarkMethod method, bool *const inside,
+    Precision *const distances) {
+  const unsigned pool_size = n_points_*pool_multiplier_;
+  Stopwatch timer;
+  timer.Start();
+  for (unsigned r = 0; r < repetitions_; ++r) {
+    const unsigned index = offsets_[r];
+    SOA3D<Precision> points(point_pool_.x() + index, point_pool_.y() + index,
+                            point_pool_.z() + index, n_points_);
+    SOA3D<Precision> directions(dir_pool_.x() + index, dir_pool_.y() + index,
+                                dir_pool_.z() + index, n_points_);
+    for (unsigned v = 0; v < n_vols_; ++v) {
+      const unsigned output = v*pool_size + index;
+      if (method == kInside) {
+        volumes[v]->Inside(points, &inside[output]);
+      } else if (method == kDistanceToIn) {
+        volumes[v]->DistanceToIn(points, directions, steps_,
+                                 &distances[output]);
+      } else {
+        SOA3D<Precision> local(inside_pool_.x() + output,
+                               inside_pool_.y() + output,
+                               inside_pool_.z() + output, n_points_);
+        volumes[v]->DistanceToOut(local, directions, &distances[output]);
+      }
+    }
+  }
+  return timer.Stop();
+}
+
+#ifdef VECGEOM_COMPARISON
+
+double ShapeTester::RunUSolids(const BenchmarkMethod method,
+                               bool *const inside,
+                               Precision *const distances) const {
+  const unsigned pool_size = n_points_*pool_multiplier_;
+  Stopwatch timer;
+  timer.Start();
+  for (unsigned r = 0; r < repetitions_; ++r) {
+    const unsigned index = offsets_[r];
+    for (unsigned v = 0; v < n_vols_; ++v) {
+      TransformationMatrix const *const matrix = volumes_[v]->matrix();
+      ::VUSolid const *const solid = converted_[v]->usolids();
+      const unsigned output = v*pool_size + index;
+      for (unsigned p = 0; p < n_points_; ++p) {
+        if (method == kDistanceToOut) {
+          const Vector3D<Precision> point = inside_pool_[output+p];
+          const Vector3D<Precision> direction = dir_pool_[index+p];
+          UVector3 normal;
+          bool convex;
+          distances[output+p] = solid->DistanceToOut(
+            UVector3(point[0], point[1], point[2]),
+            UVector3(direction[0], direction[1], direction[2]),
+            normal, convex, kMissDistance
+          );
+          continue;
+        }
+        const Vector3D<Precision> point =
+            matrix->Transform<1, 0>(point_pool_[index+p]);
+        if (method == kInside) {
+          inside[output+p] =
+              solid->Inside(UVector3(point[0], point[1], point[2]))
+              == ::VUSolid::eInside;
+        } else {
+          const Vector3D<Precision> direction =
+              matrix->TransformRotation<0>(dir_pool_[index+p]);
+          distances[output+p] = solid->DistanceToIn(
+            UVector3(point[0], point[1], point[2]),
+            UVector3(direction[0], direction[1], direction[2]),
+            kMissDistance
+          );
+        }
+      }
+    }
+  }
+  return timer.Stop();
+}
+
+double ShapeTester::RunRoot(const BenchmarkMethod method,
+                            bool *const inside,
+                            Precision *const distances) const {
+  const unsigned pool_size = n_points_*pool_multiplier_;
+  Stopwatch timer;
+  timer.Start();
+  for (unsigned r = 0; r < repetitions_; ++r) {
+    const unsigned index = offsets_[r];
+    for (unsigned v = 0; v < n_vols_; ++v) {
+      TransformationMatrix const *const matrix = volumes_[v]->matrix();
+      TGeoShape const *const shape = converted_[v]->root();
+      const unsigned output = v*pool_size + index;
+      for (unsigned p = 0; p < n_points_; ++p) {
+        if (method == kDistanceToOut) {
+          Vector3D<Precision> point = inside_pool_[output+p];
+          Vector3D<Precision> direction = dir_pool_[index+p];
+          distances[output+p] = shape->DistFromInside(
+            &point[0], &direction[0], 3, kMissDistance, 0
+          );
+          continue;
+        }
+        Vector3D<Precision> point =
+            matrix->Transform<1, 0>(point_pool_[index+p]);
+        if (method == kInside) {
+          inside[output+p] = shape->Contains(&point[0]);
+        } else {
+          Vector3D<Precision> direction =
+              matrix->TransformRotation<0>(dir_pool_[index+p]);
+          distances[output+p] = shape->DistFromOutside(
+            &point[0], &direction[0], 3, kMissDistance, 0
+          );
+        }
+      }
+    }
+  }
+  return timer.Stop();
+}
+
+#endif // VECGEOM_COMPARISON
+
+unsigned ShapeTester::CompareInside(bool const *const reference,
+                                    bool const *const inside) const {
+  unsigned mismatches = 0;
+  for (unsigned i = 0; i < output_size(); ++i) {
+    if (reference[i] != inside[i]) {
+      if (verbose_ > 1) {
+        std::cout << "Inside mismatch at " << i << ": " << reference[i]
+                  << " / " << inside[i] << std::endl;
+      }
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+unsigned ShapeTester::CompareDistances(Precision const *const reference,
+                                       Precision const *const distances) const {
+  unsigned mismatches = 0;
+  for (unsigned i = 0; i < output_size(); ++i) {
+    const bool reference_miss = reference[i] >= kMissDistance;
+    const bool miss = distances[i] >= kMissDistance;
+    bool mismatch = reference_miss != miss;
+    if (!reference_miss && !miss) {
+      const Precision scale =
+          (std::fabs(reference[i]) > 1.) ? std::fabs(reference[i]) : 1.;
+      mismatch = std::fabs(reference[i] - distances[i]) > tolerance_*scale;
+    }
+    if (mismatch) {
+      if (verbose_ > 1) {
+        std::cout << "Distance mismatch at " << i << ": " << reference[i]
+                  << " / " << distances[i] << std::endl;
+      }
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+Precision* ShapeTester::AllocateDistances() const {
+  return static_cast<Precision*>(
+    _mm_malloc(output_size()*sizeof(Precision), kAlignmentBoundary)
+  );
+}
+
+bool* ShapeTester::AllocateInside() const {
+  return new bool[output_size()];
+}
+
+unsigned ShapeTester::BenchmarkAll() {
+
+  if (!PrepareBenchmark()) return 0;
+
+  unsigned total = 0;
+  for (int m = 0; m < kMethodCount; ++m) {
+    bool *const inside_reference = AllocateInside();
+    Precision *const distances_reference = AllocateDistances();
+    RunBenchmark(kTypes[0], kMethods[m], inside_reference,
+                 distances_reference);
+    for (int t = 1; t < kTypeCount; ++t) {
+      bool *const inside = AllocateInside();
+      Precision *const distances = AllocateDistances();
+      RunBenchmark(kTypes[t], kMethods[m], inside, distances);
+      const unsigned mismatches = (kMethods[m] == kInside)
+                                  ? CompareInside(inside_reference, inside)
+                                  : CompareDistances(distances_reference,
+                                                     distances);
+      results_.back().mismatches = mismatches;
+      total += mismatches;
+      if (verbose_ && mismatches) {
+        std::cout << mismatches << " / " << output_size()
+                  << " mismatches between "
+                  << ShapeBenchmark::benchmark_labels[kTypes[0]] << " and "
+                  << ShapeBenchmark::benchmark_labels[kTypes[t]] << ".\n";
+      }
+      FreeInside(inside);
+      FreeDistances(distances);
+    }
+    FreeInside(inside_reference);
+    FreeDistances(distances_reference);
+  }
+
+  return total;
+}
+
+void ShapeTester::BenchmarkSpecialized() {
+  if (!PrepareBenchmark()) return;
+  bool *const inside = AllocateInside();
+  Precision *const distances = AllocateDistances();
+  for (int m = 0; m < kMethodCount; ++m) {
+    RunBenchmark(kSpecialized, kMethods[m], inside, distances);
+  }
+  FreeInside(inside);
+  FreeDistances(distances);
+}
+
+void ShapeTester::BenchmarkPlaced() {
+  if (!PrepareBenchmark()) return;
+  bool *const inside = AllocateInside();
+  Precision *const distances = AllocateDistances();
+  for (int m = 0; m < kMethodCount; ++m) {
+    RunBenchmark(kPlaced, kMethods[m], inside, distances);
+  }
+  FreeInside(inside);
+  FreeDistances(distances);
+}
+
+void ShapeTester::BenchmarkVectorized() {
+  if (!PrepareBenchmark()) return;
+  bool *const inside = AllocateInside();
+  Precision *const distances = AllocateDistances();
+  for (int m = 0; m < kMethodCount; ++m) {
+    RunBenchmark(kVectorized, kMethods[m], inside, distances);
+  }
+  FreeInside(inside);
+  FreeDistances(distances);
+}
+
+void ShapeTester::BenchmarkPlacedVectorized() {
+  if (!PrepareBenchmark()) return;
+  bool *const inside = AllocateInside();
+  Precision *const distances = AllocateDistances();
+  for (int m = 0; m < kMethodCount; ++m) {
+    RunBenchmark(kPlacedVectorized, kMethods[m], inside, distances);
+  }
+  FreeInside(inside);
+  FreeDistances(distances);
+}
+
+#ifdef VECGEOM_COMPARISON
+
+void ShapeTester::BenchmarkUSolids() {
+  if (!PrepareBenchmark()) return;
+  bool *const inside = AllocateInside();
+  Precision *const distances = AllocateDistances();
+  for (int m = 0; m < kMethodCount; ++m) {
+    RunBenchmark(kUSolids, kMethods[m], inside, distances);
+  }
+  FreeInside(inside);
+  FreeDistances(distances);
+}
+
+void ShapeTester::BenchmarkRoot() {
+  if (!PrepareBenchmark()) return;
+  bool *const inside = AllocateInside();
+  Precision *const distances = AllocateDistances();
+  for (int m = 0; m < kMethodCount; ++m) {
+    RunBenchmark(kRoot, kMethods[m], inside, distances);
+  }
+  FreeInside(inside);
+  FreeDistances(distances);
+}
+
+#endif // VECGEOM_COMPARISON
+
+ShapeBenchmark ShapeTester::PopResult() {
+  if (results_.empty()) {
+    std::cerr << "No benchmark results to pop.\n";
+    return ShapeBenchmark();
+  }
+  ShapeBenchmark result = results_.back();
+  results_.pop_back();
+  return result;
+}
+
+std::vector<ShapeBenchmark> ShapeTester::PopResults() {
+  std::vector<ShapeBenchmark> results = results_;
+  results_.clear();
+  return results;
+}
 
 } // End namespace vecgeom
\ No newline at end of file
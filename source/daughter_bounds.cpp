@@ -0,0 +1,64 @@
+#include "navigation/daughter_bounds.h"
+
+#include <algorithm>
+
+namespace vecgeom {
+
+const int DaughterBounds::kChunkSize;
+
+void DaughterBounds::Add(Vector3D<Precision> const &center,
+                         const Precision radius) {
+  if (size_ % kChunkSize == 0) {
+    // Pads to a whole chunk, so chunks are processed without a remainder
+    const int padded = size_ + kChunkSize;
+    x_.resize(padded, 0);
+    y_.resize(padded, 0);
+    z_.resize(padded, 0);
+    radius_.resize(padded, 0);
+  }
+  x_[size_] = center[0];
+  y_[size_] = center[1];
+  z_[size_] = center[2];
+  radius_[size_] = radius*(1. + kGTolerance) + kGTolerance;
+  ++size_;
+}
+
+void DaughterBounds::Clear() {
+  size_ = 0;
+  x_.clear();
+  y_.clear();
+  z_.clear();
+  radius_.clear();
+}
+
+void DaughterBounds::DistanceToIn(Vector3D<Precision> const &point,
+                                  Vector3D<Precision> const &direction,
+                                  const int first,
+                                  Precision *const output) const {
+  const int count = std::min(kChunkSize, size_ - first);
+  #ifdef VECGEOM_VECTOR_BACKEND
+  // The padding allows reading whole vectors past the last daughter
+  typedef Impl<kVectorImpl> Backend;
+  for (int i = 0; i < count; i += Backend::kVectorSize) {
+    const int j = first + i;
+    const Vector3D<VectorPrecision> center(
+      Backend::LoadUnaligned(&x_[j]),
+      Backend::LoadUnaligned(&y_[j]),
+      Backend::LoadUnaligned(&z_[j])
+    );
+    VectorPrecision distance;
+    SphereDistanceToIn<kVectorImpl>(center,
+                                    Backend::LoadUnaligned(&radius_[j]),
+                                    point, direction, &distance);
+    Backend::StoreUnaligned(distance, &output[i]);
+  }
+  #else
+  for (int i = 0; i < count; ++i) {
+    const int j = first + i;
+    SphereDistanceToIn<kScalar>(Vector3D<Precision>(x_[j], y_[j], z_[j]),
+                                radius_[j], point, direction, &output[i]);
+  }
+  #endif
+}
+
+} // End namespace vecgeom
\ No newline at end of file
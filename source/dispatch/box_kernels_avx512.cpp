@@ -0,0 +1,49 @@
+/**
+ * Box basket kernels for runtime dispatch, compiled with AVX-512F enabled.
+ * Uses the native AVX-512 backend, so partial chunks are handled with mask
+ * registers.
+ */
+#define VECGEOM_ISA_VARIANT
+#include "management/isa_dispatch.h"
+
+#ifdef VECGEOM_ISA_DISPATCH
+
+#include "backend/avx512_backend.h"
+#include "volumes/kernel/box_kernel.h"
+
+namespace vecgeom {
+
+namespace {
+
+void Inside(Vector3D<Precision> const &dimensions,
+            TransformationMatrix const &matrix,
+            SOA3D<Precision> const &points, bool *const output) {
+  BoxInsideBasket<1, 0, kAvx512>(dimensions, matrix, points, output);
+}
+
+void DistanceToIn(Vector3D<Precision> const &dimensions,
+                  TransformationMatrix const &matrix,
+                  SOA3D<Precision> const &positions,
+                  SOA3D<Precision> const &directions,
+                  Precision const *const step_max, Precision *const output) {
+  BoxDistanceToInBasket<1, 0, kAvx512>(dimensions, matrix, positions,
+                                       directions, step_max, output);
+}
+
+void DistanceToOut(Vector3D<Precision> const &dimensions,
+                   SOA3D<Precision> const &positions,
+                   SOA3D<Precision> const &directions,
+                   Precision *const output) {
+  BoxDistanceToOutBasket<kAvx512>(dimensions, positions, directions, output);
+}
+
+} // End anonymous namespace
+
+BoxBasketKernels BoxBasketKernelsAvx512() {
+  const BoxBasketKernels kernels = {Inside, DistanceToIn, DistanceToOut};
+  return kernels;
+}
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_ISA_DISPATCH
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "navigation/face_neighbors.h"
+
+#include <algorithm>
+#include "base/transformation_matrix.h"
+#include "base/vector3d.h"
+#include "navigation/simple_navigator.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+namespace {
+
+/**
+ * Transforms a point from the local frame of a placed volume to the frame of
+ * its mother, inverting local[j] = sum_i (master[i] - t[i])*rot[3*i+j].
+ */
+Vector3D<Precision> LocalToMaster(TransformationMatrix const &matrix,
+                                  Vector3D<Precision> const &local) {
+  Vector3D<Precision> master;
+  for (int i = 0; i < 3; ++i) {
+    master[i] = matrix.Translation(i);
+    for (int j = 0; j < 3; ++j) master[i] += matrix.Rotation(3*i+j)*local[j];
+  }
+  return master;
+}
+
+} // End anonymous namespace
+
+void FaceNeighbors::Build(LogicalVolume const *const mother) {
+  entries_.clear();
+  neighbors_.clear();
+  // Copies of replicas are found by their index instead
+  if (mother->replica()) return;
+  Container<Daughter> const &daughters = mother->daughters();
+  // Bounding spheres skip the Inside() test of distant siblings, as every
+  // face is tested against every sibling
+  std::vector<Vector3D<Precision> > centers;
+  std::vector<Precision> radii;
+  for (Iterator<Daughter> d = daughters.begin(); d != daughters.end(); ++d) {
+    centers.push_back((*d)->matrix()->Translation());
+    const Precision radius =
+        (*d)->logical_volume()->unplaced_volume()->BoundingRadius();
+    radii.push_back(radius*(1. + kGTolerance) + kGTolerance);
+  }
+  for (Iterator<Daughter> d = daughters.begin(); d != daughters.end(); ++d) {
+    VUnplacedVolume const *const unplaced =
+        (*d)->logical_volume()->unplaced_volume();
+    Entry entry;
+    entry.id = (*d)->id();
+    entry.offset = neighbors_.size();
+    entry.faces = unplaced->FaceCount();
+    entries_.push_back(entry);
+    for (int face = 0; face < entry.faces; ++face) {
+      Vector3D<Precision> point, normal;
+      unplaced->FacePoint(face, point, normal);
+      const Vector3D<Precision> outside = LocalToMaster(
+        *(*d)->matrix(), point + normal*SimpleNavigator::kPushDistance
+      );
+      VPlacedVolume const *neighbor = NULL;
+      int index = 0;
+      for (Iterator<Daughter> s = daughters.begin(); s != daughters.end();
+           ++s, ++index) {
+        if ((outside - centers[index]).Length() > radii[index]) continue;
+        if (*s != *d && (*s)->Inside(outside)) {
+          neighbor = *s;
+          break;
+        }
+      }
+      neighbors_.push_back(neighbor);
+    }
+  }
+  std::sort(entries_.begin(), entries_.end(), CompareId);
+}
+
+VPlacedVolume const* FaceNeighbors::Neighbor(
+    VPlacedVolume const *const daughter, const int face) const {
+  Entry key;
+  key.id = daughter->id();
+  std::vector<Entry>::const_iterator entry =
+      std::lower_bound(entries_.begin(), entries_.end(), key, CompareId);
+  if (entry == entries_.end() || entry->id != key.id) return NULL;
+  if (face < 0 || face >= entry->faces) return NULL;
+  return neighbors_[entry->offset + face];
+}
+
+} // End namespace vecgeom
\ No newline at end of file
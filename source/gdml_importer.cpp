@@ -0,0 +1,547 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include "management/gdml_importer.h"
+#include "volumes/logical_volume.h"
+#include "volumes/unplaced_box.h"
+
+namespace vecgeom {
+
+namespace {
+
+enum GdmlSolidType { kGdmlBox };
+
+/**
+ * Minimal streaming XML parser. Reads the input in fixed size chunks and only
+ * buffers the tag currently being parsed. Text content, comments, processing
+ * instructions and declarations are skipped. Each start and end tag is
+ * reported to the handler, which returns false to abort parsing.
+ */
+class XmlStreamParser {
+
+private:
+
+  static const int kChunkSize = 1<<16;
+
+  GdmlImporter *handler_;
+
+public:
+
+  XmlStreamParser(GdmlImporter *const handler) : handler_(handler) {}
+
+  bool Parse(FILE *const file) {
+    std::vector<char> chunk(kChunkSize);
+    std::string tag;
+    bool in_tag = false;
+    char quote = 0;
+    size_t read;
+    while ((read = fread(&chunk[0], 1, kChunkSize, file)) > 0) {
+      for (size_t i = 0; i < read; ++i) {
+        const char c = chunk[i];
+        if (!in_tag) {
+          if (c == '<') {
+            in_tag = true;
+            tag.clear();
+          }
+          continue;
+        }
+        if (quote) {
+          if (c == quote) quote = 0;
+          tag += c;
+          continue;
+        }
+        // Comments may contain '>', so they end only at "-->"
+        if (tag.compare(0, 3, "!--") == 0) {
+          tag += c;
+          if (c == '>' && tag.size() >= 5 &&
+              tag.compare(tag.size() - 3, 3, "-->") == 0) {
+            in_tag = false;
+          }
+          continue;
+        }
+        if (c == '>') {
+          in_tag = false;
+          if (!HandleTag(tag)) return false;
+          continue;
+        }
+        if (c == '"' || c == '\'') {
+          quote = c;
+        }
+        tag += c;
+      }
+    }
+    if (in_tag) {
+      std::cerr << "Unexpected end of XML input.\n";
+      return false;
+    }
+    return true;
+  }
+
+private:
+
+  static bool IsSpace(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  bool HandleTag(std::string const &tag) {
+    if (tag.empty() || tag[0] == '?' || tag[0] == '!') return true;
+    if (tag[0] == '/') {
+      size_t end = 1;
+      while (end < tag.size() && !IsSpace(tag[end])) ++end;
+      return handler_->EndElement(tag.substr(1, end - 1));
+    }
+    const bool empty = tag[tag.size()-1] == '/';
+    const size_t length = (empty) ? tag.size() - 1 : tag.size();
+    size_t i = 0;
+    while (i < length && !IsSpace(tag[i])) ++i;
+    const std::string name = tag.substr(0, i);
+    std::map<std::string, std::string> attributes;
+    while (i < length) {
+      while (i < length && IsSpace(tag[i])) ++i;
+      const size_t key_begin = i;
+      while (i < length && tag[i] != '=' && !IsSpace(tag[i])) ++i;
+      const std::string key = tag.substr(key_begin, i - key_begin);
+      while (i < length && (IsSpace(tag[i]) || tag[i] == '=')) ++i;
+      if (i >= length) break;
+      const char quote = tag[i];
+      if (quote != '"' && quote != '\'') {
+        std::cerr << "Malformed attribute " << key << " in <" << name
+                  << ">.\n";
+        return false;
+      }
+      const size_t value_end = tag.find(quote, i + 1);
+      if (value_end == std::string::npos) return false;
+      attributes[key] = tag.substr(i + 1, value_end - i - 1);
+      i = value_end + 1;
+    }
+    if (!handler_->StartElement(name, attributes)) return false;
+    if (empty) return handler_->EndElement(name);
+    return true;
+  }
+
+};
+
+Precision LengthUnit(std::map<std::string, std::string> const &attributes) {
+  std::map<std::string, std::string>::const_iterator unit =
+      attributes.find("lunit");
+  if (unit == attributes.end() || unit->second == "mm") return 1.;
+  if (unit->second == "um") return 1e-3;
+  if (unit->second == "cm") return 10.;
+  if (unit->second == "m")  return 1e3;
+  if (unit->second == "km") return 1e6;
+  std::cerr << "Unknown length unit " << unit->second << ", assuming mm.\n";
+  return 1.;
+}
+
+Precision AngleUnit(std::map<std::string, std::string> const &attributes) {
+  std::map<std::string, std::string>::const_iterator unit =
+      attributes.find("aunit");
+  if (unit == attributes.end() || unit->second == "rad") return 1.;
+  if (unit->second == "deg")  return kDegToRad;
+  if (unit->second == "mrad") return 1e-3;
+  std::cerr << "Unknown angle unit " << unit->second << ", assuming rad.\n";
+  return 1.;
+}
+
+std::string Attribute(std::map<std::string, std::string> const &attributes,
+                      char const *const key) {
+  std::map<std::string, std::string>::const_iterator i = attributes.find(key);
+  return (i != attributes.end()) ? i->second : std::string();
+}
+
+/**
+ * Runs function(i) for all i in [0, count) distributed over contiguous ranges
+ * on the given number of threads.
+ */
+template <typename Function>
+void ParallelFor(const int count, const int threads, Function function) {
+  const int used = (threads < count) ? threads : count;
+  if (used <= 1) {
+    for (int i = 0; i < count; ++i) function(i);
+    return;
+  }
+  std::vector<std::thread> workers;
+  for (int t = 0; t < used; ++t) {
+    const int begin = (t * count) / used;
+    const int end = ((t + 1) * count) / used;
+    workers.push_back(std::thread([=]() {
+      for (int i = begin; i < end; ++i) function(i);
+    }));
+  }
+  for (unsigned t = 0; t < workers.size(); ++t) workers[t].join();
+}
+
+/**
+ * Builds the rotation matrix of a GDML rotation, following the convention of
+ * the ROOT GDML reader of rotating by the negated angles about z, y and x.
+ */
+void SetGdmlRotation(Vector3D<Precision> const &angles,
+                     TransformationMatrix *const matrix) {
+  const Precision cx = cos(angles[0]), sx = sin(angles[0]);
+  const Precision cy = cos(angles[1]), sy = sin(angles[1]);
+  const Precision cz = cos(angles[2]), sz = sin(angles[2]);
+  // Rx(-x) * Ry(-y) * Rz(-z)
+  matrix->SetRotation(
+     cy*cz,            cy*sz,           -sy,
+     sx*sy*cz - cx*sz, sx*sy*sz + cx*cz, sx*cy,
+     cx*sy*cz + sx*sz, cx*sy*sz - sx*cz, cx*cy
+  );
+}
+
+struct MatrixKey {
+  Precision values[6];
+  bool operator<(MatrixKey const &other) const {
+    for (int i = 0; i < 6; ++i) {
+      if (values[i] != other.values[i]) return values[i] < other.values[i];
+    }
+    return false;
+  }
+};
+
+struct SolidKey {
+  int type;
+  Precision parameters[3];
+  bool operator<(SolidKey const &other) const {
+    if (type != other.type) return type < other.type;
+    for (int i = 0; i < 3; ++i) {
+      if (parameters[i] != other.parameters[i]) {
+        return parameters[i] < other.parameters[i];
+      }
+    }
+    return false;
+  }
+};
+
+} // End anonymous namespace
+
+GdmlImporter::GdmlImporter()
+    : threads_(0), verbose_(0), world_(NULL), current_volume_(-1),
+      current_physvol_(NULL) {
+  set_threads(0);
+}
+
+GdmlImporter::~GdmlImporter() {
+  Clear();
+}
+
+void GdmlImporter::set_threads(const int threads) {
+  threads_ = threads;
+  if (threads_ < 1) threads_ = std::thread::hardware_concurrency();
+  if (threads_ < 1) threads_ = 1;
+}
+
+void GdmlImporter::Clear() {
+  // Logical volumes delete their placed daughters
+  for (unsigned i = 0; i < logical_.size(); ++i) delete logical_[i];
+  for (unsigned i = 0; i < unplaced_.size(); ++i) delete unplaced_[i];
+  for (unsigned i = 0; i < matrices_.size(); ++i) delete matrices_[i];
+  logical_.clear();
+  unplaced_.clear();
+  matrices_.clear();
+  constants_.clear();
+  positions_.clear();
+  rotations_.clear();
+  solid_names_.clear();
+  volume_names_.clear();
+  solids_.clear();
+  volumes_.clear();
+  world_name_.clear();
+  section_.clear();
+  current_volume_ = -1;
+  current_physvol_ = NULL;
+  world_ = NULL;
+}
+
+LogicalVolume const* GdmlImporter::Import(char const *const file_name) {
+
+  Clear();
+
+  FILE *const file = fopen(file_name, "r");
+  if (!file) {
+    std::cerr << "Could not open GDML file " << file_name << ".\n";
+    return NULL;
+  }
+  XmlStreamParser parser(this);
+  const bool parsed = parser.Parse(file);
+  fclose(file);
+  if (!parsed) {
+    std::cerr << "Failed to parse GDML file " << file_name << ".\n";
+    return NULL;
+  }
+  if (verbose_ > 0) {
+    std::cerr << "Parsed " << solids_.size() << " solids and "
+              << volumes_.size() << " volumes from " << file_name << ".\n";
+  }
+
+  if (!Construct()) return NULL;
+  return world_;
+}
+
+bool GdmlImporter::Evaluate(std::string const &expression,
+                            Precision *const value) const {
+  if (expression.empty()) {
+    *value = 0;
+    return true;
+  }
+  char *end;
+  *value = strtod(expression.c_str(), &end);
+  if (*end == '\0') return true;
+  std::map<std::string, Precision>::const_iterator constant =
+      constants_.find(expression);
+  if (constant != constants_.end()) {
+    *value = constant->second;
+    return true;
+  }
+  std::cerr << "Unsupported GDML expression \"" << expression << "\".\n";
+  return false;
+}
+
+bool GdmlImporter::ReadVector(
+    std::map<std::string, std::string> const &attributes, const bool angle,
+    Vector3D<Precision> *const vector) const {
+  const Precision unit = (angle) ? AngleUnit(attributes)
+                                 : LengthUnit(attributes);
+  char const *const keys[3] = {"x", "y", "z"};
+  for (int i = 0; i < 3; ++i) {
+    Precision value;
+    if (!Evaluate(Attribute(attributes, keys[i]), &value)) return false;
+    (*vector)[i] = unit*value;
+  }
+  return true;
+}
+
+bool GdmlImporter::StartElement(
+    std::string const &name,
+    std::map<std::string, std::string> const &attributes) {
+
+  if (name == "define" || name == "solids" || name == "structure" ||
+      name == "setup" || name == "materials") {
+    section_ = name;
+    return true;
+  }
+
+  if (section_ == "define") {
+    if (name == "constant" || name == "variable") {
+      Precision value;
+      if (!Evaluate(Attribute(attributes, "value"), &value)) return false;
+      constants_[Attribute(attributes, "name")] = value;
+    } else if (name == "position") {
+      Vector3D<Precision> position;
+      if (!ReadVector(attributes, false, &position)) return false;
+      positions_[Attribute(attributes, "name")] = position;
+    } else if (name == "rotation") {
+      Vector3D<Precision> rotation;
+      if (!ReadVector(attributes, true, &rotation)) return false;
+      rotations_[Attribute(attributes, "name")] = rotation;
+    }
+    return true;
+  }
+
+  if (section_ == "solids") {
+    if (name != "box") {
+      std::cerr << "Unsupported GDML solid <" << name << ">.\n";
+      return false;
+    }
+    SolidRecord solid;
+    solid.name = Attribute(attributes, "name");
+    solid.type = kGdmlBox;
+    Vector3D<Precision> lengths;
+    if (!ReadVector(attributes, false, &lengths)) return false;
+    // GDML stores full lengths
+    for (int i = 0; i < 3; ++i) solid.parameters[i] = 0.5*lengths[i];
+    solid_names_[solid.name] = solids_.size();
+    solids_.push_back(solid);
+    return true;
+  }
+
+  if (section_ == "structure") {
+    if (name == "volume") {
+      VolumeRecord volume;
+      volume.name = Attribute(attributes, "name");
+      volume.solid = -1;
+      current_volume_ = volumes_.size();
+      volume_names_[volume.name] = current_volume_;
+      volumes_.push_back(volume);
+      return true;
+    }
+    if (current_volume_ < 0) return true;
+    VolumeRecord &volume = volumes_[current_volume_];
+    if (name == "solidref") {
+      std::map<std::string, int>::const_iterator solid =
+          solid_names_.find(Attribute(attributes, "ref"));
+      if (solid == solid_names_.end()) {
+        std::cerr << "Volume " << volume.name << " references unknown solid "
+                  << Attribute(attributes, "ref") << ".\n";
+        return false;
+      }
+      volume.solid = solid->second;
+    } else if (name == "physvol") {
+      PhysvolRecord physvol;
+      physvol.volume = -1;
+      volume.daughters.push_back(physvol);
+      current_physvol_ = &volume.daughters.back();
+    } else if (current_physvol_) {
+      if (name == "volumeref") {
+        std::map<std::string, int>::const_iterator daughter =
+            volume_names_.find(Attribute(attributes, "ref"));
+        if (daughter == volume_names_.end()) {
+          std::cerr << "Volume " << volume.name << " places undefined volume "
+                    << Attribute(attributes, "ref") << ".\n";
+          return false;
+        }
+        current_physvol_->volume = daughter->second;
+      } else if (name == "position") {
+        return ReadVector(attributes, false, &current_physvol_->position);
+      } else if (name == "rotation") {
+        return ReadVector(attributes, true, &current_physvol_->rotation);
+      } else if (name == "positionref" || name == "rotationref") {
+        std::map<std::string, Vector3D<Precision> > const &references =
+            (name == "positionref") ? positions_ : rotations_;
+        std::map<std::string, Vector3D<Precision> >::const_iterator vector =
+            references.find(Attribute(attributes, "ref"));
+        if (vector == references.end()) {
+          std::cerr << "Unknown " << name << " "
+                    << Attribute(attributes, "ref") << ".\n";
+          return false;
+        }
+        if (name == "positionref") {
+          current_physvol_->position = vector->second;
+        } else {
+          current_physvol_->rotation = vector->second;
+        }
+      }
+    }
+    return true;
+  }
+
+  if (section_ == "setup" && name == "world") {
+    world_name_ = Attribute(attributes, "ref");
+  }
+
+  return true;
+}
+
+bool GdmlImporter::EndElement(std::string const &name) {
+  if (name == section_) {
+    section_.clear();
+  } else if (name == "volume") {
+    current_volume_ = -1;
+    current_physvol_ = NULL;
+  } else if (name == "physvol") {
+    if (current_physvol_ && current_physvol_->volume < 0) {
+      std::cerr << "Physvol without volumeref.\n";
+      return false;
+    }
+    current_physvol_ = NULL;
+  }
+  return true;
+}
+
+bool GdmlImporter::Construct() {
+
+  std::map<std::string, int>::const_iterator world =
+      volume_names_.find(world_name_);
+  if (world == volume_names_.end()) {
+    std::cerr << "GDML file does not specify a valid world volume.\n";
+    return false;
+  }
+  for (unsigned i = 0; i < volumes_.size(); ++i) {
+    if (volumes_[i].solid < 0) {
+      std::cerr << "Volume " << volumes_[i].name << " has no solid.\n";
+      return false;
+    }
+  }
+
+  // Deduplicate solids and matrices by their parameters
+
+  std::map<SolidKey, int> unique_solids;
+  std::vector<int> solid_index(solids_.size());
+  std::vector<SolidRecord const*> solid_records;
+  for (unsigned i = 0; i < solids_.size(); ++i) {
+    SolidKey key;
+    key.type = solids_[i].type;
+    for (int j = 0; j < 3; ++j) key.parameters[j] = solids_[i].parameters[j];
+    std::map<SolidKey, int>::const_iterator found = unique_solids.find(key);
+    if (found == unique_solids.end()) {
+      solid_index[i] = solid_records.size();
+      unique_solids[key] = solid_records.size();
+      solid_records.push_back(&solids_[i]);
+    } else {
+      solid_index[i] = found->second;
+    }
+  }
+
+  std::map<MatrixKey, int> unique_matrices;
+  std::vector<std::vector<int> > matrix_index(volumes_.size());
+  std::vector<PhysvolRecord const*> matrix_records;
+  for (unsigned i = 0; i < volumes_.size(); ++i) {
+    std::vector<PhysvolRecord> const &daughters = volumes_[i].daughters;
+    matrix_index[i].resize(daughters.size());
+    for (unsigned j = 0; j < daughters.size(); ++j) {
+      MatrixKey key;
+      for (int k = 0; k < 3; ++k) {
+        key.values[k] = daughters[j].position[k];
+        key.values[3+k] = daughters[j].rotation[k];
+      }
+      std::map<MatrixKey, int>::const_iterator found =
+          unique_matrices.find(key);
+      if (found == unique_matrices.end()) {
+        matrix_index[i][j] = matrix_records.size();
+        unique_matrices[key] = matrix_records.size();
+        matrix_records.push_back(&daughters[j]);
+      } else {
+        matrix_index[i][j] = found->second;
+      }
+    }
+  }
+
+  if (verbose_ > 0) {
+    std::cerr << "Constructing " << solid_records.size() << " unique solids "
+              << "and " << matrix_records.size() << " unique matrices on "
+              << threads_ << " threads.\n";
+  }
+
+  // Construct unique objects in parallel
+
+  unplaced_.resize(solid_records.size());
+  ParallelFor(solid_records.size(), threads_, [&](const int i) {
+    unplaced_[i] = new UnplacedBox(solid_records[i]->parameters[0],
+                                   solid_records[i]->parameters[1],
+                                   solid_records[i]->parameters[2]);
+  });
+
+  matrices_.resize(matrix_records.size());
+  ParallelFor(matrix_records.size(), threads_, [&](const int i) {
+    TransformationMatrix *const matrix = new TransformationMatrix();
+    matrix->SetTranslation(matrix_records[i]->position);
+    SetGdmlRotation(matrix_records[i]->rotation, matrix);
+    matrices_[i] = matrix;
+  });
+
+  logical_.resize(volumes_.size());
+  ParallelFor(volumes_.size(), threads_, [&](const int i) {
+    logical_[i] = new LogicalVolume(unplaced_[solid_index[volumes_[i].solid]]);
+  });
+
+  // Each volume only modifies its own daughter list, so volumes can be
+  // filled concurrently.
+  ParallelFor(volumes_.size(), threads_, [&](const int i) {
+    std::vector<PhysvolRecord> const &daughters = volumes_[i].daughters;
+    const int count = daughters.size();
+    if (!count) return;
+    std::vector<LogicalVolume const*> volumes(count);
+    std::vector<TransformationMatrix const*> matrices(count);
+    for (int j = 0; j < count; ++j) {
+      volumes[j] = logical_[daughters[j].volume];
+      matrices[j] = matrices_[matrix_index[i][j]];
+    }
+    logical_[i]->PlaceDaughters(&volumes[0], &matrices[0], count);
+  });
+
+  world_ = logical_[world->second];
+  return true;
+}
+
+} // End namespace vecgeom
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+#include "base/vector.h"
+#include "management/geo_manager.h"
+#include "management/isa_dispatch.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+namespace {
+
+/**
+ * Staged volumes are identified by the id stored next to them, as a volume
+ * may be deleted before the buffers are merged.
+ */
+typedef std::pair<int, VPlacedVolume const*> Registration;
+
+struct Placement {
+  LogicalVolume *mother;
+  VPlacedVolume const *daughter;
+  int id;
+};
+
+struct StagingBuffer {
+  std::vector<Registration> registered;
+  std::vector<Placement> placements;
+  // Ids of staged volumes deleted by this thread
+  std::vector<int> deregistered;
+};
+
+std::atomic<int> volume_counter(0);
+
+// Guards creation of staging buffers and all merging
+std::mutex staging_mutex;
+std::list<StagingBuffer> staging_buffers;
+
+thread_local StagingBuffer *thread_buffer = NULL;
+
+/**
+ * Retrieves the staging buffer of the calling thread. Only the first call
+ * from each thread needs to take the lock.
+ */
+StagingBuffer& ThreadBuffer() {
+  if (!thread_buffer) {
+    std::lock_guard<std::mutex> lock(staging_mutex);
+    staging_buffers.push_back(StagingBuffer());
+    thread_buffer = &staging_buffers.back();
+  }
+  return *thread_buffer;
+}
+
+bool CompareDaughterId(Placement const &a, Placement const &b) {
+  return a.id < b.id;
+}
+
+} // End anonymous namespace
+
+int GeoManager::volume_count() const {
+  return volume_counter.load();
+}
+
+std::vector<VPlacedVolume const*> const& GeoManager::volumes() {
+  MergeStagingBuffers();
+  return volumes_;
+}
+
+int GeoManager::RegisterVolume(VPlacedVolume const *const volume) {
+  const int id = volume_counter.fetch_add(1);
+  ThreadBuffer().registered.push_back(Registration(id, volume));
+  return id;
+}
+
+void GeoManager::DeregisterVolume(VPlacedVolume const *const volume) {
+  const int id = volume->id();
+  if (id < static_cast<int>(volumes_.size())) {
+    volumes_[id] = NULL;
+  } else {
+    ThreadBuffer().deregistered.push_back(id);
+  }
+}
+
+void GeoManager::StagePlacement(LogicalVolume *const mother,
+                                VPlacedVolume const *const daughter) {
+  Placement placement;
+  placement.mother = mother;
+  placement.daughter = daughter;
+  placement.id = daughter->id();
+  ThreadBuffer().placements.push_back(placement);
+}
+
+FlattenedOrigin const* GeoManager::Origin(
+    VPlacedVolume const *const volume) const {
+  std::map<int, FlattenedOrigin>::const_iterator i =
+      origins_.find(volume->id());
+  return (i != origins_.end()) ? &i->second : NULL;
+}
+
+void GeoManager::RecordOrigin(VPlacedVolume const *const volume,
+                              const int assembly, const int original) {
+  FlattenedOrigin &origin = origins_[volume->id()];
+  origin.assembly = assembly;
+  origin.original = original;
+}
+
+void GeoManager::MergeStagingBuffers() {
+
+  std::lock_guard<std::mutex> lock(staging_mutex);
+
+  volumes_.resize(volume_counter.load(), NULL);
+
+  // Volumes may be deleted by another thread than the one that created them,
+  // so deletions are collected from all buffers first. Pointers of deleted
+  // volumes are never dereferenced.
+  std::set<int> deregistered;
+  for (std::list<StagingBuffer>::iterator i = staging_buffers.begin();
+       i != staging_buffers.end(); ++i) {
+    deregistered.insert(i->deregistered.begin(), i->deregistered.end());
+    i->deregistered.clear();
+  }
+
+  std::vector<Placement> placements;
+  for (std::list<StagingBuffer>::iterator i = staging_buffers.begin();
+       i != staging_buffers.end(); ++i) {
+    for (unsigned j = 0; j < i->registered.size(); ++j) {
+      if (!deregistered.count(i->registered[j].first)) {
+        volumes_[i->registered[j].first] = i->registered[j].second;
+      }
+    }
+    for (unsigned j = 0; j < i->placements.size(); ++j) {
+      if (!deregistered.count(i->placements[j].id)) {
+        placements.push_back(i->placements[j]);
+      }
+    }
+    i->registered.clear();
+    i->placements.clear();
+  }
+
+  std::sort(placements.begin(), placements.end(), CompareDaughterId);
+  for (unsigned i = 0; i < placements.size(); ++i) {
+    placements[i].mother->AppendDaughter(placements[i].daughter);
+  }
+}
+
+std::set<LogicalVolume const*> GeoManager::PlacedLogicalVolumes() const {
+  std::set<LogicalVolume const*> logical_volumes;
+  for (unsigned i = 0; i < volumes_.size(); ++i) {
+    if (volumes_[i]) logical_volumes.insert(volumes_[i]->logical_volume());
+  }
+  return logical_volumes;
+}
+
+void GeoManager::CloseGeometry() {
+
+  MergeStagingBuffers();
+
+  if (flatten_assemblies_) {
+    const std::set<LogicalVolume const*> logical_volumes =
+        PlacedLogicalVolumes();
+    for (std::set<LogicalVolume const*>::const_iterator
+         i = logical_volumes.begin(); i != logical_volumes.end(); ++i) {
+      // Logical volumes are owned by the user and only reachable as const
+      // through their placements
+      const_cast<LogicalVolume*>(*i)->FlattenAssemblies(
+        max_flattened_daughters_
+      );
+    }
+    // Registers the daughters created by flattening
+    MergeStagingBuffers();
+  }
+
+  // Drops the origins of flattened daughters deleted since the last call
+  for (std::map<int, FlattenedOrigin>::iterator i = origins_.begin();
+       i != origins_.end();) {
+    if (volumes_[i->first]) {
+      ++i;
+    } else {
+      origins_.erase(i++);
+    }
+  }
+
+  const std::set<LogicalVolume const*> logical_volumes =
+      PlacedLogicalVolumes();
+  for (std::set<LogicalVolume const*>::const_iterator
+       i = logical_volumes.begin(); i != logical_volumes.end(); ++i) {
+    (*i)->BuildFaceNeighbors();
+  }
+
+  #ifdef VECGEOM_ISA_DISPATCH
+  IsaDispatch::Instance().Bind();
+  #endif
+}
+
+} // End namespace vecgeom
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include <stdlib.h>
+#include <iostream>
+#include "management/geometry_generator.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+#include "volumes/unplaced_box.h"
+
+namespace vecgeom {
+
+namespace {
+
+// Relative dimensions of each shape class
+const Precision kShapeFactors[kGeneratedShapeCount][3] = {
+  {1., 1., 1.},
+  {1., 1., 0.25},
+  {1., 0.25, 0.25}
+};
+
+// Fraction of a grid cell filled by a daughter, leaving a gap between
+// neighbours
+const Precision kFillFactor = 0.9;
+
+long CountTouchables(LogicalVolume const *const volume,
+                     std::map<LogicalVolume const*, long> &counts) {
+  std::map<LogicalVolume const*, long>::const_iterator found =
+      counts.find(volume);
+  if (found != counts.end()) return found->second;
+  long count = 1;
+  for (Iterator<Daughter> i = volume->daughters().begin();
+       i != volume->daughters().end(); ++i) {
+    count += CountTouchables((*i)->logical_volume(), counts);
+  }
+  counts[volume] = count;
+  return count;
+}
+
+} // End anonymous namespace
+
+GeometryGenerator::GeometryGenerator()
+    : depth_(3), daughters_(8), rotation_fraction_(0), world_size_(1000.),
+      seed_(1), random_state_(1), world_logical_(NULL), world_(NULL) {
+  shape_mix_[kGeneratedCube] = 1.;
+  shape_mix_[kGeneratedSlab] = 0.;
+  shape_mix_[kGeneratedBar] = 0.;
+}
+
+GeometryGenerator::~GeometryGenerator() {
+  Clear();
+}
+
+void GeometryGenerator::Clear() {
+  delete world_;
+  // Logical volumes delete their placed daughters
+  for (unsigned i = 0; i < logical_.size(); ++i) delete logical_[i];
+  for (unsigned i = 0; i < unplaced_.size(); ++i) delete unplaced_[i];
+  for (unsigned i = 0; i < matrices_.size(); ++i) delete matrices_[i];
+  logical_.clear();
+  unplaced_.clear();
+  matrices_.clear();
+  logical_cache_.clear();
+  world_logical_ = NULL;
+  world_ = NULL;
+}
+
+Precision GeometryGenerator::RandomUniform() {
+  return static_cast<Precision>(rand_r(&random_state_)) / RAND_MAX;
+}
+
+GeneratedShape GeometryGenerator::RandomShape() {
+  Precision total = 0;
+  for (int i = 0; i < kGeneratedShapeCount; ++i) total += shape_mix_[i];
+  Precision pick = RandomUniform() * total;
+  for (int i = 0; i < kGeneratedShapeCount - 1; ++i) {
+    if (pick < shape_mix_[i]) return static_cast<GeneratedShape>(i);
+    pick -= shape_mix_[i];
+  }
+  return static_cast<GeneratedShape>(kGeneratedShapeCount - 1);
+}
+
+VPlacedVolume const* GeometryGenerator::Generate() {
+
+  Clear();
+
+  Precision total = 0;
+  for (int i = 0; i < kGeneratedShapeCount; ++i) {
+    if (shape_mix_[i] < 0) {
+      std::cerr << "Shape mix weights must be non-negative.\n";
+      return NULL;
+    }
+    total += shape_mix_[i];
+  }
+  if (depth_ < 0 || daughters_ < 0 || total <= 0 || world_size_ <= 0 ||
+      rotation_fraction_ < 0 || rotation_fraction_ > 1) {
+    std::cerr << "Invalid parameters for geometry generation.\n";
+    return NULL;
+  }
+
+  random_state_ = seed_;
+  world_logical_ = GenerateVolume(
+    Vector3D<Precision>(world_size_, world_size_, world_size_), 0
+  );
+  TransformationMatrix *const identity = new TransformationMatrix();
+  matrices_.push_back(identity);
+  world_ = world_logical_->unplaced_volume()->PlaceVolume(world_logical_,
+                                                          identity);
+  return world_;
+}
+
+LogicalVolume* GeometryGenerator::GenerateVolume(
+    Vector3D<Precision> const &dimensions, const int level) {
+
+  std::vector<Precision> key(4);
+  key[0] = dimensions[0];
+  key[1] = dimensions[1];
+  key[2] = dimensions[2];
+  key[3] = level;
+  std::map<std::vector<Precision>, LogicalVolume*>::const_iterator found =
+      logical_cache_.find(key);
+  if (found != logical_cache_.end()) return found->second;
+
+  UnplacedBox *const unplaced =
+      new UnplacedBox(dimensions[0], dimensions[1], dimensions[2]);
+  LogicalVolume *const logical = new LogicalVolume(unplaced);
+  unplaced_.push_back(unplaced);
+  logical_.push_back(logical);
+  logical_cache_[key] = logical;
+
+  if (level >= depth_ || daughters_ == 0) return logical;
+
+  // Smallest grid with enough cells for all daughters
+  int grid = 1;
+  while (grid*grid*grid < daughters_) ++grid;
+  const Vector3D<Precision> cell = dimensions / grid;
+  const Precision cell_size = cell.Min();
+
+  std::vector<LogicalVolume const*> volumes(daughters_);
+  std::vector<TransformationMatrix const*> matrices(daughters_);
+  for (int n = 0; n < daughters_; ++n) {
+    const int index[3] = {n % grid, (n / grid) % grid, n / (grid*grid)};
+    Vector3D<Precision> center;
+    for (int i = 0; i < 3; ++i) {
+      center[i] = -dimensions[i] + cell[i]*(2*index[i] + 1);
+    }
+    const GeneratedShape shape = RandomShape();
+    const bool rotated = RandomUniform() < rotation_fraction_;
+    Vector3D<Precision> daughter(kShapeFactors[shape][0],
+                                 kShapeFactors[shape][1],
+                                 kShapeFactors[shape][2]);
+    // Rotated daughters must fit the cell in any orientation
+    daughter *= kFillFactor*cell_size;
+    if (rotated) daughter /= daughter.Length() / (kFillFactor*cell_size);
+    volumes[n] = GenerateVolume(daughter, level + 1);
+    TransformationMatrix *const matrix = (rotated)
+        ? new TransformationMatrix(center[0], center[1], center[2],
+                                   360.*RandomUniform(), 180.*RandomUniform(),
+                                   360.*RandomUniform())
+        : new TransformationMatrix(center[0], center[1], center[2]);
+    matrices_.push_back(matrix);
+    matrices[n] = matrix;
+  }
+  logical->PlaceDaughters(&volumes[0], &matrices[0], daughters_);
+
+  return logical;
+}
+
+long GeometryGenerator::TouchableCount() const {
+  if (!world_logical_) return 0;
+  std::map<LogicalVolume const*, long> counts;
+  return CountTouchables(world_logical_, counts);
+}
+
+} // End namespace vecgeom
\ No newline at end of file
@@ -0,0 +1,795 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <iostream>
+#include <map>
+#include <new>
+#include <vector>
+#include "base/array.h"
+#include "management/geometry_image.h"
+#include "navigation/daughter_bounds.h"
+#include "navigation/face_neighbors.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_box.h"
+#include "volumes/placed_volume.h"
+#include "volumes/unplaced_box.h"
+
+namespace vecgeom {
+
+namespace {
+
+struct UnplacedRecord {
+  uint32_t type;
+  uint32_t parameter_count;
+  Precision parameters[3];
+};
+
+struct MatrixRecord {
+  Precision translation[3];
+  Precision rotation[9];
+};
+
+struct LogicalRecord {
+  uint64_t unplaced;
+  uint64_t daughters;
+  uint64_t daughter_count;
+  // Zero unless the daughter is the placement shared by replica copies
+  uint64_t replica;
+};
+
+struct PlacedRecord {
+  uint64_t logical;
+  uint64_t matrix;
+};
+
+struct ReplicaRecord {
+  uint32_t axis;
+  uint32_t copies;
+  Precision pitch;
+  Precision offset;
+  Precision dimensions[3];
+  uint64_t cell;
+};
+
+uint64_t AlignedSize(const uint64_t size) {
+  return kAlignmentBoundary * ((size + kAlignmentBoundary - 1)
+                               / kAlignmentBoundary);
+}
+
+uint64_t Stride(const uint64_t record_size, const uint64_t object_size) {
+  return AlignedSize((record_size > object_size) ? record_size : object_size);
+}
+
+/**
+ * The daughter container of a logical volume is constructed directly after
+ * the logical volume itself in the same image entry.
+ */
+uint64_t LogicalStride() {
+  return Stride(sizeof(LogicalRecord),
+                AlignedSize(sizeof(LogicalVolume)) + sizeof(Array<Daughter>));
+}
+
+/**
+ * \return Whether an offset refers to the start of an entry of a section.
+ */
+bool IsEntry(ImageSection const &section, const uint64_t offset) {
+  return offset >= section.offset &&
+         (offset - section.offset) % section.stride == 0 &&
+         (offset - section.offset) / section.stride < section.count;
+}
+
+/**
+ * \return Whether the image was written by a build with the same layout of
+ *         the types constructed in it.
+ */
+bool Compatible(ImageHeader const *const header) {
+  return header->precision_size == sizeof(Precision) &&
+         header->pointer_size == sizeof(void*) &&
+         header->pointer_size == sizeof(uint64_t) &&
+         header->logical_size == sizeof(LogicalVolume) &&
+         header->matrix_size == sizeof(TransformationMatrix);
+}
+
+/**
+ * Copies the virtual table pointer of an object of this process over that of
+ * an object of the same dynamic type constructed by another process. The
+ * pointer is the first word of every polymorphic object without
+ * non-polymorphic bases, as for all objects stored in an image.
+ */
+template <typename Type>
+void CopyVirtualTable(Type const &reference, void *const object) {
+  memcpy(object, &reference, sizeof(void*));
+}
+
+template <typename Type>
+uint64_t Lookup(std::map<Type const*, uint64_t> const &indices,
+                Type const *const key) {
+  return indices.find(key)->second;
+}
+
+/**
+ * Collects all unique objects of a geometry in depth first order, so objects
+ * that are accessed together during navigation end up close in the image.
+ */
+struct ImageContent {
+
+  std::vector<VUnplacedVolume const*> unplaced;
+  std::vector<TransformationMatrix const*> matrices;
+  std::vector<LogicalVolume const*> logical;
+  std::vector<VPlacedVolume const*> placed;
+  std::vector<ReplicaPlacement const*> replicas;
+  std::map<VUnplacedVolume const*, uint64_t> unplaced_index;
+  std::map<TransformationMatrix const*, uint64_t> matrix_index;
+  std::map<LogicalVolume const*, uint64_t> logical_index;
+  std::map<VPlacedVolume const*, uint64_t> placed_index;
+  std::map<ReplicaPlacement const*, uint64_t> replica_index;
+  uint64_t daughter_count;
+
+  ImageContent() : daughter_count(0) {}
+
+  template <typename Type>
+  static void Insert(Type const *const object, std::vector<Type const*> *list,
+                     std::map<Type const*, uint64_t> *indices) {
+    if (indices->count(object)) return;
+    (*indices)[object] = list->size();
+    list->push_back(object);
+  }
+
+  void Scan(LogicalVolume const *const volume) {
+    if (logical_index.count(volume)) return;
+    Insert(volume, &logical, &logical_index);
+    Insert(volume->unplaced_volume(), &unplaced, &unplaced_index);
+    if (volume->replica()) {
+      Insert(volume->replica(), &replicas, &replica_index);
+    }
+    daughter_count += volume->daughters().size();
+    for (Iterator<Daughter> i = volume->daughters().begin();
+         i != volume->daughters().end(); ++i) {
+      Insert(*i, &placed, &placed_index);
+      Insert((*i)->matrix(), &matrices, &matrix_index);
+      Scan((*i)->logical_volume());
+    }
+  }
+
+};
+
+} // End anonymous namespace
+
+bool GeometryImage::Write(LogicalVolume const *const world,
+                          char const *const file_name) {
+
+  ImageContent content;
+  content.Scan(world);
+  // The copies of a parametrisation would otherwise be written as ordinary
+  // daughters, losing the lookup of the copy containing a point
+  for (unsigned i = 0; i < content.logical.size(); ++i) {
+    if (content.logical[i]->parametrisation()) {
+      std::cerr << "Parametrised placements are not supported by geometry "
+                   "images.\n";
+      return false;
+    }
+  }
+
+  // Compute layout
+
+  ImageHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.precision_size = sizeof(Precision);
+  header.pointer_size = sizeof(void*);
+  header.logical_size = sizeof(LogicalVolume);
+  header.matrix_size = sizeof(TransformationMatrix);
+
+  uint64_t unplaced_size = 0, placed_size = 0;
+  for (unsigned i = 0; i < content.unplaced.size(); ++i) {
+    if (static_cast<uint64_t>(content.unplaced[i]->memory_size())
+        > unplaced_size) {
+      unplaced_size = content.unplaced[i]->memory_size();
+    }
+  }
+  for (unsigned i = 0; i < content.placed.size(); ++i) {
+    if (static_cast<uint64_t>(content.placed[i]->memory_size())
+        > placed_size) {
+      placed_size = content.placed[i]->memory_size();
+    }
+  }
+
+  uint64_t offset = AlignedSize(sizeof(ImageHeader));
+  ImageSection *const sections[6] = {
+    &header.unplaced, &header.matrices, &header.logical, &header.placed,
+    &header.daughters, &header.replicas
+  };
+  const uint64_t counts[6] = {
+    content.unplaced.size(), content.matrices.size(), content.logical.size(),
+    content.placed.size(), content.daughter_count, content.replicas.size()
+  };
+  const uint64_t strides[6] = {
+    Stride(sizeof(UnplacedRecord), unplaced_size),
+    Stride(sizeof(MatrixRecord), sizeof(TransformationMatrix)),
+    LogicalStride(),
+    Stride(sizeof(PlacedRecord), placed_size),
+    sizeof(uint64_t),
+    Stride(sizeof(ReplicaRecord), sizeof(ReplicaPlacement))
+  };
+  for (int i = 0; i < 6; ++i) {
+    sections[i]->offset = offset;
+    sections[i]->count = counts[i];
+    sections[i]->stride = strides[i];
+    offset += AlignedSize(counts[i]*strides[i]);
+  }
+  header.size = offset;
+  header.world = header.logical.offset
+                 + Lookup(content.logical_index, world)*header.logical.stride;
+
+  // Fill records
+
+  std::vector<char> image(header.size, 0);
+  memcpy(&image[0], &header, sizeof(header));
+
+  for (unsigned i = 0; i < content.unplaced.size(); ++i) {
+    UnplacedBox const *const box =
+        dynamic_cast<UnplacedBox const*>(content.unplaced[i]);
+    if (!box) {
+      std::cerr << "Unsupported volume type for geometry image: "
+                << *content.unplaced[i] << std::endl;
+      return false;
+    }
+    UnplacedRecord record;
+    memset(&record, 0, sizeof(record));
+    record.type = kImageBox;
+    record.parameter_count = 3;
+    for (int j = 0; j < 3; ++j) record.parameters[j] = box->dimensions()[j];
+    memcpy(&image[header.unplaced.offset + i*header.unplaced.stride],
+           &record, sizeof(record));
+  }
+
+  for (unsigned i = 0; i < content.matrices.size(); ++i) {
+    MatrixRecord record;
+    for (int j = 0; j < 3; ++j) {
+      record.translation[j] = content.matrices[i]->Translation(j);
+    }
+    for (int j = 0; j < 9; ++j) {
+      record.rotation[j] = content.matrices[i]->Rotation(j);
+    }
+    memcpy(&image[header.matrices.offset + i*header.matrices.stride],
+           &record, sizeof(record));
+  }
+
+  uint64_t daughter_offset = header.daughters.offset;
+  for (unsigned i = 0; i < content.logical.size(); ++i) {
+    LogicalVolume const *const volume = content.logical[i];
+    LogicalRecord record;
+    record.unplaced = header.unplaced.offset
+        + Lookup(content.unplaced_index, volume->unplaced_volume())
+          *header.unplaced.stride;
+    record.daughter_count = volume->daughters().size();
+    record.daughters = (record.daughter_count) ? daughter_offset : 0;
+    record.replica = (volume->replica())
+        ? header.replicas.offset
+          + Lookup(content.replica_index, volume->replica())
+            *header.replicas.stride
+        : 0;
+    for (Iterator<Daughter> j = volume->daughters().begin();
+         j != volume->daughters().end(); ++j) {
+      const uint64_t placed = header.placed.offset
+          + Lookup(content.placed_index, *j)*header.placed.stride;
+      memcpy(&image[daughter_offset], &placed, sizeof(placed));
+      daughter_offset += header.daughters.stride;
+    }
+    memcpy(&image[header.logical.offset + i*header.logical.stride],
+           &record, sizeof(record));
+  }
+
+  for (unsigned i = 0; i < content.placed.size(); ++i) {
+    PlacedRecord record;
+    record.logical = header.logical.offset
+        + Lookup(content.logical_index, content.placed[i]->logical_volume())
+          *header.logical.stride;
+    record.matrix = header.matrices.offset
+        + Lookup(content.matrix_index, content.placed[i]->matrix())
+          *header.matrices.stride;
+    memcpy(&image[header.placed.offset + i*header.placed.stride],
+           &record, sizeof(record));
+  }
+
+  for (unsigned i = 0; i < content.replicas.size(); ++i) {
+    ReplicaPlacement const *const replica = content.replicas[i];
+    ReplicaRecord record;
+    memset(&record, 0, sizeof(record));
+    record.axis = replica->axis();
+    record.copies = replica->copies();
+    record.pitch = replica->pitch();
+    record.offset = replica->offset();
+    for (int j = 0; j < 3; ++j) record.dimensions[j] = replica->envelope()[j];
+    record.dimensions[replica->axis()] = 0.5*replica->pitch();
+    record.cell = header.placed.offset
+        + Lookup(content.placed_index, replica->cell())*header.placed.stride;
+    memcpy(&image[header.replicas.offset + i*header.replicas.stride],
+           &record, sizeof(record));
+  }
+
+  // Write to disk
+
+  FILE *const file = fopen(file_name, "wb");
+  if (!file) {
+    std::cerr << "Could not open " << file_name << " for writing.\n";
+    return false;
+  }
+  const size_t written = fwrite(&image[0], 1, image.size(), file);
+  fclose(file);
+  if (written != image.size()) {
+    std::cerr << "Failed to write geometry image to " << file_name << ".\n";
+    return false;
+  }
+  return true;
+}
+
+bool GeometryImage::Validate(ImageHeader const *const header,
+                             const size_t size) {
+  if (size < sizeof(ImageHeader) || header->magic != kMagic) {
+    std::cerr << "Not a geometry image.\n";
+    return false;
+  }
+  if (header->version != kVersion) {
+    std::cerr << "Unsupported geometry image version " << header->version
+              << " (expected " << kVersion << ").\n";
+    return false;
+  }
+  if (!Compatible(header)) {
+    std::cerr << "Geometry image was written by an incompatible build.\n";
+    return false;
+  }
+  if (header->size != size) {
+    std::cerr << "Geometry image is truncated or corrupt.\n";
+    return false;
+  }
+  ImageSection const *const sections[6] = {
+    &header->unplaced, &header->matrices, &header->logical, &header->placed,
+    &header->daughters, &header->replicas
+  };
+  // Every entry must hold its record as well as the object constructed in
+  // its place. All placed volumes are boxes, whose specializations share the
+  // layout of PlacedBox.
+  const uint64_t strides[6] = {
+    Stride(sizeof(UnplacedRecord), sizeof(UnplacedBox)),
+    Stride(sizeof(MatrixRecord), sizeof(TransformationMatrix)),
+    LogicalStride(),
+    Stride(sizeof(PlacedRecord), sizeof(PlacedBox)),
+    sizeof(Daughter),
+    Stride(sizeof(ReplicaRecord), sizeof(ReplicaPlacement))
+  };
+  for (int i = 0; i < 6; ++i) {
+    // Daughters are accessed as arrays, so their stride must match exactly
+    if (sections[i]->stride < strides[i] ||
+        (i == 4 && sections[i]->stride != strides[i]) ||
+        sections[i]->offset < sizeof(ImageHeader) ||
+        sections[i]->offset > size ||
+        sections[i]->count > (size - sections[i]->offset)
+                             / sections[i]->stride) {
+      std::cerr << "Geometry image is truncated or corrupt.\n";
+      return false;
+    }
+  }
+  // Objects are constructed over their records section by section, so
+  // sections must not overlap
+  for (int i = 0; i < 6; ++i) {
+    for (int j = i + 1; j < 6; ++j) {
+      if (sections[i]->count && sections[j]->count &&
+          sections[i]->offset < sections[j]->offset
+                                + sections[j]->count*sections[j]->stride &&
+          sections[j]->offset < sections[i]->offset
+                                + sections[i]->count*sections[i]->stride) {
+        std::cerr << "Geometry image is truncated or corrupt.\n";
+        return false;
+      }
+    }
+  }
+  if (!IsEntry(header->logical, header->world)) {
+    std::cerr << "Geometry image is truncated or corrupt.\n";
+    return false;
+  }
+
+  // Offsets stored in records must refer to entries of the right section, as
+  // objects are constructed from them without further checks
+
+  char const *const image = reinterpret_cast<char const*>(header);
+  for (uint64_t i = 0; i < header->unplaced.count; ++i) {
+    UnplacedRecord record;
+    memcpy(&record, image + header->unplaced.offset
+                    + i*header->unplaced.stride, sizeof(record));
+    if (record.type != kImageBox) {
+      std::cerr << "Unknown volume type " << record.type
+                << " in geometry image.\n";
+      return false;
+    }
+  }
+  for (uint64_t i = 0; i < header->daughters.count; ++i) {
+    uint64_t placed;
+    memcpy(&placed, image + header->daughters.offset
+                    + i*header->daughters.stride, sizeof(placed));
+    if (!IsEntry(header->placed, placed)) {
+      std::cerr << "Geometry image is truncated or corrupt.\n";
+      return false;
+    }
+  }
+  for (uint64_t i = 0; i < header->logical.count; ++i) {
+    LogicalRecord record;
+    memcpy(&record, image + header->logical.offset
+                    + i*header->logical.stride, sizeof(record));
+    if (!IsEntry(header->unplaced, record.unplaced) ||
+        (record.replica && !IsEntry(header->replicas, record.replica)) ||
+        (record.daughter_count &&
+         (!IsEntry(header->daughters, record.daughters) ||
+          record.daughter_count > header->daughters.count
+              - (record.daughters - header->daughters.offset)
+                / header->daughters.stride))) {
+      std::cerr << "Geometry image is truncated or corrupt.\n";
+      return false;
+    }
+  }
+  for (uint64_t i = 0; i < header->placed.count; ++i) {
+    PlacedRecord record;
+    memcpy(&record, image + header->placed.offset
+                    + i*header->placed.stride, sizeof(record));
+    if (!IsEntry(header->logical, record.logical) ||
+        !IsEntry(header->matrices, record.matrix)) {
+      std::cerr << "Geometry image is truncated or corrupt.\n";
+      return false;
+    }
+  }
+  for (uint64_t i = 0; i < header->replicas.count; ++i) {
+    ReplicaRecord record;
+    memcpy(&record, image + header->replicas.offset
+                    + i*header->replicas.stride, sizeof(record));
+    if (record.axis > kReplicaZ || record.copies < 1 ||
+        !(record.pitch > 0) || !IsEntry(header->placed, record.cell)) {
+      std::cerr << "Geometry image is truncated or corrupt.\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+LogicalVolume const* GeometryImage::Relocate(void *const base,
+                                             const size_t size) {
+
+  ImageHeader const *const header = static_cast<ImageHeader const*>(base);
+  if (!Validate(header, size)) return NULL;
+  char *const image = static_cast<char*>(base);
+
+  // Records are copied out of each entry before the object is constructed in
+  // its place. All records were validated, so nothing is written to a
+  // rejected image.
+
+  for (uint64_t i = 0; i < header->unplaced.count; ++i) {
+    char *const entry = image + header->unplaced.offset
+                        + i*header->unplaced.stride;
+    UnplacedRecord record;
+    memcpy(&record, entry, sizeof(record));
+    new(entry) UnplacedBox(record.parameters[0], record.parameters[1],
+                           record.parameters[2]);
+  }
+
+  for (uint64_t i = 0; i < header->matrices.count; ++i) {
+    char *const entry = image + header->matrices.offset
+                        + i*header->matrices.stride;
+    MatrixRecord record;
+    memcpy(&record, entry, sizeof(record));
+    TransformationMatrix *const matrix = new(entry) TransformationMatrix();
+    matrix->SetTranslation(record.translation[0], record.translation[1],
+                           record.translation[2]);
+    matrix->SetRotation(record.rotation[0], record.rotation[1],
+                        record.rotation[2], record.rotation[3],
+                        record.rotation[4], record.rotation[5],
+                        record.rotation[6], record.rotation[7],
+                        record.rotation[8]);
+  }
+
+  // Daughter offsets are converted to pointers in place
+  for (uint64_t i = 0; i < header->daughters.count; ++i) {
+    char *const entry = image + header->daughters.offset
+                        + i*header->daughters.stride;
+    uint64_t placed;
+    memcpy(&placed, entry, sizeof(placed));
+    const Daughter daughter = reinterpret_cast<Daughter>(image + placed);
+    memcpy(entry, &daughter, sizeof(daughter));
+  }
+
+  for (uint64_t i = 0; i < header->replicas.count; ++i) {
+    char *const entry = image + header->replicas.offset
+                        + i*header->replicas.stride;
+    ReplicaRecord record;
+    memcpy(&record, entry, sizeof(record));
+    ReplicaPlacement *const replica = new(entry) ReplicaPlacement(
+      Vector3D<Precision>(record.dimensions[0], record.dimensions[1],
+                          record.dimensions[2]),
+      static_cast<ReplicaAxis>(record.axis), record.copies, record.pitch,
+      record.offset
+    );
+    replica->set_cell(reinterpret_cast<VPlacedVolume const*>(image
+                                                             + record.cell));
+  }
+
+  for (uint64_t i = 0; i < header->logical.count; ++i) {
+    char *const entry = image + header->logical.offset
+                        + i*header->logical.stride;
+    LogicalRecord record;
+    memcpy(&record, entry, sizeof(record));
+    Daughter *const daughter_array = (record.daughter_count)
+        ? reinterpret_cast<Daughter*>(image + record.daughters) : NULL;
+    Array<Daughter> *const daughters =
+        new(entry + AlignedSize(sizeof(LogicalVolume)))
+        Array<Daughter>(daughter_array, record.daughter_count);
+    LogicalVolume *const volume = new(entry) LogicalVolume(
+      reinterpret_cast<VUnplacedVolume const*>(image + record.unplaced),
+      daughters
+    );
+    if (record.replica) {
+      volume->replica_ =
+          reinterpret_cast<ReplicaPlacement*>(image + record.replica);
+    }
+  }
+
+  for (uint64_t i = 0; i < header->placed.count; ++i) {
+    char *const entry = image + header->placed.offset
+                        + i*header->placed.stride;
+    PlacedRecord record;
+    memcpy(&record, entry, sizeof(record));
+    LogicalVolume const *const logical =
+        reinterpret_cast<LogicalVolume const*>(image + record.logical);
+    TransformationMatrix const *const matrix =
+        reinterpret_cast<TransformationMatrix const*>(image + record.matrix);
+    logical->unplaced_volume()->PlaceVolume(
+      logical, matrix, reinterpret_cast<VPlacedVolume*>(entry)
+    );
+  }
+
+  return reinterpret_cast<LogicalVolume const*>(image + header->world);
+}
+
+LogicalVolume const* GeometryImage::Load(char const *const file_name) {
+
+  Unmap();
+
+  const int file = open(file_name, O_RDONLY);
+  if (file < 0) {
+    std::cerr << "Could not open geometry image " << file_name << ".\n";
+    return NULL;
+  }
+  struct stat status;
+  if (fstat(file, &status) != 0) {
+    close(file);
+    return NULL;
+  }
+
+  // Private writable mapping, so objects can be constructed in place without
+  // modifying the file.
+  void *const base = mmap(NULL, status.st_size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE, file, 0);
+  close(file);
+  if (base == MAP_FAILED) {
+    std::cerr << "Could not map geometry image " << file_name << ".\n";
+    return NULL;
+  }
+  base_ = base;
+  size_ = status.st_size;
+
+  world_ = Relocate(base_, size_);
+  if (!world_) {
+    Unmap();
+    return NULL;
+  }
+  BuildAcceleration(static_cast<char*>(base_));
+  return world_;
+}
+
+namespace {
+
+const uint32_t kSharedMagic = 0x53474556; // "VEGS"
+
+uint64_t PageAlignedSize(const uint64_t size) {
+  const uint64_t page = sysconf(_SC_PAGESIZE);
+  return page * ((size + page - 1) / page);
+}
+
+} // End anonymous namespace
+
+LogicalVolume const* GeometryImage::CreateShared(
+    char const *const file_name, char const *const segment_name) {
+
+  Unmap();
+
+  const int file = open(file_name, O_RDONLY);
+  if (file < 0) {
+    std::cerr << "Could not open geometry image " << file_name << ".\n";
+    return NULL;
+  }
+  struct stat status;
+  if (fstat(file, &status) != 0) {
+    close(file);
+    return NULL;
+  }
+
+  const int segment = shm_open(segment_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (segment < 0) {
+    std::cerr << "Could not create shared segment " << segment_name << ".\n";
+    close(file);
+    return NULL;
+  }
+  const uint64_t image_offset = PageAlignedSize(sizeof(SharedImageHeader));
+  const uint64_t total_size = image_offset + status.st_size;
+  void *base = MAP_FAILED;
+  if (ftruncate(segment, total_size) == 0) {
+    base = mmap(NULL, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, segment,
+                0);
+  }
+  close(segment);
+  if (base == MAP_FAILED) {
+    std::cerr << "Could not map shared segment " << segment_name << ".\n";
+    close(file);
+    shm_unlink(segment_name);
+    return NULL;
+  }
+  base_ = base;
+  size_ = total_size;
+
+  // Read the image directly into the segment
+  char *const image = static_cast<char*>(base) + image_offset;
+  uint64_t bytes_read = 0;
+  while (bytes_read < static_cast<uint64_t>(status.st_size)) {
+    const ssize_t result = read(file, image + bytes_read,
+                                status.st_size - bytes_read);
+    if (result <= 0) break;
+    bytes_read += result;
+  }
+  close(file);
+
+  if (bytes_read == static_cast<uint64_t>(status.st_size)) {
+    world_ = Relocate(image, status.st_size);
+  }
+  if (!world_) {
+    Unmap();
+    shm_unlink(segment_name);
+    return NULL;
+  }
+
+  // Attaching processes replace these pointers to the heap of this process
+  // in their private mapping
+  BuildAcceleration(image);
+
+  SharedImageHeader *const header = static_cast<SharedImageHeader*>(base);
+  header->magic = kSharedMagic;
+  header->version = kVersion;
+  header->address = reinterpret_cast<uint64_t>(base);
+  header->image_offset = image_offset;
+  header->image_size = status.st_size;
+
+  // The geometry is now final, so protect it from accidental modification
+  mprotect(base, total_size, PROT_READ);
+
+  return world_;
+}
+
+LogicalVolume const* GeometryImage::AttachShared(
+    char const *const segment_name) {
+
+  Unmap();
+
+  const int segment = shm_open(segment_name, O_RDONLY, 0);
+  if (segment < 0) {
+    std::cerr << "Could not open shared segment " << segment_name << ".\n";
+    return NULL;
+  }
+  SharedImageHeader header;
+  if (pread(segment, &header, sizeof(header), 0)
+      != static_cast<ssize_t>(sizeof(header)) ||
+      header.magic != kSharedMagic || header.version != kVersion) {
+    std::cerr << "Shared segment " << segment_name
+              << " does not contain a geometry.\n";
+    close(segment);
+    return NULL;
+  }
+
+  // Pointers between objects are only valid at the original address, but the
+  // mapping is private, so the virtual table pointers of this process can be
+  // written over those of the creating process. Only the pages holding
+  // polymorphic objects are copied.
+  const uint64_t total_size = header.image_offset + header.image_size;
+  void *const requested = reinterpret_cast<void*>(header.address);
+  void *const base = mmap(requested, total_size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE, segment, 0);
+  close(segment);
+  if (base == MAP_FAILED) {
+    std::cerr << "Could not map shared segment " << segment_name << ".\n";
+    return NULL;
+  }
+  base_ = base;
+  size_ = total_size;
+  if (base != requested) {
+    std::cerr << "Could not map shared segment " << segment_name
+              << " at its original address.\n";
+    Unmap();
+    return NULL;
+  }
+
+  char *const image = static_cast<char*>(base) + header.image_offset;
+  ImageHeader const *const image_header =
+      reinterpret_cast<ImageHeader const*>(image);
+  if (!Compatible(image_header)) {
+    std::cerr << "Shared segment " << segment_name
+              << " was created by an incompatible build.\n";
+    Unmap();
+    return NULL;
+  }
+  world_ = FixVirtualTables(image);
+  BuildAcceleration(image);
+  mprotect(base, total_size, PROT_READ);
+  return world_;
+}
+
+LogicalVolume const* GeometryImage::FixVirtualTables(char *const image) {
+  ImageHeader const *const header =
+      reinterpret_cast<ImageHeader const*>(image);
+  // All unplaced volumes are boxes, and all daughter lists are arrays
+  const UnplacedBox box(0, 0, 0);
+  for (uint64_t i = 0; i < header->unplaced.count; ++i) {
+    CopyVirtualTable(box, image + header->unplaced.offset
+                          + i*header->unplaced.stride);
+  }
+  const Array<Daughter> daughters(NULL, 0);
+  for (uint64_t i = 0; i < header->logical.count; ++i) {
+    CopyVirtualTable(daughters, image + header->logical.offset
+                                + i*header->logical.stride
+                                + AlignedSize(sizeof(LogicalVolume)));
+  }
+  // Placed volumes are constructed again by the factory, which picks the
+  // specialization for their matrix and registers them with the GeoManager
+  // of this process
+  for (uint64_t i = 0; i < header->placed.count; ++i) {
+    VPlacedVolume *const placed = reinterpret_cast<VPlacedVolume*>(
+      image + header->placed.offset + i*header->placed.stride
+    );
+    LogicalVolume const *const logical = placed->logical_volume();
+    TransformationMatrix const *const matrix = placed->matrix();
+    logical->unplaced_volume()->PlaceVolume(logical, matrix, placed);
+  }
+  return reinterpret_cast<LogicalVolume const*>(image + header->world);
+}
+
+void GeometryImage::BuildAcceleration(char *const image) {
+  ImageHeader const *const header =
+      reinterpret_cast<ImageHeader const*>(image);
+  for (uint64_t i = 0; i < header->logical.count; ++i) {
+    LogicalVolume *const volume = reinterpret_cast<LogicalVolume*>(
+      image + header->logical.offset + i*header->logical.stride
+    );
+    bounds_.push_back(new DaughterBounds);
+    neighbors_.push_back(new FaceNeighbors);
+    volume->BuildAcceleration(bounds_.back(), neighbors_.back());
+  }
+}
+
+bool GeometryImage::RemoveShared(char const *const segment_name) {
+  return shm_unlink(segment_name) == 0;
+}
+
+void GeometryImage::Unmap() {
+  if (base_) munmap(base_, size_);
+  for (unsigned i = 0; i < bounds_.size(); ++i) delete bounds_[i];
+  for (unsigned i = 0; i < neighbors_.size(); ++i) delete neighbors_[i];
+  bounds_.clear();
+  neighbors_.clear();
+  base_ = NULL;
+  size_ = 0;
+  world_ = NULL;
+}
+
+GeometryImage::~GeometryImage() {
+  Unmap();
+}
+
+} // End namespace vecgeom
\ No newline at end of file
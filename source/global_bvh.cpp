@@ -0,0 +1,276 @@
+#include "navigation/global_bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+const long GlobalBvh::kDefaultMaxTouchables;
+const int GlobalBvh::kLeafSize;
+const int GlobalBvh::kMaxLevel;
+
+namespace {
+
+/**
+ * Bounds the nodes pending during a query. Median splits keep the tree
+ * balanced, so its depth, which bounds the pending nodes, is logarithmic.
+ */
+const int kStackSize = 64;
+
+/**
+ * Bounds the candidates collected before their exact tests. Candidates beyond
+ * it are tested early, which only costs tests that ordering would have saved.
+ */
+const int kMaxCandidates = 64;
+
+} // End anonymous namespace
+
+class GlobalBvh::CompareCenter {
+
+private:
+
+  std::vector<Touchable> const &touchables_;
+  int axis_;
+
+public:
+
+  CompareCenter(std::vector<Touchable> const &touchables, const int axis)
+      : touchables_(touchables), axis_(axis) {}
+
+  // Compares the sums of the bounds, which order boxes as their centers
+  bool operator()(const int a, const int b) const {
+    return touchables_[a].lower[axis_] + touchables_[a].upper[axis_] <
+           touchables_[b].lower[axis_] + touchables_[b].upper[axis_];
+  }
+
+};
+
+GlobalBvh::GlobalBvh(VPlacedVolume const *const world,
+                     const long max_touchables)
+    : world_(world), max_level_(1) {
+  Touchable root;
+  root.volume = world;
+  root.parent = -1;
+  root.level = 1;
+  root.copy = -1;
+  touchables_.push_back(root);
+  SetBounds(0);
+  if (!AddDaughters(0, max_touchables)) {
+    std::cerr << "Geometry exceeds " << max_touchables
+              << " touchable volumes or " << kMaxLevel
+              << " levels and is not indexed.\n";
+    std::vector<Touchable>().swap(touchables_);
+    max_level_ = 0;
+    return;
+  }
+  // The world is tested only when no daughter contains the point, as its
+  // bounds would enclose every node
+  order_.resize(touchables_.size() - 1);
+  for (unsigned i = 0; i < order_.size(); ++i) order_[i] = i + 1;
+  nodes_.reserve(2*(touchables_.size()/kLeafSize + 1));
+  nodes_.resize(1);
+  BuildNode(0, 0, order_.size());
+}
+
+bool GlobalBvh::AddDaughters(const int parent, const long max_touchables) {
+  // Daughters are given in the frame of the parent volume
+  TransformationMatrix to_mother(touchables_[parent].to_placement);
+  to_mother.MultiplyFromRight(*touchables_[parent].volume->matrix());
+  const int level = touchables_[parent].level + 1;
+  if (level > max_level_) max_level_ = level;
+  LogicalVolume const *const logical =
+      touchables_[parent].volume->logical_volume();
+  ReplicaPlacement const *const replica = logical->replica();
+  const int copies = (replica) ? replica->copies() : 1;
+  Container<Daughter> const &daughters = logical->daughters();
+  for (Iterator<Daughter> i = daughters.begin(); i != daughters.end(); ++i) {
+    for (int copy = 0; copy < copies; ++copy) {
+      if (static_cast<long>(touchables_.size()) >= max_touchables ||
+          level > kMaxLevel) {
+        return false;
+      }
+      Touchable touchable;
+      touchable.volume = *i;
+      touchable.parent = parent;
+      touchable.level = level;
+      touchable.copy = (replica) ? copy : -1;
+      touchable.to_placement = to_mother;
+      if (replica) {
+        touchable.to_placement.MultiplyFromRight(replica->Matrix(copy));
+      }
+      touchables_.push_back(touchable);
+      SetBounds(touchables_.size() - 1);
+      if (!AddDaughters(touchables_.size() - 1, max_touchables)) return false;
+    }
+  }
+  return true;
+}
+
+void GlobalBvh::SetBounds(const int index) {
+  Touchable &touchable = touchables_[index];
+  TransformationMatrix to_local(touchable.to_placement);
+  to_local.MultiplyFromRight(*touchable.volume->matrix());
+  const Vector3D<Precision> extent =
+      touchable.volume->logical_volume()->unplaced_volume()->BoundingExtent();
+  // The local origin maps to the translation, and each global half length is
+  // the projection of the rotated local box. Bounds are slightly enlarged so
+  // they stay conservative under rounding of the composed transformations.
+  for (int i = 0; i < 3; ++i) {
+    Precision half = 0;
+    for (int j = 0; j < 3; ++j) {
+      half += std::fabs(to_local.Rotation(3*i + j))*extent[j];
+    }
+    half = half*(1. + kGTolerance) + kGTolerance;
+    touchable.lower[i] = to_local.Translation(i) - half;
+    touchable.upper[i] = to_local.Translation(i) + half;
+  }
+}
+
+void GlobalBvh::BuildNode(const int node, const int begin, const int end) {
+  Precision lower[3], upper[3], center_lower[3], center_upper[3];
+  // Finite, since comparisons against infinity are not reliable with
+  // -ffast-math
+  const Precision huge = std::numeric_limits<Precision>::max();
+  for (int j = 0; j < 3; ++j) {
+    lower[j] = center_lower[j] = huge;
+    upper[j] = center_upper[j] = -huge;
+  }
+  for (int i = begin; i < end; ++i) {
+    Touchable const &touchable = touchables_[order_[i]];
+    for (int j = 0; j < 3; ++j) {
+      const Precision center = 0.5*(touchable.lower[j] + touchable.upper[j]);
+      lower[j] = std::min(lower[j], touchable.lower[j]);
+      upper[j] = std::max(upper[j], touchable.upper[j]);
+      center_lower[j] = std::min(center_lower[j], center);
+      center_upper[j] = std::max(center_upper[j], center);
+    }
+  }
+  for (int j = 0; j < 3; ++j) {
+    nodes_[node].lower[j] = lower[j];
+    nodes_[node].upper[j] = upper[j];
+  }
+  if (end - begin <= kLeafSize) {
+    nodes_[node].first = begin;
+    nodes_[node].count = end - begin;
+    return;
+  }
+  int axis = 0;
+  for (int j = 1; j < 3; ++j) {
+    if (center_upper[j] - center_lower[j] >
+        center_upper[axis] - center_lower[axis]) {
+      axis = j;
+    }
+  }
+  const int middle = begin + (end - begin) / 2;
+  std::nth_element(order_.begin() + begin, order_.begin() + middle,
+                   order_.begin() + end, CompareCenter(touchables_, axis));
+  const int children = nodes_.size();
+  nodes_.resize(children + 2);
+  nodes_[node].first = children;
+  nodes_[node].count = 0;
+  BuildNode(children, begin, middle);
+  BuildNode(children + 1, middle, end);
+}
+
+size_t GlobalBvh::memory_size() const {
+  return sizeof(*this) + touchables_.capacity()*sizeof(Touchable)
+         + order_.capacity()*sizeof(int) + nodes_.capacity()*sizeof(Node);
+}
+
+bool GlobalBvh::Precedes(const int a, const int b) const {
+  return touchables_[a].level > touchables_[b].level ||
+         (touchables_[a].level == touchables_[b].level && a < b);
+}
+
+int GlobalBvh::FirstContaining(Vector3D<Precision> const &point,
+                               int *const candidates, const int count) const {
+  // Sorted by insertion, as only a handful of bounding boxes contain a point
+  for (int i = 1; i < count; ++i) {
+    const int candidate = candidates[i];
+    int j = i;
+    for (; j > 0 && Precedes(candidate, candidates[j - 1]); --j) {
+      candidates[j] = candidates[j - 1];
+    }
+    candidates[j] = candidate;
+  }
+  for (int i = 0; i < count; ++i) {
+    Touchable const &touchable = touchables_[candidates[i]];
+    if (touchable.volume->Inside(
+          touchable.to_placement.Transform<1, 0>(point))) {
+      return candidates[i];
+    }
+  }
+  return -1;
+}
+
+VPlacedVolume const* GlobalBvh::LocatePoint(Vector3D<Precision> const &point,
+                                            Vector3D<Precision> &local_point,
+                                            NavigationState &state) const {
+  if (nodes_.empty()) return NULL;
+  int stack[kStackSize];
+  int stack_size = 0;
+  stack[stack_size++] = 0;
+  // Candidates are tested deepest first once collected, so the mothers of the
+  // located volume, whose bounds always contain the point, are not tested
+  int candidates[kMaxCandidates];
+  int count = 0;
+  int best = -1;
+  while (stack_size > 0) {
+    Node const &node = nodes_[stack[--stack_size]];
+    if (point[0] < node.lower[0] || point[0] > node.upper[0] ||
+        point[1] < node.lower[1] || point[1] > node.upper[1] ||
+        point[2] < node.lower[2] || point[2] > node.upper[2]) {
+      continue;
+    }
+    if (!node.count) {
+      stack[stack_size++] = node.first;
+      stack[stack_size++] = node.first + 1;
+      continue;
+    }
+    for (int i = node.first; i < node.first + node.count; ++i) {
+      const int index = order_[i];
+      Touchable const &touchable = touchables_[index];
+      // Only deeper touchables, or earlier ones at the same level as
+      // descending would find first, can replace the best one
+      if (best >= 0 && !Precedes(index, best)) continue;
+      if (point[0] < touchable.lower[0] || point[0] > touchable.upper[0] ||
+          point[1] < touchable.lower[1] || point[1] > touchable.upper[1] ||
+          point[2] < touchable.lower[2] || point[2] > touchable.upper[2]) {
+        continue;
+      }
+      if (count == kMaxCandidates) {
+        const int first = FirstContaining(point, candidates, count);
+        if (first >= 0) best = first;
+        count = 0;
+        if (best >= 0 && !Precedes(index, best)) continue;
+      }
+      candidates[count++] = index;
+    }
+  }
+  const int first = FirstContaining(point, candidates, count);
+  if (first >= 0) best = first;
+  if (best < 0) {
+    if (!world_->Inside(point)) return NULL;
+    best = 0;
+  }
+  Touchable const &located = touchables_[best];
+  VPlacedVolume const *path[kMaxLevel];
+  int copies[kMaxLevel];
+  for (int index = best; index >= 0; index = touchables_[index].parent) {
+    path[touchables_[index].level - 1] = touchables_[index].volume;
+    copies[touchables_[index].level - 1] = touchables_[index].copy;
+  }
+  for (int level = 0; level < located.level; ++level) {
+    state.Push(path[level], copies[level]);
+  }
+  local_point = located.volume->matrix()->Transform<1, 0>(
+    located.to_placement.Transform<1, 0>(point)
+  );
+  return located.volume;
+}
+
+} // End namespace vecgeom
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "navigation/global_transform_cache.h"
+
+#include <iostream>
+#include <map>
+#include "management/geo_manager.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+const long GlobalTransformCache::kDefaultMaxEntries;
+
+namespace {
+
+/**
+ * Counts touchable volumes per logical volume, visiting each logical volume
+ * once. The placement shared by the copies of a replica counts once per copy.
+ */
+long CountTouchables(LogicalVolume const *const volume,
+                     std::map<LogicalVolume const*, long> &counts) {
+  std::map<LogicalVolume const*, long>::const_iterator found =
+      counts.find(volume);
+  if (found != counts.end()) return found->second;
+  long count = 1;
+  const long copies = (volume->replica()) ? volume->replica()->copies() : 1;
+  Container<Daughter> const &daughters = volume->daughters();
+  for (Iterator<Daughter> i = daughters.begin(); i != daughters.end(); ++i) {
+    count += copies*CountTouchables((*i)->logical_volume(), counts);
+  }
+  counts[volume] = count;
+  return count;
+}
+
+/**
+ * Appends a matrix to the accumulated transformation local = A*(global - t),
+ * with the matrix applied as local[j] = sum_i master[i]*rot[3*i+j].
+ */
+void Accumulate(TransformationMatrix const &matrix, Precision *const a,
+                Precision *const t) {
+  // The translation of this level is given in the frame reached so far
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) t[i] += a[3*j+i]*matrix.Translation(j);
+  }
+  Precision product[9];
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      product[3*i+j] = 0;
+      for (int l = 0; l < 3; ++l) {
+        product[3*i+j] += matrix.Rotation(3*l+i)*a[3*l+j];
+      }
+    }
+  }
+  for (int i = 0; i < 9; ++i) a[i] = product[i];
+}
+
+} // End anonymous namespace
+
+GlobalTransformCache::GlobalTransformCache(VPlacedVolume const *const world,
+                                           const long max_entries)
+    : world_(world), touchable_count_(0),
+      offsets_(GeoManager::Instance().volume_count(), -1),
+      strides_(GeoManager::Instance().volume_count(), 0), filled_(0) {
+  std::map<LogicalVolume const*, long> counts;
+  touchable_count_ = CountTouchables(world->logical_volume(), counts);
+  if (touchable_count_ > max_entries) {
+    std::cerr << "Geometry has " << touchable_count_
+              << " touchable volumes, exceeding the maximum of "
+              << max_entries << " cached transformations.\n";
+    offsets_.assign(offsets_.size(), -1);
+    return;
+  }
+  // A placed volume has the same daughters wherever its mother is placed, so
+  // offsets only need to be assigned once per logical volume
+  offsets_[world->id()] = 0;
+  for (std::map<LogicalVolume const*, long>::const_iterator
+       i = counts.begin(); i != counts.end(); ++i) {
+    long offset = 1;
+    Container<Daughter> const &daughters = i->first->daughters();
+    for (Iterator<Daughter> d = daughters.begin(); d != daughters.end(); ++d) {
+      offsets_[(*d)->id()] = offset;
+      // Copies of a replica follow each other in the order of their index
+      if (i->first->replica()) {
+        strides_[(*d)->id()] = counts[(*d)->logical_volume()];
+      }
+      offset += counts[(*d)->logical_volume()];
+    }
+  }
+  std::vector<std::atomic<GlobalTransform const*> > entries(touchable_count_);
+  entries_.swap(entries);
+}
+
+GlobalTransformCache::~GlobalTransformCache() {
+  for (unsigned i = 0; i < entries_.size(); ++i) {
+    delete entries_[i].load(std::memory_order_relaxed);
+  }
+}
+
+long GlobalTransformCache::PathId(NavigationState const &state,
+                                  const int level) const {
+  if (level < 1 || entries_.empty() || state.At(0) != world_) return -1;
+  long id = 0;
+  for (int i = 1; i < level; ++i) {
+    const int volume = state.At(i)->id();
+    if (volume >= static_cast<int>(offsets_.size()) || offsets_[volume] < 0) {
+      return -1;
+    }
+    id += offsets_[volume];
+    if (state.CopyAt(i) > 0) id += state.CopyAt(i)*strides_[volume];
+  }
+  return id;
+}
+
+GlobalTransform const* GlobalTransformCache::Lookup(
+    NavigationState const &state, const int level) const {
+  const long id = PathId(state, level);
+  if (id < 0) return NULL;
+  std::atomic<GlobalTransform const*> &entry = entries_[id];
+  GlobalTransform const *transform = entry.load(std::memory_order_acquire);
+  if (transform) return transform;
+  GlobalTransform *const composed = Compose(state, level);
+  if (entry.compare_exchange_strong(transform, composed,
+                                    std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+    filled_.fetch_add(1, std::memory_order_relaxed);
+    return composed;
+  }
+  // Another thread published the same transformation first
+  delete composed;
+  return transform;
+}
+
+GlobalTransform* GlobalTransformCache::Compose(NavigationState const &state,
+                                               const int level) {
+  Precision a[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+  Precision t[3] = {0, 0, 0};
+  for (int k = 0; k < level; ++k) {
+    if (state.CopyAt(k) >= 0) {
+      Accumulate(
+        state.At(k-1)->logical_volume()->replica()->Matrix(state.CopyAt(k)),
+        a, t
+      );
+    }
+    Accumulate(*state.At(k)->matrix(), a, t);
+  }
+  GlobalTransform *const transform = new GlobalTransform;
+  transform->matrix.SetTranslation(t[0], t[1], t[2]);
+  transform->matrix.SetRotation(a[0], a[3], a[6], a[1], a[4], a[7],
+                                a[2], a[5], a[8]);
+  transform->trans_code = transform->matrix.GenerateTranslationCode();
+  transform->rot_code = transform->matrix.GenerateRotationCode();
+  return transform;
+}
+
+} // End namespace vecgeom
\ No newline at end of file
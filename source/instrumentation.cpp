@@ -0,0 +1,227 @@
+#include "base/instrumentation.h"
+
+#ifdef VECGEOM_INSTRUMENTATION
+
+#include <algorithm>
+#include <mutex>
+#include <string.h>
+#include "base/transformation_matrix.h"
+#include "management/geo_manager.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+char const *const Instrumentation::shape_labels[] = {
+  "Box"
+};
+
+char const *const Instrumentation::kernel_labels[] = {
+  "Inside",
+  "DistanceToIn",
+  "DistanceToOut",
+  "InsideBasket",
+  "DistanceToInBasket",
+  "DistanceToOutBasket",
+  "SafetyToIn",
+  "SafetyToOut"
+};
+
+namespace {
+
+void Accumulate(KernelCounter const &from, KernelCounter *const to) {
+  to->calls += from.calls;
+  to->points += from.points;
+  to->sampled_calls += from.sampled_calls;
+  to->sampled_ns += from.sampled_ns;
+}
+
+/**
+ * Estimated total time in seconds, extrapolated from the timed sample.
+ */
+double EstimatedTime(KernelCounter const &counter) {
+  if (!counter.sampled_calls) return 0;
+  return 1e-9 * counter.sampled_ns * counter.calls / counter.sampled_calls;
+}
+
+/**
+ * Threads currently holding counters, and the sum of counters of threads
+ * which have exited.
+ */
+struct Registry {
+  std::mutex mutex;
+  std::vector<ThreadCounters*> threads;
+  KernelCounter shapes[kInstrumentedShapeCount][kInstrumentedKernelCount];
+  std::vector<KernelCounter> volumes[kInstrumentedKernelCount];
+
+  Registry() {
+    memset(shapes, 0, sizeof(shapes));
+  }
+
+  static Registry& Instance() {
+    static Registry instance;
+    return instance;
+  }
+};
+
+void AccumulateVolumes(std::vector<KernelCounter> const &from,
+                       std::vector<KernelCounter> *const to) {
+  if (to->size() < from.size()) {
+    const KernelCounter zero = {0, 0, 0, 0};
+    to->resize(from.size(), zero);
+  }
+  for (unsigned i = 0; i < from.size(); ++i) Accumulate(from[i], &(*to)[i]);
+}
+
+struct VolumeTime {
+  int id;
+  double time;
+  bool operator<(VolumeTime const &other) const { return time > other.time; }
+};
+
+} // End anonymous namespace
+
+ThreadCounters& ThreadCounters::Instance() {
+  static thread_local ThreadCounters instance;
+  return instance;
+}
+
+ThreadCounters::ThreadCounters() : sample_clock(0) {
+  memset(shapes, 0, sizeof(shapes));
+  Registry &registry = Registry::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.threads.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+  Registry &registry = Registry::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (int s = 0; s < kInstrumentedShapeCount; ++s) {
+    for (int k = 0; k < kInstrumentedKernelCount; ++k) {
+      Accumulate(shapes[s][k], &registry.shapes[s][k]);
+    }
+  }
+  for (int k = 0; k < kInstrumentedKernelCount; ++k) {
+    AccumulateVolumes(volumes[k], &registry.volumes[k]);
+  }
+  registry.threads.erase(
+    std::find(registry.threads.begin(), registry.threads.end(), this)
+  );
+}
+
+void ThreadCounters::Reset() {
+  memset(shapes, 0, sizeof(shapes));
+  for (int k = 0; k < kInstrumentedKernelCount; ++k) volumes[k].clear();
+  sample_clock = 0;
+}
+
+KernelCounter Instrumentation::ShapeTotal(const InstrumentedShape shape,
+                                          const InstrumentedKernel kernel) {
+  Registry &registry = Registry::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  KernelCounter total = registry.shapes[shape][kernel];
+  for (unsigned t = 0; t < registry.threads.size(); ++t) {
+    Accumulate(registry.threads[t]->shapes[shape][kernel], &total);
+  }
+  return total;
+}
+
+KernelCounter Instrumentation::VolumeTotal(const int volume_id,
+                                           const InstrumentedKernel kernel) {
+  Registry &registry = Registry::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  KernelCounter total = {0, 0, 0, 0};
+  if (volume_id < static_cast<int>(registry.volumes[kernel].size())) {
+    total = registry.volumes[kernel][volume_id];
+  }
+  for (unsigned t = 0; t < registry.threads.size(); ++t) {
+    std::vector<KernelCounter> const &counters =
+        registry.threads[t]->volumes[kernel];
+    if (volume_id < static_cast<int>(counters.size())) {
+      Accumulate(counters[volume_id], &total);
+    }
+  }
+  return total;
+}
+
+void Instrumentation::Print(std::ostream &os, const int volume_count) {
+
+  os << "Kernel calls per shape:\n";
+  for (int s = 0; s < kInstrumentedShapeCount; ++s) {
+    for (int k = 0; k < kInstrumentedKernelCount; ++k) {
+      const KernelCounter counter =
+          ShapeTotal(static_cast<InstrumentedShape>(s),
+                     static_cast<InstrumentedKernel>(k));
+      if (!counter.calls) continue;
+      os << "  " << shape_labels[s] << " " << kernel_labels[k] << ": "
+         << counter.calls << " calls, " << counter.points << " points, ~"
+         << EstimatedTime(counter) << "s\n";
+    }
+  }
+
+  // Merge all threads once to rank volumes by estimated time
+  std::vector<KernelCounter> volumes[kInstrumentedKernelCount];
+  {
+    Registry &registry = Registry::Instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (int k = 0; k < kInstrumentedKernelCount; ++k) {
+      AccumulateVolumes(registry.volumes[k], &volumes[k]);
+      for (unsigned t = 0; t < registry.threads.size(); ++t) {
+        AccumulateVolumes(registry.threads[t]->volumes[k], &volumes[k]);
+      }
+    }
+  }
+  unsigned volume_total = 0;
+  for (int k = 0; k < kInstrumentedKernelCount; ++k) {
+    volume_total = std::max<unsigned>(volume_total, volumes[k].size());
+  }
+  std::vector<VolumeTime> times(volume_total);
+  for (unsigned id = 0; id < volume_total; ++id) {
+    times[id].id = id;
+    times[id].time = 0;
+    for (int k = 0; k < kInstrumentedKernelCount; ++k) {
+      if (id < volumes[k].size()) {
+        times[id].time += EstimatedTime(volumes[k][id]);
+      }
+    }
+  }
+  std::sort(times.begin(), times.end());
+
+  std::vector<VPlacedVolume const*> const &table =
+      GeoManager::Instance().volumes();
+  os << "Placed volumes by estimated kernel time:\n";
+  for (int i = 0; i < volume_count && i < static_cast<int>(times.size());
+       ++i) {
+    const int id = times[i].id;
+    if (times[i].time <= 0) break;
+    os << "  Volume " << id;
+    if (id < static_cast<int>(table.size()) && table[id]) {
+      TransformationMatrix const *const matrix = table[id]->matrix();
+      os << " (translation " << matrix->GenerateTranslationCode()
+         << ", rotation 0x" << std::hex << matrix->GenerateRotationCode()
+         << std::dec << ")";
+    }
+    os << ": ~" << times[i].time << "s";
+    for (int k = 0; k < kInstrumentedKernelCount; ++k) {
+      if (id < static_cast<int>(volumes[k].size()) && volumes[k][id].calls) {
+        os << ", " << volumes[k][id].calls << " " << kernel_labels[k];
+      }
+    }
+    os << "\n";
+  }
+}
+
+void Instrumentation::Reset() {
+  Registry &registry = Registry::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  memset(registry.shapes, 0, sizeof(registry.shapes));
+  for (int k = 0; k < kInstrumentedKernelCount; ++k) {
+    registry.volumes[k].clear();
+  }
+  for (unsigned t = 0; t < registry.threads.size(); ++t) {
+    registry.threads[t]->Reset();
+  }
+}
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_INSTRUMENTATION
\ No newline at end of file
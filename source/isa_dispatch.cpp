@@ -0,0 +1,147 @@
+#include "management/isa_dispatch.h"
+
+#ifdef VECGEOM_ISA_DISPATCH
+
+#include <stdlib.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace vecgeom {
+
+char const *const IsaDispatch::labels[] = {
+  "baseline",
+  "sse4",
+  "avx2",
+  "avx512"
+};
+
+namespace {
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/**
+ * Reads the extended control register holding the register state enabled by
+ * the operating system. Encoded directly to avoid requiring XSAVE support
+ * from the compiler target.
+ */
+unsigned long long ReadXcr0() {
+  unsigned eax, edx;
+  __asm__ volatile(".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<unsigned long long>(edx) << 32) | eax;
+}
+
+#endif
+
+/**
+ * Keeps the entry of the best variant not exceeding the limit, in order of
+ * increasing instruction set.
+ */
+template <typename Kernel>
+void Select(Kernel const (&variants)[kInstructionSetCount],
+            const InstructionSet limit, Kernel *const kernel,
+            InstructionSet *const selected) {
+  *kernel = NULL;
+  *selected = kInstructionSetBaseline;
+  for (int i = kInstructionSetBaseline + 1; i <= limit; ++i) {
+    if (variants[i]) {
+      *kernel = variants[i];
+      *selected = static_cast<InstructionSet>(i);
+    }
+  }
+}
+
+} // End anonymous namespace
+
+IsaDispatch::IsaDispatch()
+    : detected_(kInstructionSetBaseline), limit_(kInstructionSetBaseline),
+      box_inside_(kInstructionSetBaseline),
+      box_distance_to_in_(kInstructionSetBaseline),
+      box_distance_to_out_(kInstructionSetBaseline), bound_(false) {
+  box_.inside = NULL;
+  box_.distance_to_in = NULL;
+  box_.distance_to_out = NULL;
+}
+
+InstructionSet IsaDispatch::Detect() {
+  #if defined(__x86_64__) || defined(__i386__)
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return kInstructionSetBaseline;
+  const bool sse4 = (ecx & bit_SSE4_1) && (ecx & bit_SSE4_2);
+  if (!sse4) return kInstructionSetBaseline;
+  const bool fma = ecx & bit_FMA;
+  const bool osxsave = ecx & bit_OSXSAVE;
+  const bool avx = ecx & bit_AVX;
+  if (!osxsave || !avx) return kInstructionSetSse4;
+  const unsigned long long xcr0 = ReadXcr0();
+  // SSE and AVX state, then additionally opmask and upper ZMM state
+  if ((xcr0 & 0x6) != 0x6) return kInstructionSetSse4;
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    return kInstructionSetSse4;
+  }
+  const bool avx2 = (ebx & bit_AVX2) && fma;
+  const bool avx512 = (ebx & bit_AVX512F) && (xcr0 & 0xe6) == 0xe6;
+  if (avx2 && avx512) return kInstructionSetAvx512;
+  if (avx2) return kInstructionSetAvx2;
+  return kInstructionSetSse4;
+  #else
+  return kInstructionSetBaseline;
+  #endif
+}
+
+void IsaDispatch::Bind(const bool force) {
+  if (bound_ && !force) return;
+  InstructionSet limit = kInstructionSetAvx512;
+  char const *const requested = getenv("VECGEOM_ISA");
+  if (requested) {
+    bool found = false;
+    for (int i = 0; i < kInstructionSetCount; ++i) {
+      if (!strcmp(requested, labels[i])) {
+        limit = static_cast<InstructionSet>(i);
+        found = true;
+      }
+    }
+    if (!found) {
+      std::cerr << "Unknown instruction set \"" << requested
+                << "\" requested in VECGEOM_ISA, using all supported.\n";
+    }
+  }
+  Bind(limit);
+}
+
+void IsaDispatch::Bind(const InstructionSet limit) {
+  detected_ = Detect();
+  limit_ = (limit < detected_) ? limit : detected_;
+
+  BoxBasketKernels variants[kInstructionSetCount];
+  memset(variants, 0, sizeof(variants));
+  variants[kInstructionSetSse4] = BoxBasketKernelsSse4();
+  variants[kInstructionSetAvx2] = BoxBasketKernelsAvx2();
+  variants[kInstructionSetAvx512] = BoxBasketKernelsAvx512();
+
+  BoxBasketKernels::InsideKernel inside[kInstructionSetCount];
+  BoxBasketKernels::DistanceToInKernel distance_to_in[kInstructionSetCount];
+  BoxBasketKernels::DistanceToOutKernel distance_to_out[kInstructionSetCount];
+  for (int i = 0; i < kInstructionSetCount; ++i) {
+    inside[i] = variants[i].inside;
+    distance_to_in[i] = variants[i].distance_to_in;
+    distance_to_out[i] = variants[i].distance_to_out;
+  }
+  Select(inside, limit_, &box_.inside, &box_inside_);
+  Select(distance_to_in, limit_, &box_.distance_to_in, &box_distance_to_in_);
+  Select(distance_to_out, limit_, &box_.distance_to_out,
+         &box_distance_to_out_);
+  bound_ = true;
+}
+
+void IsaDispatch::Print(std::ostream &os) const {
+  os << "Detected instruction set " << labels[detected_] << ", limited to "
+     << labels[limit_] << ". Box Inside: " << labels[box_inside_]
+     << ", DistanceToIn: " << labels[box_distance_to_in_]
+     << ", DistanceToOut: " << labels[box_distance_to_out_] << ".\n";
+}
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_ISA_DISPATCH
\ No newline at end of file
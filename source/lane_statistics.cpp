@@ -0,0 +1,154 @@
+#include "base/lane_statistics.h"
+
+#ifdef VECGEOM_LANE_STATISTICS
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include <string.h>
+
+namespace vecgeom {
+
+namespace {
+
+char const *const shape_labels[] = {
+  "Box"
+};
+
+char const *const kernel_labels[] = {
+  "Inside",
+  "DistanceToIn",
+  "DistanceToOut",
+  "InsideBasket",
+  "DistanceToInBasket",
+  "DistanceToOutBasket",
+  "SafetyToIn",
+  "SafetyToOut"
+};
+
+void Accumulate(LaneCounter const &from, LaneCounter *const to) {
+  to->calls += from.calls;
+  to->checks += from.checks;
+  to->exits += from.exits;
+  for (int i = 0; i < LaneCounter::kMaxChecks; ++i) {
+    to->exits_at[i] += from.exits_at[i];
+  }
+  to->masked_assigns += from.masked_assigns;
+  to->active_lanes += from.active_lanes;
+  to->total_lanes += from.total_lanes;
+  for (int i = 0; i <= LaneCounter::kMaxLanes; ++i) {
+    to->lanes_histogram[i] += from.lanes_histogram[i];
+  }
+}
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<LaneThreadCounters*> threads;
+  LaneCounter kernels[kInstrumentedShapeCount][kInstrumentedKernelCount];
+
+  Registry() {
+    memset(kernels, 0, sizeof(kernels));
+  }
+
+  static Registry& Instance() {
+    static Registry instance;
+    return instance;
+  }
+};
+
+} // End anonymous namespace
+
+LaneThreadCounters& LaneThreadCounters::Instance() {
+  static thread_local LaneThreadCounters instance;
+  return instance;
+}
+
+LaneThreadCounters::LaneThreadCounters() : current(NULL), checks(0) {
+  memset(kernels, 0, sizeof(kernels));
+  Registry &registry = Registry::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.threads.push_back(this);
+}
+
+LaneThreadCounters::~LaneThreadCounters() {
+  Registry &registry = Registry::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (int s = 0; s < kInstrumentedShapeCount; ++s) {
+    for (int k = 0; k < kInstrumentedKernelCount; ++k) {
+      Accumulate(kernels[s][k], &registry.kernels[s][k]);
+    }
+  }
+  registry.threads.erase(
+    std::find(registry.threads.begin(), registry.threads.end(), this)
+  );
+}
+
+void LaneThreadCounters::Reset() {
+  memset(kernels, 0, sizeof(kernels));
+}
+
+LaneCounter LaneStatistics::Total(const InstrumentedShape shape,
+                                  const InstrumentedKernel kernel) {
+  Registry &registry = Registry::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  LaneCounter total = registry.kernels[shape][kernel];
+  for (unsigned t = 0; t < registry.threads.size(); ++t) {
+    Accumulate(registry.threads[t]->kernels[shape][kernel], &total);
+  }
+  return total;
+}
+
+void LaneStatistics::Print(std::ostream &os) {
+  os << "SIMD lane utilization per kernel:\n";
+  for (int s = 0; s < kInstrumentedShapeCount; ++s) {
+    for (int k = 0; k < kInstrumentedKernelCount; ++k) {
+      const LaneCounter counter =
+          Total(static_cast<InstrumentedShape>(s),
+                static_cast<InstrumentedKernel>(k));
+      if (!counter.calls) continue;
+      os << "  " << shape_labels[s] << " " << kernel_labels[k] << ": "
+         << counter.calls << " calls";
+      if (counter.total_lanes) {
+        os << ", " << counter.masked_assigns << " masked assignments with "
+           << 100. * counter.active_lanes / counter.total_lanes
+           << "% active lanes";
+      }
+      if (counter.checks) {
+        os << ", " << 100. * counter.exits / counter.calls
+           << "% early exits";
+      }
+      os << "\n";
+      if (counter.exits) {
+        os << "    exits by check:";
+        for (int i = 0; i < LaneCounter::kMaxChecks; ++i) {
+          os << " " << counter.exits_at[i];
+        }
+        os << "\n";
+      }
+      if (counter.masked_assigns) {
+        int widest = 0;
+        for (int i = 0; i <= LaneCounter::kMaxLanes; ++i) {
+          if (counter.lanes_histogram[i]) widest = i;
+        }
+        os << "    assignments by active lanes:";
+        for (int i = 0; i <= widest; ++i) {
+          os << " " << counter.lanes_histogram[i];
+        }
+        os << "\n";
+      }
+    }
+  }
+}
+
+void LaneStatistics::Reset() {
+  Registry &registry = Registry::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  memset(registry.kernels, 0, sizeof(registry.kernels));
+  for (unsigned t = 0; t < registry.threads.size(); ++t) {
+    registry.threads[t]->Reset();
+  }
+}
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_LANE_STATISTICS
\ No newline at end of file
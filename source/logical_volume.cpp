@@ -1,30 +1,226 @@
 #include <stdio.h>
 #include <climits>
+#include <cmath>
 #include "base/array.h"
 #include "management/volume_factory.h"
+#include "navigation/daughter_bounds.h"
+#include "navigation/face_neighbors.h"
 #include "volumes/logical_volume.h"
 #include "volumes/placed_volume.h"
+#include "volumes/unplaced_box.h"
 #ifdef VECGEOM_CUDA
 #include "backend/cuda_backend.cuh"
 #endif
 
 namespace vecgeom {
 
+LogicalVolume::LogicalVolume(VUnplacedVolume const *const unplaced_volume__)
+    : unplaced_volume_(unplaced_volume__),
+      daughters_(new Vector<Daughter>()),
+      daughter_bounds_(new DaughterBounds),
+      face_neighbors_(new FaceNeighbors), replica_(NULL),
+      parametrisation_(NULL), assembly_(false), flattened_matrices_(NULL) {}
+
 LogicalVolume::~LogicalVolume() {
+  // Copies of a parametrisation are destroyed along with it
   for (Iterator<VPlacedVolume const*> i = daughters().begin();
-       i != daughters().end(); ++i) {
+       i != daughters().end() && !parametrisation_; ++i) {
     delete *i;
   }
   delete static_cast<Vector<VPlacedVolume const*> *>(daughters_);
+  delete daughter_bounds_;
+  delete face_neighbors_;
+  delete replica_;
+  delete parametrisation_;
+  delete flattened_matrices_;
+}
+
+void LogicalVolume::AppendDaughter(VPlacedVolume const *const daughter) {
+  static_cast<Vector<VPlacedVolume const*> *>(daughters_)->push_back(daughter);
+  daughter_bounds_->Add(
+    daughter->matrix()->Translation(),
+    daughter->logical_volume()->unplaced_volume()->BoundingRadius()
+  );
+}
+
+void LogicalVolume::BuildAcceleration(DaughterBounds *const bounds,
+                                      FaceNeighbors *const neighbors) {
+  daughter_bounds_ = bounds;
+  face_neighbors_ = neighbors;
+  for (Iterator<Daughter> i = daughters().begin(); i != daughters().end();
+       ++i) {
+    daughter_bounds_->Add(
+      (*i)->matrix()->Translation(),
+      (*i)->logical_volume()->unplaced_volume()->BoundingRadius()
+    );
+  }
+  BuildFaceNeighbors();
+}
+
+void LogicalVolume::BuildFaceNeighbors() const {
+  face_neighbors_->Build(this);
+}
+
+int LogicalVolume::CountFlattened(LogicalVolume const *const assembly) {
+  int count = 0;
+  for (Iterator<Daughter> i = assembly->daughters().begin();
+       i != assembly->daughters().end(); ++i) {
+    LogicalVolume const *const volume = (*i)->logical_volume();
+    count += (volume->assembly()) ? CountFlattened(volume) : 1;
+  }
+  return count;
+}
+
+void LogicalVolume::FlattenAssemblies(const int max_daughters) {
+  if (replica_ || parametrisation_) return;
+  Vector<VPlacedVolume const*> *const daughters =
+      static_cast<Vector<VPlacedVolume const*> *>(daughters_);
+  std::vector<VPlacedVolume const*> previous;
+  std::vector<bool> flatten;
+  bool any = false;
+  for (Iterator<Daughter> i = daughters->begin(); i != daughters->end();
+       ++i) {
+    LogicalVolume const *const volume = (*i)->logical_volume();
+    previous.push_back(*i);
+    flatten.push_back(volume->assembly() &&
+                      CountFlattened(volume) <= max_daughters);
+    if (flatten.back()) any = true;
+  }
+  if (!any) return;
+  daughters->clear();
+  daughter_bounds_->Clear();
+  for (unsigned i = 0; i < previous.size(); ++i) {
+    if (!flatten[i]) {
+      AppendDaughter(previous[i]);
+      continue;
+    }
+    AppendFlattened(previous[i]->logical_volume(), *previous[i]->matrix(),
+                    previous[i]->id());
+    delete previous[i];
+  }
+}
+
+void LogicalVolume::AppendFlattened(LogicalVolume const *const assembly,
+                                    TransformationMatrix const &matrix,
+                                    const int assembly_id) {
+  if (!flattened_matrices_) {
+    flattened_matrices_ = new std::deque<TransformationMatrix>;
+  }
+  for (Iterator<Daughter> i = assembly->daughters().begin();
+       i != assembly->daughters().end(); ++i) {
+    TransformationMatrix composed(matrix);
+    composed.MultiplyFromRight(*(*i)->matrix());
+    LogicalVolume const *const volume = (*i)->logical_volume();
+    if (volume->assembly()) {
+      AppendFlattened(volume, composed, assembly_id);
+      continue;
+    }
+    // Elements of a deque are not moved when appending
+    flattened_matrices_->push_back(composed);
+    VPlacedVolume const *const placed =
+        volume->unplaced_volume()->PlaceVolume(volume,
+                                               &flattened_matrices_->back());
+    AppendDaughter(placed);
+    // Daughters of assemblies may themselves have been flattened already
+    FlattenedOrigin const *const inner = GeoManager::Instance().Origin(*i);
+    GeoManager::Instance().RecordOrigin(
+      placed, assembly_id, (inner) ? inner->original : (*i)->id()
+    );
+  }
 }
 
 void LogicalVolume::PlaceDaughter(LogicalVolume const *const volume,
                                   TransformationMatrix const *const matrix) {
-  VPlacedVolume *placed =
+  if (replica_ || parametrisation_) {
+    std::cerr << "Cannot place daughters next to a replica or "
+                 "parametrisation.\n";
+    return;
+  }
+  AppendDaughter(volume->unplaced_volume()->PlaceVolume(volume, matrix));
+}
+
+bool LogicalVolume::PlaceReplica(LogicalVolume const *const volume,
+                                 const ReplicaAxis axis, const int copies,
+                                 const Precision pitch,
+                                 const Precision offset) {
+  if (replica_ || parametrisation_ || daughters_->size() > 0) {
+    std::cerr << "A replica must be the only content of its mother.\n";
+    return false;
+  }
+  UnplacedBox const *const box =
+      dynamic_cast<UnplacedBox const*>(volume->unplaced_volume());
+  if (!box || copies < 1 ||
+      std::fabs(2.*box->dimensions()[axis] - pitch) > kGTolerance*pitch) {
+    std::cerr << "Replicas need at least one box copy as long as the pitch "
+                 "along the axis.\n";
+    return false;
+  }
+  replica_ = new ReplicaPlacement(box->dimensions(), axis, copies, pitch,
+                                  offset);
+  VPlacedVolume const *const cell =
+      box->PlaceVolume(volume, replica_->cell_matrix());
+  replica_->set_cell(cell);
+  AppendDaughter(cell);
+  return true;
+}
+
+bool LogicalVolume::PlaceParametrised(LogicalVolume const *const volume,
+                                      SOA3D<Precision> const &translations,
+                                      int const *const angle_index,
+                                      std::vector<Precision> const &angles) {
+  if (replica_ || parametrisation_ || daughters_->size() > 0) {
+    std::cerr << "A parametrisation must be the only content of its "
+                 "mother.\n";
+    return false;
+  }
+  if (!dynamic_cast<UnplacedBox const*>(volume->unplaced_volume())) {
+    std::cerr << "Parametrised placements need a box volume.\n";
+    return false;
+  }
+  const int copies = translations.size();
+  for (int i = 0; i < copies; ++i) {
+    if (angle_index[i] < 0 ||
+        angle_index[i] >= static_cast<int>(angles.size())) {
+      std::cerr << "Angle index " << angle_index[i] << " of copy " << i
+                << " is out of range.\n";
+      return false;
+    }
+  }
+  parametrisation_ = new ParametrisedPlacement(volume, translations,
+                                               angle_index, angles);
+  static_cast<Vector<VPlacedVolume const*> *>(daughters_)->reserve(copies);
+  for (int i = 0; i < copies; ++i) {
+    AppendDaughter(parametrisation_->cell(i));
+  }
+  return true;
+}
+
+VPlacedVolume const* LogicalVolume::PlaceDaughterConcurrently(
+    LogicalVolume const *const volume,
+    TransformationMatrix const *const matrix) {
+  VPlacedVolume const *const placed =
       volume->unplaced_volume()->PlaceVolume(volume, matrix);
-  static_cast<Vector<VPlacedVolume const*> *>(
-    daughters_
-  )->push_back(placed);
+  GeoManager::Instance().StagePlacement(this, placed);
+  return placed;
+}
+
+void LogicalVolume::PlaceDaughters(
+    LogicalVolume const *const *const volumes,
+    TransformationMatrix const *const *const matrices,
+    const int count) {
+  if (replica_ || parametrisation_) {
+    std::cerr << "Cannot place daughters next to a replica or "
+                 "parametrisation.\n";
+    return;
+  }
+  Vector<VPlacedVolume const*> *const daughters =
+      static_cast<Vector<VPlacedVolume const*> *>(daughters_);
+  daughters->reserve(daughters->size() + count);
+  for (int i = 0; i < count; ++i) {
+    AppendDaughter(
+      volumes[i]->unplaced_volume()->PlaceVolume(volumes[i], matrices[i])
+    );
+  }
 }
 
 VECGEOM_CUDA_HEADER_BOTH
@@ -0,0 +1,93 @@
+#include "management/parallel_basket.h"
+
+#include <algorithm>
+#include "navigation/navigation_state.h"
+#include "navigation/simple_navigator.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+namespace {
+
+const int kChunkGranularity = kAlignmentBoundary / sizeof(Precision);
+
+/**
+ * Non-owning view of the elements of a basket starting at an offset.
+ */
+class ChunkView {
+
+private:
+
+  SOA3D<Precision> view_;
+
+public:
+
+  ChunkView(SOA3D<Precision> const &basket, const int offset, const int size)
+      : view_(const_cast<Precision*>(basket.x()) + offset,
+              const_cast<Precision*>(basket.y()) + offset,
+              const_cast<Precision*>(basket.z()) + offset, size) {}
+
+  operator SOA3D<Precision> const&() const { return view_; }
+
+};
+
+} // End anonymous namespace
+
+ParallelBasket::ParallelBasket()
+    : pool_(&ThreadPool::Instance()), chunk_size_(kDefaultChunkSize),
+      schedule_(kScheduleDynamic) {}
+
+ParallelBasket::ParallelBasket(ThreadPool &pool)
+    : pool_(&pool), chunk_size_(kDefaultChunkSize),
+      schedule_(kScheduleDynamic) {}
+
+void ParallelBasket::set_chunk_size(const int chunk_size) {
+  const int chunks = (chunk_size + kChunkGranularity - 1) / kChunkGranularity;
+  chunk_size_ = ((chunks > 0) ? chunks : 1) * kChunkGranularity;
+}
+
+void ParallelBasket::Inside(VPlacedVolume const &volume,
+                            SOA3D<Precision> const &points,
+                            bool *const output) const {
+  const int size = points.size();
+  pool_->Run(chunks(size), [&](const int chunk) {
+    const int offset = chunk * chunk_size_;
+    const int count = std::min(chunk_size_, size - offset);
+    volume.Inside(ChunkView(points, offset, count), output + offset);
+  }, schedule_);
+}
+
+void ParallelBasket::DistanceToIn(VPlacedVolume const &volume,
+                                  SOA3D<Precision> const &positions,
+                                  SOA3D<Precision> const &directions,
+                                  Precision const *const step_max,
+                                  Precision *const output) const {
+  const int size = positions.size();
+  pool_->Run(chunks(size), [&](const int chunk) {
+    const int offset = chunk * chunk_size_;
+    const int count = std::min(chunk_size_, size - offset);
+    volume.DistanceToIn(ChunkView(positions, offset, count),
+                        ChunkView(directions, offset, count),
+                        step_max + offset, output + offset);
+  }, schedule_);
+}
+
+void ParallelBasket::Locate(VPlacedVolume const *const world,
+                            SOA3D<Precision> const &points,
+                            const int max_level,
+                            VPlacedVolume const **const output) const {
+  const int size = points.size();
+  pool_->Run(chunks(size), [&](const int chunk) {
+    const int offset = chunk * chunk_size_;
+    const int end = std::min(offset + chunk_size_, size);
+    SimpleNavigator navigator;
+    NavigationState state(max_level);
+    Vector3D<Precision> local;
+    for (int i = offset; i < end; ++i) {
+      state.Clear();
+      output[i] = navigator.LocatePoint(world, points[i], local, state);
+    }
+  }, schedule_);
+}
+
+} // End namespace vecgeom
\ No newline at end of file
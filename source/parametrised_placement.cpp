@@ -0,0 +1,232 @@
+#include "volumes/parametrised_placement.h"
+
+#include <algorithm>
+#include <cmath>
+#include "backend/backend.h"
+#include "backend/scalar_backend.h"
+#include "volumes/kernel/box_kernel.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+#include "volumes/specialized_box.h"
+#include "volumes/unplaced_box.h"
+
+namespace vecgeom {
+
+const int ParametrisedPlacement::kChunkSize;
+const int ParametrisedPlacement::kLanes;
+
+namespace {
+
+/**
+ * Identity passed to the box kernels for points already in the copy frame.
+ */
+const TransformationMatrix kIdentityMatrix;
+
+/**
+ * Transforms a point and a direction into the frames of copies translated by
+ * (x, y, z) and rotated around the z-axis, with the products accumulated in
+ * the same order as the generic rotation of TransformationMatrix.
+ */
+template <ImplType it>
+VECGEOM_INLINE
+void ToCopyFrame(Vector3D<Precision> const &point,
+                 Vector3D<Precision> const &direction,
+                 typename Impl<it>::precision_v const &x,
+                 typename Impl<it>::precision_v const &y,
+                 typename Impl<it>::precision_v const &z,
+                 typename Impl<it>::precision_v const &cos_phi,
+                 typename Impl<it>::precision_v const &sin_phi,
+                 Vector3D<typename Impl<it>::precision_v> *const local_point,
+                 Vector3D<typename Impl<it>::precision_v> *const local_dir) {
+  typedef typename Impl<it>::precision_v Float;
+  const Float master_x = point[0] - x;
+  const Float master_y = point[1] - y;
+  (*local_point)[0] = master_x*cos_phi + master_y*sin_phi;
+  (*local_point)[1] = master_y*cos_phi - master_x*sin_phi;
+  (*local_point)[2] = point[2] - z;
+  if (!local_dir) return;
+  (*local_dir)[0] = direction[0]*cos_phi + direction[1]*sin_phi;
+  (*local_dir)[1] = direction[1]*cos_phi - direction[0]*sin_phi;
+  (*local_dir)[2] = direction[2];
+}
+
+} // End anonymous namespace
+
+ParametrisedPlacement::ParametrisedPlacement(
+    LogicalVolume const *const volume,
+    SOA3D<Precision> const &translations,
+    int const *const angle_index,
+    std::vector<Precision> const &angles)
+    : copies_(translations.size()), angles_(angles),
+      matrices_(translations.size()), cells_(translations.size(), NULL) {
+  UnplacedBox const *const box =
+      static_cast<UnplacedBox const*>(volume->unplaced_volume());
+  dimensions_ = box->dimensions();
+  // Pads to whole chunks, so chunks are processed without a remainder
+  const int padded = (copies_ / kChunkSize + 1)*kChunkSize;
+  x_.resize(padded, 0);
+  y_.resize(padded, 0);
+  z_.resize(padded, 0);
+  cos_.resize(padded, 1);
+  sin_.resize(padded, 0);
+  angle_index_.assign(angle_index, angle_index + copies_);
+  // Every specialization of the box has the size of its base class, as
+  // asserted where the factory constructs them
+  const size_t size = sizeof(PlacedBox);
+  const Precision bounding_radius = dimensions_.Length();
+  pool_ = _mm_malloc(copies_*size, kAlignmentBoundary);
+  for (int i = 0; i < copies_; ++i) {
+    const Precision phi = angles_[angle_index_[i]];
+    x_[i] = translations.x(i);
+    y_[i] = translations.y(i);
+    z_[i] = translations.z(i);
+    cos_[i] = cos(kDegToRad*phi);
+    sin_[i] = sin(kDegToRad*phi);
+    matrices_[i].SetTranslation(x_[i], y_[i], z_[i]);
+    matrices_[i].SetRotation(phi, 0, 0);
+    cells_[i] = box->PlaceVolume(
+      volume, &matrices_[i],
+      reinterpret_cast<VPlacedVolume*>(static_cast<char*>(pool_) + i*size)
+    );
+    bounds_.Add(translation(i), bounding_radius);
+  }
+}
+
+ParametrisedPlacement::~ParametrisedPlacement() {
+  for (int i = 0; i < copies_; ++i) cells_[i]->~VPlacedVolume();
+  _mm_free(pool_);
+}
+
+void ParametrisedPlacement::DistanceToInLanes(
+    Vector3D<Precision> const &point,
+    Vector3D<Precision> const &direction,
+    const Precision step, const int first,
+    Precision *const output) const {
+  #ifdef VECGEOM_VECTOR_BACKEND
+  // The padding allows reading whole vectors past the last copy
+  typedef Impl<kVectorImpl> Backend;
+  Vector3D<VectorPrecision> local_point, local_dir;
+  ToCopyFrame<kVectorImpl>(
+    point, direction,
+    Backend::LoadUnaligned(&x_[first]), Backend::LoadUnaligned(&y_[first]),
+    Backend::LoadUnaligned(&z_[first]), Backend::LoadUnaligned(&cos_[first]),
+    Backend::LoadUnaligned(&sin_[first]), &local_point, &local_dir
+  );
+  VectorPrecision distance;
+  BoxDistanceToIn<translation::kOrigin, rotation::kIdentity, kVectorImpl>(
+    dimensions_, kIdentityMatrix, local_point, local_dir,
+    VectorPrecision(step), &distance
+  );
+  Backend::StoreUnaligned(distance, output);
+  #else
+  Vector3D<Precision> local_point, local_dir;
+  ToCopyFrame<kScalar>(point, direction, x_[first], y_[first], z_[first],
+                       cos_[first], sin_[first], &local_point, &local_dir);
+  BoxDistanceToIn<translation::kOrigin, rotation::kIdentity, kScalar>(
+    dimensions_, kIdentityMatrix, local_point, local_dir, step, output
+  );
+  #endif
+}
+
+void ParametrisedPlacement::SafetyToInChunk(Vector3D<Precision> const &point,
+                                            const int first,
+                                            Precision *const output) const {
+  const int count = std::min(kChunkSize, copies_ - first);
+  #ifdef VECGEOM_VECTOR_BACKEND
+  typedef Impl<kVectorImpl> Backend;
+  for (int i = 0; i < count; i += Backend::kVectorSize) {
+    const int j = first + i;
+    Vector3D<VectorPrecision> local_point;
+    ToCopyFrame<kVectorImpl>(
+      point, point,
+      Backend::LoadUnaligned(&x_[j]), Backend::LoadUnaligned(&y_[j]),
+      Backend::LoadUnaligned(&z_[j]), Backend::LoadUnaligned(&cos_[j]),
+      Backend::LoadUnaligned(&sin_[j]), &local_point, NULL
+    );
+    VectorPrecision safety;
+    BoxSafetyToIn<translation::kOrigin, rotation::kIdentity, kVectorImpl>(
+      dimensions_, kIdentityMatrix, local_point, &safety
+    );
+    Backend::StoreUnaligned(safety, &output[i]);
+  }
+  #else
+  for (int i = 0; i < count; ++i) {
+    const int j = first + i;
+    Vector3D<Precision> local_point;
+    ToCopyFrame<kScalar>(point, point, x_[j], y_[j], z_[j], cos_[j], sin_[j],
+                         &local_point, NULL);
+    BoxSafetyToIn<translation::kOrigin, rotation::kIdentity, kScalar>(
+      dimensions_, kIdentityMatrix, local_point, &output[i]
+    );
+  }
+  #endif
+}
+
+VPlacedVolume const* ParametrisedPlacement::Locate(
+    Vector3D<Precision> const &point) const {
+  Precision safety[kChunkSize];
+  for (int first = 0; first < copies_; first += kChunkSize) {
+    SafetyToInChunk(point, first, safety);
+    const int count = std::min(kChunkSize, copies_ - first);
+    for (int i = 0; i < count; ++i) {
+      // Confirmed by the placed copy, so points on the surface are classified
+      // exactly as when testing every daughter
+      if (safety[i] < kGTolerance && cells_[first + i]->Inside(point)) {
+        return cells_[first + i];
+      }
+    }
+  }
+  return NULL;
+}
+
+void ParametrisedPlacement::DistanceToIn(
+    Vector3D<Precision> const &point,
+    Vector3D<Precision> const &direction,
+    Precision *const step,
+    VPlacedVolume const **const hit) const {
+  // Copies are evaluated a vector at a time rather than a chunk at a time, so
+  // the kernel can skip vectors of copies beyond the step found so far
+  Precision lower_bounds[kChunkSize];
+  Precision distance[kLanes];
+  for (int first = 0; first < copies_; first += kLanes) {
+    const int lane = first % kChunkSize;
+    if (!lane) bounds_.DistanceToIn(point, direction, first, lower_bounds);
+    const int count = std::min(kLanes, copies_ - first);
+    bool candidate = false;
+    for (int i = 0; i < count; ++i) {
+      candidate |= lower_bounds[lane + i] < *step;
+    }
+    if (!candidate) continue;
+    DistanceToInLanes(point, direction, *step, first, distance);
+    for (int i = 0; i < count; ++i) {
+      // Candidates are recomputed by the placed copy, so the step does not
+      // depend on rounding differences of the vector path
+      if (lower_bounds[lane + i] >= *step ||
+          distance[i] > *step*(1. + kGTolerance) + kGTolerance) {
+        continue;
+      }
+      const Precision exact =
+          cells_[first + i]->DistanceToIn(point, direction, *step);
+      if (exact < *step) {
+        *step = exact;
+        *hit = cells_[first + i];
+      }
+    }
+  }
+}
+
+Precision ParametrisedPlacement::SafetyToIn(
+    Vector3D<Precision> const &point) const {
+  Precision safety[kChunkSize];
+  Precision minimum = kInfinity;
+  for (int first = 0; first < copies_; first += kChunkSize) {
+    SafetyToInChunk(point, first, safety);
+    const int count = std::min(kChunkSize, copies_ - first);
+    for (int i = 0; i < count; ++i) {
+      if (safety[i] < minimum) minimum = safety[i];
+    }
+  }
+  return minimum;
+}
+
+} // End namespace vecgeom
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include <string.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#include "base/perf_counters.h"
+
+namespace vecgeom {
+
+namespace {
+
+const PerfEvent kCoreEvents[] = {kPerfCycles, kPerfInstructions,
+                                 kPerfBranchMisses};
+const PerfEvent kCacheEvents[] = {kPerfL1Misses, kPerfLlcMisses};
+
+#ifdef __linux__
+
+int OpenEvent(const PerfEvent event, const int group) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  switch (event) {
+    case kPerfCycles:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case kPerfInstructions:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case kPerfBranchMisses:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+    case kPerfL1Misses:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_L1D
+                    | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                    | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break;
+    case kPerfLlcMisses:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_LL
+                    | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                    | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break;
+    default:
+      return -1;
+  }
+  attr.disabled = (group < 0) ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                     | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+#endif // __linux__
+
+} // End anonymous namespace
+
+PerfCounterGroup::PerfCounterGroup(PerfEvent const *const events,
+                                   const int count)
+    : leader_(-1), count_(0), running_(false) {
+  for (int i = 0; i < count && i < kMaxEvents; ++i) {
+    events_[count_] = events[i];
+    #ifdef __linux__
+    fds_[count_] = OpenEvent(events[i], leader_);
+    #else
+    fds_[count_] = -1;
+    #endif
+    if (leader_ < 0) leader_ = fds_[count_];
+    values_[count_] = 0;
+    ++count_;
+  }
+}
+
+PerfCounterGroup::~PerfCounterGroup() {
+  // Members before the leader so the group is closed last
+  for (int i = count_ - 1; i >= 0; --i) {
+    if (fds_[i] >= 0) close(fds_[i]);
+  }
+}
+
+bool PerfCounterGroup::available(const PerfEvent event) const {
+  for (int i = 0; i < count_; ++i) {
+    if (events_[i] == event) return fds_[i] >= 0;
+  }
+  return false;
+}
+
+void PerfCounterGroup::Start() {
+  if (leader_ < 0 || running_) return;
+  #ifdef __linux__
+  ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  #endif
+  running_ = true;
+}
+
+void PerfCounterGroup::Stop() {
+  if (leader_ < 0 || !running_) return;
+  running_ = false;
+  #ifdef __linux__
+  ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  // Number of events, time enabled, time running, then one value per event
+  uint64_t buffer[3 + kMaxEvents];
+  const ssize_t size = read(leader_, buffer, sizeof(buffer));
+  if (size < static_cast<ssize_t>(3*sizeof(uint64_t))) return;
+  const uint64_t enabled = buffer[1];
+  const uint64_t running = buffer[2];
+  if (!running) return;
+  const double scale = static_cast<double>(enabled) / running;
+  uint64_t slot = 0;
+  for (int i = 0; i < count_ && slot < buffer[0]; ++i) {
+    if (fds_[i] < 0) continue;
+    values_[i] += static_cast<uint64_t>(scale * buffer[3 + slot]);
+    ++slot;
+  }
+  #endif
+}
+
+void PerfCounterGroup::Reset() {
+  for (int i = 0; i < count_; ++i) values_[i] = 0;
+}
+
+double PerfCounterGroup::value(const PerfEvent event) const {
+  for (int i = 0; i < count_; ++i) {
+    if (events_[i] == event && fds_[i] >= 0) return values_[i];
+  }
+  return -1;
+}
+
+PerfCounters::PerfCounters()
+    : core_(kCoreEvents, sizeof(kCoreEvents)/sizeof(PerfEvent)),
+      cache_(kCacheEvents, sizeof(kCacheEvents)/sizeof(PerfEvent)) {}
+
+double PerfCounters::value(const PerfEvent event) const {
+  if (core_.available(event)) return core_.value(event);
+  return cache_.value(event);
+}
+
+double PerfCounters::Ipc() const {
+  const double cycles = value(kPerfCycles);
+  const double instructions = value(kPerfInstructions);
+  if (cycles <= 0 || instructions < 0) return -1;
+  return instructions / cycles;
+}
+
+char const* PerfCounters::label(const PerfEvent event) {
+  static char const *const labels[] = {
+    "cycles",
+    "instructions",
+    "branch_misses",
+    "l1_misses",
+    "llc_misses"
+  };
+  return labels[event];
+}
+
+PerfSample PerfSample::Create(PerfCounters const &counters,
+                              const double calls) {
+  PerfSample sample;
+  for (int i = 0; i < kPerfEventCount; ++i) {
+    const double value = counters.value(static_cast<PerfEvent>(i));
+    sample.per_call[i] = (value < 0 || calls <= 0) ? -1 : value / calls;
+  }
+  sample.ipc = counters.Ipc();
+  return sample;
+}
+
+std::ostream& operator<<(std::ostream &os, PerfSample const &sample) {
+  bool first = true;
+  if (sample.ipc >= 0) {
+    os << "IPC " << sample.ipc;
+    first = false;
+  }
+  for (int i = kPerfBranchMisses; i < kPerfEventCount; ++i) {
+    if (sample.per_call[i] < 0) continue;
+    if (!first) os << ", ";
+    os << sample.per_call[i] << " "
+       << PerfCounters::label(static_cast<PerfEvent>(i)) << "/call";
+    first = false;
+  }
+  return os;
+}
+
+void PerfSample::PrintJson(std::ostream &os) const {
+  os << ", \"ipc\": ";
+  if (ipc >= 0) os << ipc; else os << "null";
+  for (int i = 0; i < kPerfEventCount; ++i) {
+    os << ", \"" << PerfCounters::label(static_cast<PerfEvent>(i))
+       << "_per_call\": ";
+    if (per_call[i] >= 0) os << per_call[i]; else os << "null";
+  }
+}
+
+} // End namespace vecgeom
\ No newline at end of file
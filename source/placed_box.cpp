@@ -1,4 +1,6 @@
 #include "backend/scalar_backend.h"
+#include "base/instrumentation.h"
+#include "management/isa_dispatch.h"
 #include "volumes/placed_box.h"
 #ifdef VECGEOM_CUDA
 #include "backend/cuda_backend.cuh"
@@ -12,6 +14,7 @@ namespace vecgeom {
 
 VECGEOM_CUDA_HEADER_BOTH
 bool PlacedBox::Inside(Vector3D<Precision> const &point) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelInside, id(), 1);
   return PlacedBox::template InsideTemplate<1, 0, kScalar>(point);
 }
 
@@ -19,6 +22,7 @@ VECGEOM_CUDA_HEADER_BOTH
 Precision PlacedBox::DistanceToIn(Vector3D<Precision> const &position,
                                   Vector3D<Precision> const &direction,
                                   const Precision step_max) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelDistanceToIn, id(), 1);
   return PlacedBox::template DistanceToInTemplate<1, 0, kScalar>(position,
                                                                  direction,
                                                                  step_max);
@@ -27,20 +31,95 @@ Precision PlacedBox::DistanceToIn(Vector3D<Precision> const &position,
 VECGEOM_CUDA_HEADER_BOTH
 Precision PlacedBox::DistanceToOut(Vector3D<Precision> const &position,
                                    Vector3D<Precision> const &direction) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelDistanceToOut, id(), 1);
+  Precision output;
+  BoxDistanceToOut<kScalar>(
+    AsUnplacedBox()->dimensions(),
+    position,
+    direction,
+    &output
+  );
+  return output;
+}
 
-  Vector3D<Precision> const &dim = AsUnplacedBox()->dimensions();
+VECGEOM_CUDA_HEADER_BOTH
+Precision PlacedBox::DistanceToOut(Vector3D<Precision> const &position,
+                                   Vector3D<Precision> const &direction,
+                                   int *const face) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelDistanceToOut, id(), 1);
+  Precision output, exit_face;
+  BoxDistanceToOut<kScalar>(AsUnplacedBox()->dimensions(), position,
+                            direction, &output, &exit_face);
+  *face = static_cast<int>(exit_face);
+  return output;
+}
 
-  const Vector3D<Precision> safety_plus  = dim + position;
-  const Vector3D<Precision> safety_minus = dim - position;
+VECGEOM_CUDA_HEADER_BOTH
+Precision PlacedBox::SafetyToIn(Vector3D<Precision> const &position) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelSafetyToIn, id(), 1);
+  return PlacedBox::template SafetyToInTemplate<1, 0, kScalar>(position);
+}
 
-  Vector3D<Precision> distance = safety_minus;
-  const Vector3D<bool> direction_plus = direction < 0.0;
-  distance.MaskedAssign(direction_plus, safety_plus);
+VECGEOM_CUDA_HEADER_BOTH
+Precision PlacedBox::SafetyToOut(Vector3D<Precision> const &position) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelSafetyToOut, id(), 1);
+  Precision output;
+  BoxSafetyToOut<kScalar>(AsUnplacedBox()->dimensions(), position, &output);
+  return output;
+}
 
-  distance /= direction;
+void PlacedBox::Inside(SOA3D<Precision> const &points,
+                       bool *const output) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelInsideBasket, id(),
+                     points.size());
+  #ifdef VECGEOM_ISA_DISPATCH
+  if (BoxBasketKernels::InsideKernel kernel =
+          IsaDispatch::Instance().box().inside) {
+    kernel(AsUnplacedBox()->dimensions(), *matrix(), points, output);
+    return;
+  }
+  #endif
+  InsideBasket<1, 0>(points, output);
+}
+
+void PlacedBox::DistanceToIn(SOA3D<Precision> const &positions,
+                             SOA3D<Precision> const &directions,
+                             Precision const *const step_max,
+                             Precision *const output) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelDistanceToInBasket, id(),
+                     positions.size());
+  #ifdef VECGEOM_ISA_DISPATCH
+  if (BoxBasketKernels::DistanceToInKernel kernel =
+          IsaDispatch::Instance().box().distance_to_in) {
+    kernel(AsUnplacedBox()->dimensions(), *matrix(), positions, directions,
+           step_max, output);
+    return;
+  }
+  #endif
+  DistanceToInBasket<1, 0>(positions, directions, step_max, output);
+}
 
-  const Precision min = distance.Min();
-  return (min < 0) ? 0 : min;
+void PlacedBox::DistanceToOut(SOA3D<Precision> const &positions,
+                              SOA3D<Precision> const &directions,
+                              Precision *const output) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelDistanceToOutBasket, id(),
+                     positions.size());
+  #ifdef VECGEOM_ISA_DISPATCH
+  if (BoxBasketKernels::DistanceToOutKernel kernel =
+          IsaDispatch::Instance().box().distance_to_out) {
+    kernel(AsUnplacedBox()->dimensions(), positions, directions, output);
+    return;
+  }
+  #endif
+  #ifdef VECGEOM_VECTOR_BACKEND
+  BoxDistanceToOutBasket<kVectorImpl>(AsUnplacedBox()->dimensions(),
+                                      positions, directions, output);
+  #else
+  for (int i = 0, i_max = positions.size(); i < i_max; ++i) {
+    BoxDistanceToOut<kScalar>(AsUnplacedBox()->dimensions(), positions[i],
+                              directions[i], &output[i]);
+  }
+  #endif
 }
 
 #ifdef VECGEOM_CUDA
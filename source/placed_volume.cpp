@@ -2,6 +2,12 @@
 
 namespace vecgeom {
 
+VPlacedVolume::~VPlacedVolume() {
+  #ifndef VECGEOM_NVCC
+  GeoManager::Instance().DeregisterVolume(this);
+  #endif
+}
+
 VECGEOM_CUDA_HEADER_HOST
 std::ostream& operator<<(std::ostream& os, VPlacedVolume const &vol) {
   os << "(" << vol.unplaced_volume() << ", " << vol.matrix() << ")";
@@ -0,0 +1,88 @@
+#include "volumes/replica_placement.h"
+
+#include <cmath>
+#include "backend/scalar_backend.h"
+#include "volumes/kernel/box_kernel.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+ReplicaPlacement::ReplicaPlacement(Vector3D<Precision> const &dimensions,
+                                   const ReplicaAxis axis, const int copies,
+                                   const Precision pitch,
+                                   const Precision offset)
+    : axis_(axis), copies_(copies), pitch_(pitch), offset_(offset),
+      start_(offset - 0.5*copies*pitch), envelope_(dimensions), cell_(NULL) {
+  envelope_[axis] = 0.5*copies*pitch;
+  Vector3D<Precision> center(0, 0, 0);
+  center[axis] = offset;
+  envelope_matrix_.SetTranslation(center);
+}
+
+TransformationMatrix ReplicaPlacement::Matrix(const int copy) const {
+  Vector3D<Precision> center(0, 0, 0);
+  center[axis_] = Center(copy);
+  TransformationMatrix matrix;
+  matrix.SetTranslation(center);
+  return matrix;
+}
+
+int ReplicaPlacement::Index(Vector3D<Precision> const &point) const {
+  return static_cast<int>(std::floor((point[axis_] - start_) / pitch_));
+}
+
+int ReplicaPlacement::Locate(Vector3D<Precision> const &point) const {
+  const int index = Index(point);
+  if (index < 0 || index >= copies_) return -1;
+  return (cell_->Inside(ToCopy(point, index))) ? index : -1;
+}
+
+void ReplicaPlacement::DistanceToIn(Vector3D<Precision> const &point,
+                                    Vector3D<Precision> const &direction,
+                                    Precision *const step,
+                                    int *const copy) const {
+  if (SafetyToIn(point) > 0) {
+    Precision entry;
+    BoxDistanceToIn<translation::kTranslation, rotation::kIdentity, kScalar>(
+      envelope_, envelope_matrix_, point, direction, *step, &entry
+    );
+    if (!(entry < *step)) return;
+    // The entry point can be rounded just outside the envelope
+    int index = Index(point + direction*entry);
+    if (index < 0) index = 0;
+    if (index >= copies_) index = copies_ - 1;
+    *step = entry;
+    *copy = index;
+    return;
+  }
+  // Points on the boundary between two copies are inside the envelope but
+  // outside all copies, and enter the copy ahead of the closest boundary
+  const Precision along = direction[axis_];
+  if (std::fabs(along) < kTiny) return;
+  const int boundary = static_cast<int>(
+    std::floor((point[axis_] - start_) / pitch_ + 0.5)
+  );
+  const int index = (along > 0) ? boundary : boundary - 1;
+  if (index < 0 || index >= copies_) return;
+  Precision distance = (start_ + boundary*pitch_ - point[axis_]) / along;
+  if (distance < 0) distance = 0;
+  if (!(distance < *step)) return;
+  // Points on the outer faces of the envelope can leave it before crossing
+  const Vector3D<Precision> crossing = point + direction*distance;
+  for (int i = 0; i < 3; ++i) {
+    if (i == axis_) continue;
+    if (std::fabs(crossing[i]) > envelope_[i] + kGTolerance) return;
+  }
+  *step = distance;
+  *copy = index;
+}
+
+Precision ReplicaPlacement::SafetyToIn(Vector3D<Precision> const &point) const {
+  Precision safety;
+  BoxSafetyToIn<translation::kTranslation, rotation::kIdentity, kScalar>(
+    envelope_, envelope_matrix_, point, &safety
+  );
+  return safety;
+}
+
+} // End namespace vecgeom
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "navigation/simple_navigator.h"
+#include "navigation/daughter_bounds.h"
+#include "navigation/face_neighbors.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+const Precision SimpleNavigator::kPushDistance = 10*kGTolerance;
+
+SimpleNavigator::~SimpleNavigator() {
+  if (workspace_) _mm_free(workspace_);
+}
+
+Precision* SimpleNavigator::Workspace(const unsigned size) {
+  if (size > workspace_size_) {
+    if (workspace_) _mm_free(workspace_);
+    workspace_ = static_cast<Precision*>(
+      _mm_malloc(size*sizeof(Precision), kAlignmentBoundary)
+    );
+    workspace_size_ = size;
+  }
+  return workspace_;
+}
+
+VPlacedVolume const* SimpleNavigator::LocateDaughters(
+    Vector3D<Precision> &local_point,
+    NavigationState &state,
+    const bool track_local) const {
+  VPlacedVolume const *current = state.Top();
+  bool descended = true;
+  while (descended) {
+    LogicalVolume const *const logical = current->logical_volume();
+    VPlacedVolume const *daughter = NULL;
+    int copy = -1;
+    if (ReplicaPlacement const *const replica = logical->replica()) {
+      copy = replica->Locate(local_point);
+      if (copy >= 0) daughter = replica->cell();
+    } else if (ParametrisedPlacement const *const parametrisation =
+                   logical->parametrisation()) {
+      daughter = parametrisation->Locate(local_point);
+    } else {
+      Container<Daughter> const &daughters = logical->daughters();
+      for (Iterator<Daughter> i = daughters.begin(); i != daughters.end();
+           ++i) {
+        if ((*i)->Inside(local_point)) {
+          daughter = *i;
+          break;
+        }
+      }
+    }
+    descended = daughter != NULL;
+    if (descended) {
+      current = daughter;
+      state.Push(current, copy);
+      if (track_local) {
+        state.UpdateLocal();
+        local_point = state.LocalPoint(state.level());
+      } else {
+        local_point = current->matrix()->Transform<1, 0>(
+          state.ToPlacementFrame(state.level()-1, local_point)
+        );
+      }
+    }
+  }
+  return current;
+}
+
+VPlacedVolume const* SimpleNavigator::LocatePoint(
+    VPlacedVolume const *const volume,
+    Vector3D<Precision> const &point,
+    Vector3D<Precision> &local_point,
+    NavigationState &state) const {
+  if (global_bvh_ && global_bvh_->built() && volume == global_bvh_->world() &&
+      state.IsOutside()) {
+    return global_bvh_->LocatePoint(point, local_point, state);
+  }
+  if (!volume->Inside(point)) return NULL;
+  state.Push(volume);
+  local_point = volume->matrix()->Transform<1, 0>(point);
+  return LocateDaughters(local_point, state);
+}
+
+VPlacedVolume const* SimpleNavigator::Relocate(
+    Vector3D<Precision> const &global_point,
+    NavigationState &state) const {
+  while (!state.IsOutside()) {
+    const Vector3D<Precision> point = state.ToPlacementFrame(
+      state.level()-1, TransformToLevel(global_point, state, state.level()-1)
+    );
+    if (state.Top()->Inside(point)) break;
+    state.Pop();
+  }
+  if (state.IsOutside()) return NULL;
+  Vector3D<Precision> local_point =
+      TransformToLevel(global_point, state, state.level());
+  return LocateDaughters(local_point, state);
+}
+
+void SimpleNavigator::RelocateLocal(NavigationState &state) const {
+  while (!state.IsOutside()) {
+    if (state.Top()->Inside(state.ToPlacementFrame(
+          state.level()-1, state.LocalPoint(state.level()-1)))) {
+      break;
+    }
+    state.Pop();
+  }
+  if (state.IsOutside()) return;
+  Vector3D<Precision> local_point = state.LocalPoint(state.level());
+  LocateDaughters(local_point, state, true);
+}
+
+bool SimpleNavigator::EnterNeighbor(Vector3D<Precision> const &point,
+                                    const int face,
+                                    NavigationState &state,
+                                    const bool track_local) const {
+  LogicalVolume const *const mother =
+      state.At(state.level()-2)->logical_volume();
+  VPlacedVolume const *neighbor = NULL;
+  int copy = -1;
+  if (ReplicaPlacement const *const replica = mother->replica()) {
+    // Copies tile the envelope, so the copy entered follows from the point
+    copy = replica->Locate(point);
+    if (copy >= 0) neighbor = replica->cell();
+  } else {
+    FaceNeighbors const *const neighbors = mother->face_neighbors();
+    if (!neighbors) return false;
+    neighbor = neighbors->Neighbor(state.Top(), face);
+    // Daughters do not overlap, so a point inside the neighbor has left the
+    // top volume and is inside no other sibling
+    if (neighbor && !neighbor->Inside(point)) neighbor = NULL;
+  }
+  if (!neighbor) return false;
+  state.Pop();
+  state.Push(neighbor, copy);
+  Vector3D<Precision> local_point;
+  if (track_local) {
+    state.UpdateLocal();
+    local_point = state.LocalPoint(state.level());
+  } else {
+    local_point = neighbor->matrix()->Transform<1, 0>(
+      state.ToPlacementFrame(state.level()-1, point)
+    );
+  }
+  LocateDaughters(local_point, state, track_local);
+  return true;
+}
+
+Precision SimpleNavigator::FindNextBoundaryAndStep(
+    Vector3D<Precision> const &global_point,
+    Vector3D<Precision> const &global_dir,
+    NavigationState const &current_state,
+    NavigationState &next_state,
+    const Precision step_max) const {
+
+  next_state = current_state;
+  VPlacedVolume const *const current = current_state.Top();
+  if (!current) return kInfinity;
+  // The pushed end point must stay within the safety, or it may lie beyond a
+  // boundary the step ends on
+  if (step_max + kPushDistance < current_state.RemainingSafety(global_point)) {
+    if (next_state.MatchesGlobal(global_point, global_dir)) {
+      next_state.AdvanceLocal(step_max + kPushDistance);
+    }
+    return step_max;
+  }
+
+  Vector3D<Precision> local_point, local_dir;
+  GlobalTransform const *const transform =
+      (transform_cache_ && !next_state.tracks_local())
+      ? transform_cache_->Lookup(current_state) : NULL;
+  const bool track_local = next_state.SetGlobal(global_point, global_dir);
+  if (track_local) {
+    next_state.UpdateLocal();
+    local_point = next_state.LocalPoint(next_state.level());
+    local_dir = next_state.LocalDirection(next_state.level());
+  } else if (transform) {
+    local_point = transform->Transform(global_point);
+    local_dir = transform->TransformDirection(global_dir);
+  } else {
+    local_point = current_state.GlobalToLocal(global_point);
+    local_dir = current_state.GlobalToLocalDirection(global_dir);
+  }
+
+  int face = -1;
+  Precision step = (neighbor_lookup_)
+                   ? current->DistanceToOut(local_point, local_dir, &face)
+                   : current->DistanceToOut(local_point, local_dir);
+  bool leaving = true;
+  if (step > step_max) {
+    step = step_max;
+    leaving = false;
+  }
+  VPlacedVolume const *hit = NULL;
+  int hit_copy = -1;
+  LogicalVolume const *const logical = current->logical_volume();
+  Container<Daughter> const &daughters = logical->daughters();
+  DaughterBounds const *const bounds = logical->daughter_bounds();
+  ReplicaPlacement const *const replica = logical->replica();
+  if (replica) {
+    replica->DistanceToIn(local_point, local_dir, &step, &hit_copy);
+    if (hit_copy >= 0) hit = replica->cell();
+  } else if (ParametrisedPlacement const *const parametrisation =
+                 logical->parametrisation()) {
+    parametrisation->DistanceToIn(local_point, local_dir, &step, &hit);
+  } else if (culling_ && bounds) {
+    Precision lower_bounds[DaughterBounds::kChunkSize];
+    int index = 0;
+    for (Iterator<Daughter> i = daughters.begin(); i != daughters.end();
+         ++i, ++index) {
+      const int lane = index % DaughterBounds::kChunkSize;
+      if (!lane) {
+        bounds->DistanceToIn(local_point, local_dir, index, lower_bounds);
+      }
+      if (lower_bounds[lane] >= step) continue;
+      const Precision distance =
+          (*i)->DistanceToIn(local_point, local_dir, step);
+      if (distance < step) {
+        step = distance;
+        hit = *i;
+      }
+    }
+  } else {
+    for (Iterator<Daughter> i = daughters.begin(); i != daughters.end();
+         ++i) {
+      const Precision distance =
+          (*i)->DistanceToIn(local_point, local_dir, step);
+      if (distance < step) {
+        step = distance;
+        hit = *i;
+      }
+    }
+  }
+
+  if (track_local) next_state.AdvanceLocal(step + kPushDistance);
+  if (hit) {
+    Vector3D<Precision> point = local_point + local_dir*(step + kPushDistance);
+    if (hit_copy >= 0) point = replica->ToCopy(point, hit_copy);
+    if (hit->Inside(point)) {
+      next_state.Push(hit, hit_copy);
+      if (track_local) {
+        next_state.UpdateLocal();
+        point = next_state.LocalPoint(next_state.level());
+      } else {
+        point = hit->matrix()->Transform<1, 0>(point);
+      }
+      LocateDaughters(point, next_state, track_local);
+      return step;
+    }
+  } else if (!leaving) {
+    if (safety_caching_) {
+      next_state.SetSafety(global_point, Safety(current, local_point));
+    }
+    return step;
+  }
+  if (!hit && face >= 0 && next_state.level() > 1) {
+    const int mother_level = next_state.level() - 1;
+    const Vector3D<Precision> point = (track_local)
+        ? next_state.LocalPoint(mother_level)
+        : TransformToLevel(global_point + global_dir*(step + kPushDistance),
+                           next_state, mother_level);
+    if (EnterNeighbor(point, face, next_state, track_local)) return step;
+  }
+  if (track_local) {
+    RelocateLocal(next_state);
+  } else {
+    Relocate(global_point + global_dir*(step + kPushDistance), next_state);
+  }
+  return step;
+}
+
+Precision SimpleNavigator::Safety(
+    VPlacedVolume const *const volume,
+    Vector3D<Precision> const &local_point) const {
+  Precision safety = volume->SafetyToOut(local_point);
+  LogicalVolume const *const logical = volume->logical_volume();
+  if (ReplicaPlacement const *const replica = logical->replica()) {
+    const Precision safety_replica = replica->SafetyToIn(local_point);
+    if (safety_replica < safety) safety = safety_replica;
+    return (safety > 0) ? safety : 0;
+  }
+  if (ParametrisedPlacement const *const parametrisation =
+          logical->parametrisation()) {
+    const Precision safety_copies = parametrisation->SafetyToIn(local_point);
+    if (safety_copies < safety) safety = safety_copies;
+    return (safety > 0) ? safety : 0;
+  }
+  Container<Daughter> const &daughters = logical->daughters();
+  for (Iterator<Daughter> i = daughters.begin(); i != daughters.end(); ++i) {
+    const Precision safety_daughter = (*i)->SafetyToIn(local_point);
+    if (safety_daughter < safety) safety = safety_daughter;
+  }
+  return (safety > 0) ? safety : 0;
+}
+
+Precision SimpleNavigator::ComputeSafety(
+    Vector3D<Precision> const &global_point,
+    NavigationState &state) const {
+  VPlacedVolume const *const current = state.Top();
+  if (!current) return 0;
+  const Precision safety =
+      Safety(current, TransformToLevel(global_point, state, state.level()));
+  state.SetSafety(global_point, safety);
+  return safety;
+}
+
+void SimpleNavigator::FindNextBoundary(
+    VPlacedVolume const *const volume,
+    SOA3D<Precision> const &points,
+    SOA3D<Precision> const &directions,
+    Precision const *const step_max,
+    Precision *const steps,
+    VPlacedVolume const **const next_volumes) {
+
+  const unsigned size = points.size();
+  Precision *const distances = Workspace(size);
+
+  volume->DistanceToOut(points, directions, steps);
+  for (unsigned i = 0; i < size; ++i) {
+    if (steps[i] > step_max[i]) steps[i] = step_max[i];
+    next_volumes[i] = NULL;
+  }
+
+  // Rays enter copies of a replica at analytic distances, and all copies
+  // report the placement they share
+  if (ReplicaPlacement const *const replica =
+          volume->logical_volume()->replica()) {
+    for (unsigned i = 0; i < size; ++i) {
+      int copy = -1;
+      replica->DistanceToIn(points[i], directions[i], &steps[i], &copy);
+      if (copy >= 0) next_volumes[i] = replica->cell();
+    }
+    return;
+  }
+
+  Container<Daughter> const &daughters = volume->logical_volume()->daughters();
+  for (Iterator<Daughter> d = daughters.begin(); d != daughters.end(); ++d) {
+    (*d)->DistanceToIn(points, directions, steps, distances);
+    for (unsigned i = 0; i < size; ++i) {
+      if (distances[i] < steps[i]) {
+        steps[i] = distances[i];
+        next_volumes[i] = *d;
+      }
+    }
+  }
+}
+
+} // End namespace vecgeom
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "management/thread_pool.h"
+
+namespace vecgeom {
+
+namespace {
+
+/**
+ * Set while a thread processes chunks, so nested calls run serially instead
+ * of waiting for workers that are busy with the outer call.
+ */
+thread_local bool in_pool = false;
+
+} // End anonymous namespace
+
+ThreadPool::ThreadPool(const int threads)
+    : generation_(0), running_(0), stop_(false), task_(NULL), chunks_(0),
+      schedule_(kScheduleDynamic), next_chunk_(0) {
+  int count = threads;
+  if (count < 1) count = std::thread::hardware_concurrency();
+  if (count < 1) count = 1;
+  for (int t = 1; t < count; ++t) {
+    workers_.push_back(std::thread(&ThreadPool::Work, this, t));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (unsigned t = 0; t < workers_.size(); ++t) workers_[t].join();
+}
+
+bool ThreadPool::InTask() { return in_pool; }
+
+ThreadPool& ThreadPool::Instance() {
+  static ThreadPool instance;
+  return instance;
+}
+
+void ThreadPool::Run(const int chunks, Task const &task,
+                     const Schedule schedule) {
+  if (chunks <= 0) return;
+  if (in_pool || workers_.empty() || chunks == 1) {
+    for (int i = 0; i < chunks; ++i) task(i);
+    return;
+  }
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    chunks_ = chunks;
+    schedule_ = schedule;
+    next_chunk_.store(0, std::memory_order_relaxed);
+    running_ = workers_.size();
+    ++generation_;
+  }
+  start_.notify_all();
+  Process(0);
+  std::unique_lock<std::mutex> lock(mutex_);
+  finish_.wait(lock, [this]() { return running_ == 0; });
+  task_ = NULL;
+}
+
+void ThreadPool::Work(const int thread) {
+  unsigned seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+    }
+    Process(thread);
+    bool last;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      last = (--running_ == 0);
+    }
+    if (last) finish_.notify_one();
+  }
+}
+
+void ThreadPool::Process(const int thread) {
+  in_pool = true;
+  if (schedule_ == kScheduleStatic) {
+    const int count = threads();
+    const int begin = (static_cast<long>(thread) * chunks_) / count;
+    const int end = (static_cast<long>(thread + 1) * chunks_) / count;
+    for (int i = begin; i < end; ++i) (*task_)(i);
+  } else {
+    for (int i = next_chunk_++; i < chunks_; i = next_chunk_++) (*task_)(i);
+  }
+  in_pool = false;
+}
+
+} // End namespace vecgeom
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include "navigation/track_scheduler.h"
+
+#include <thread>
+#include "base/soa3d.h"
+#include "management/thread_pool.h"
+#include "navigation/simple_navigator.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+BasketDeque::BasketDeque(const int capacity) : top_(0), bottom_(0) {
+  long size = 1;
+  while (size < capacity) size <<= 1;
+  std::vector<std::atomic<TrackBasket*> > buffer(size);
+  buffer_.swap(buffer);
+  mask_ = size - 1;
+}
+
+void BasketDeque::Push(TrackBasket *const basket) {
+  const long bottom = bottom_.load(std::memory_order_relaxed);
+  buffer_[bottom & mask_].store(basket, std::memory_order_relaxed);
+  // Publishes the basket and the tracks it refers to to stealing threads
+  bottom_.store(bottom + 1, std::memory_order_release);
+}
+
+TrackBasket* BasketDeque::Pop() {
+  const long bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  bottom_.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  long top = top_.load(std::memory_order_relaxed);
+  if (top > bottom) {
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return NULL;
+  }
+  TrackBasket *basket =
+      buffer_[bottom & mask_].load(std::memory_order_relaxed);
+  if (top == bottom) {
+    // Last basket, which a thief might be taking concurrently
+    if (!top_.compare_exchange_strong(top, top + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      basket = NULL;
+    }
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return basket;
+}
+
+TrackBasket* BasketDeque::Steal() {
+  long top = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const long bottom = bottom_.load(std::memory_order_acquire);
+  if (top >= bottom) return NULL;
+  TrackBasket *const basket =
+      buffer_[top & mask_].load(std::memory_order_acquire);
+  if (!top_.compare_exchange_strong(top, top + 1,
+                                    std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return NULL;
+  }
+  return basket;
+}
+
+/**
+ * State of one thread taking part in transport. Holds the partially filled
+ * baskets per volume and the workspace of the basket navigation.
+ */
+class TransportWorker {
+
+private:
+
+  TrackScheduler &scheduler_;
+  std::vector<BasketDeque*> const &deques_;
+  const int index_;
+  std::vector<TrackBasket*> partial_;
+  std::vector<TrackBasket*> spare_;
+  SimpleNavigator navigator_;
+  SOA3D<Precision> points_, directions_;
+  std::vector<Precision> step_max_, steps_;
+  std::vector<VPlacedVolume const*> next_volumes_;
+
+public:
+
+  TrackScheduler::Statistics statistics;
+
+  TransportWorker(TrackScheduler &scheduler,
+                  std::vector<BasketDeque*> const &deques, const int index)
+      : scheduler_(scheduler), deques_(deques), index_(index),
+        partial_(scheduler.volume_index_.size(), NULL),
+        points_(scheduler.basket_size_),
+        directions_(scheduler.basket_size_),
+        step_max_(scheduler.basket_size_, kInfinity),
+        steps_(scheduler.basket_size_),
+        next_volumes_(scheduler.basket_size_) {
+    statistics.baskets = 0;
+    statistics.steps = 0;
+    statistics.steals = 0;
+    statistics.flushes = 0;
+  }
+
+  ~TransportWorker() {
+    for (unsigned i = 0; i < partial_.size(); ++i) delete partial_[i];
+    for (unsigned i = 0; i < spare_.size(); ++i) delete spare_[i];
+  }
+
+  void Run() {
+    const int workers = deques_.size();
+    for (int i = index_, i_max = scheduler_.track_count(); i < i_max;
+         i += workers) {
+      if (scheduler_.Active(i)) Add(i);
+    }
+    while (scheduler_.alive_.load(std::memory_order_acquire) > 0) {
+      TrackBasket *const basket = Find();
+      if (basket) {
+        Process(basket);
+      } else if (!Flush()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+private:
+
+  TransportWorker(TransportWorker const&);
+  TransportWorker& operator=(TransportWorker const&);
+
+  /**
+   * Adds a track to the basket of its current volume, emitting the basket
+   * when full.
+   */
+  void Add(const int track) {
+    const int volume = scheduler_.volume_index_.find(
+      scheduler_.states_[track].Top()->logical_volume()
+    )->second;
+    TrackBasket *&basket = partial_[volume];
+    if (!basket) {
+      basket = NewBasket();
+      basket->volume = volume;
+    }
+    basket->tracks.push_back(track);
+    if (static_cast<int>(basket->tracks.size()) >= scheduler_.basket_size_) {
+      deques_[index_]->Push(basket);
+      basket = NULL;
+    }
+  }
+
+  TrackBasket* NewBasket() {
+    if (spare_.empty()) {
+      TrackBasket *const basket = new TrackBasket;
+      basket->tracks.reserve(scheduler_.basket_size_);
+      return basket;
+    }
+    TrackBasket *const basket = spare_.back();
+    spare_.pop_back();
+    return basket;
+  }
+
+  /**
+   * Pops a basket of this worker, or steals one from the others.
+   */
+  TrackBasket* Find() {
+    TrackBasket *basket = deques_[index_]->Pop();
+    if (basket) return basket;
+    const int workers = deques_.size();
+    for (int i = 1; i < workers; ++i) {
+      basket = deques_[(index_ + i) % workers]->Steal();
+      if (basket) {
+        ++statistics.steals;
+        return basket;
+      }
+    }
+    return NULL;
+  }
+
+  /**
+   * Emits all partially filled baskets.
+   * \return Whether any basket was emitted.
+   */
+  bool Flush() {
+    bool flushed = false;
+    for (unsigned i = 0; i < partial_.size(); ++i) {
+      if (!partial_[i]) continue;
+      deques_[index_]->Push(partial_[i]);
+      partial_[i] = NULL;
+      ++statistics.flushes;
+      flushed = true;
+    }
+    return flushed;
+  }
+
+  /**
+   * Steps all tracks of a basket to their next boundary and adds them to the
+   * baskets of the volumes they enter.
+   */
+  void Process(TrackBasket *const basket) {
+    std::vector<int> const &tracks = basket->tracks;
+    const int count = tracks.size();
+    std::vector<NavigationState> &states = scheduler_.states_;
+    std::vector<Vector3D<Precision> > &positions = scheduler_.positions_;
+    std::vector<Vector3D<Precision> > const &directions =
+        scheduler_.directions_;
+    for (int j = 0; j < count; ++j) {
+      const int i = tracks[j];
+      points_.Set(j, states[i].GlobalToLocal(positions[i]));
+      directions_.Set(j, states[i].GlobalToLocalDirection(directions[i]));
+    }
+    const SOA3D<Precision> points(points_.x(), points_.y(), points_.z(),
+                                  count);
+    const SOA3D<Precision> dirs(directions_.x(), directions_.y(),
+                                directions_.z(), count);
+    navigator_.FindNextBoundary(states[tracks[0]].Top(), points, dirs,
+                                &step_max_[0], &steps_[0],
+                                &next_volumes_[0]);
+    int finished = 0;
+    for (int j = 0; j < count; ++j) {
+      const int i = tracks[j];
+      positions[i] += directions[i]
+                      * (steps_[j] + SimpleNavigator::kPushDistance);
+      scheduler_.lengths_[i] += steps_[j];
+      ++scheduler_.steps_[i];
+      navigator_.Relocate(positions[i], states[i]);
+      if (scheduler_.Active(i)) {
+        Add(i);
+      } else {
+        ++finished;
+      }
+    }
+    ++statistics.baskets;
+    statistics.steps += count;
+    basket->tracks.clear();
+    spare_.push_back(basket);
+    if (finished) {
+      scheduler_.alive_.fetch_sub(finished, std::memory_order_acq_rel);
+    }
+  }
+
+};
+
+TrackScheduler::TrackScheduler(VPlacedVolume const *const world,
+                               const int max_level)
+    : world_(world), max_level_(max_level), threads_(1), basket_size_(16),
+      max_steps_(1000), alive_(0) {
+  set_threads(0);
+  IndexVolumes(world->logical_volume());
+  statistics_.baskets = 0;
+  statistics_.steps = 0;
+  statistics_.steals = 0;
+  statistics_.flushes = 0;
+}
+
+void TrackScheduler::set_threads(const int threads) {
+  threads_ = threads;
+  if (threads_ < 1) threads_ = std::thread::hardware_concurrency();
+  if (threads_ < 1) threads_ = 1;
+}
+
+void TrackScheduler::IndexVolumes(LogicalVolume const *const volume) {
+  if (volume_index_.count(volume)) return;
+  const int index = volume_index_.size();
+  volume_index_[volume] = index;
+  Container<Daughter> const &daughters = volume->daughters();
+  for (Iterator<Daughter> i = daughters.begin(); i != daughters.end(); ++i) {
+    IndexVolumes((*i)->logical_volume());
+  }
+}
+
+int TrackScheduler::AddTrack(Vector3D<Precision> const &position,
+                             Vector3D<Precision> const &direction) {
+  positions_.push_back(position);
+  directions_.push_back(direction);
+  states_.push_back(NavigationState(max_level_));
+  steps_.push_back(0);
+  lengths_.push_back(0);
+  Vector3D<Precision> local;
+  SimpleNavigator().LocatePoint(world_, position, local, states_.back());
+  return positions_.size() - 1;
+}
+
+bool TrackScheduler::Active(const int track) const {
+  return !states_[track].IsOutside() && steps_[track] < max_steps_;
+}
+
+void TrackScheduler::Transport() {
+  long alive = 0;
+  for (int i = 0, i_max = track_count(); i < i_max; ++i) alive += Active(i);
+  alive_.store(alive);
+
+  // Within a pool task the workers would be run one after another, with the
+  // first waiting forever on tracks held by the others, so a single worker
+  // transports all tracks instead
+  const int threads = ThreadPool::InTask() ? 1 : threads_;
+  std::vector<BasketDeque*> deques(threads);
+  std::vector<TransportWorker*> workers(threads);
+  for (int t = 0; t < threads; ++t) {
+    deques[t] = new BasketDeque(track_count() + 1);
+  }
+  for (int t = 0; t < threads; ++t) {
+    workers[t] = new TransportWorker(*this, deques, t);
+  }
+
+  if (threads == 1) {
+    workers[0]->Run();
+  } else {
+    ThreadPool pool(threads);
+    pool.Run(threads, [&](const int t) { workers[t]->Run(); },
+             kScheduleStatic);
+  }
+
+  statistics_.baskets = 0;
+  statistics_.steps = 0;
+  statistics_.steals = 0;
+  statistics_.flushes = 0;
+  for (int t = 0; t < threads; ++t) {
+    statistics_.baskets += workers[t]->statistics.baskets;
+    statistics_.steps += workers[t]->statistics.steps;
+    statistics_.steals += workers[t]->statistics.steals;
+    statistics_.flushes += workers[t]->statistics.flushes;
+    delete workers[t];
+    delete deques[t];
+  }
+}
+
+void TrackScheduler::PrintStatistics(std::ostream &os) const {
+  os << "Transported " << track_count() << " tracks on " << threads_
+     << " threads: " << statistics_.steps << " steps in "
+     << statistics_.baskets << " baskets of " << statistics_.mean_basket_size()
+     << " tracks on average, " << statistics_.flushes
+     << " partial baskets, " << statistics_.steals << " steals.\n";
+}
+
+} // End namespace vecgeom
\ No newline at end of file
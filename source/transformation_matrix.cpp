@@ -110,6 +110,37 @@ void TransformationMatrix::SetRotation(
   SetProperties();
 }
 
+VECGEOM_CUDA_HEADER_BOTH
+void TransformationMatrix::MultiplyFromRight(TransformationMatrix const &rhs) {
+  if (rhs.identity) return;
+  // The translation of rhs is given in the local frame of this matrix
+  if (rhs.has_translation) {
+    if (has_rotation) {
+      for (int i = 0; i < 3; ++i) {
+        trans[i] += rot[3*i]*rhs.trans[0] + rot[3*i+1]*rhs.trans[1]
+                    + rot[3*i+2]*rhs.trans[2];
+      }
+    } else {
+      for (int i = 0; i < 3; ++i) trans[i] += rhs.trans[i];
+    }
+  }
+  if (rhs.has_rotation) {
+    if (has_rotation) {
+      Precision product[9];
+      for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+          product[3*i+j] = rot[3*i]*rhs.rot[j] + rot[3*i+1]*rhs.rot[3+j]
+                           + rot[3*i+2]*rhs.rot[6+j];
+        }
+      }
+      for (int i = 0; i < 9; ++i) rot[i] = product[i];
+    } else {
+      for (int i = 0; i < 9; ++i) rot[i] = rhs.rot[i];
+    }
+  }
+  SetProperties();
+}
+
 VECGEOM_CUDA_HEADER_BOTH
 RotationCode TransformationMatrix::GenerateRotationCode() const {
   int code = 0;
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <new>
 #include "volumes/unplaced_box.h"
 #include "management/volume_factory.h"
 #include "volumes/specialized_box.h"
@@ -36,16 +37,27 @@ VUnplacedVolume* UnplacedBox::CopyToGpu() const {
 template <TranslationCode trans_code, RotationCode rot_code>
 VPlacedVolume* UnplacedBox::Create(
     LogicalVolume const *const logical_volume,
-    TransformationMatrix const *const matrix) {
+    TransformationMatrix const *const matrix,
+    VPlacedVolume *const placement) {
+  // Allows constructing any specialization into storage sized for the base
+  // class, as parametrised placements do
+  static_assert(sizeof(SpecializedBox<trans_code, rot_code>)
+                == sizeof(PlacedBox),
+                "Specialized boxes must not add members to PlacedBox.");
+  if (placement) {
+    return new(placement) SpecializedBox<trans_code, rot_code>(logical_volume,
+                                                               matrix);
+  }
   return new SpecializedBox<trans_code, rot_code>(logical_volume, matrix);
 }
 
 VPlacedVolume* UnplacedBox::SpecializedVolume(
     LogicalVolume const *const volume,
     TransformationMatrix const *const matrix,
-    const TranslationCode trans_code, const RotationCode rot_code) const {
+    const TranslationCode trans_code, const RotationCode rot_code,
+    VPlacedVolume *const placement) const {
   return VolumeFactory::Instance().CreateByTransformation<UnplacedBox>(
-           volume, matrix, trans_code, rot_code
+           volume, matrix, trans_code, rot_code, placement
          );
 }
 
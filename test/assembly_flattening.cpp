@@ -0,0 +1,197 @@
+#include <stdlib.h>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "base/stopwatch.h"
+#include "management/geo_manager.h"
+#include "navigation/navigation_state.h"
+#include "navigation/simple_navigator.h"
+#include "test/navigation_test.h"
+#include "volumes/box.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+using namespace vecgeom;
+
+/**
+ * Builds a calorimeter of modules holding crystals through a chain of
+ * assemblies, once with the holders marked as assemblies and once as regular
+ * volumes, and checks that flattening the assemblies when closing the geometry
+ * locates points in the same crystals with fewer levels.
+ */
+int main() {
+
+  const int grid = 4;
+  const int crystals = 4;
+  const int tracks = 1<<12;
+
+  UnplacedBox world_params(100., 100., 100.);
+  UnplacedBox calorimeter_params(40., 40., 40.);
+  UnplacedBox module_params(9., 9., 40.);
+  UnplacedBox holder_params(9., 9., 38.);
+  UnplacedBox submodule_params(9., 4., 38.);
+  UnplacedBox crystal_params(2., 1.9, 35.);
+  TransformationMatrix origin;
+
+  LogicalVolume crystal(&crystal_params);
+  LogicalVolume world(&world_params), calorimeter(&calorimeter_params),
+                module(&module_params), holder(&holder_params),
+                submodule(&submodule_params);
+  LogicalVolume world_ref(&world_params),
+                calorimeter_ref(&calorimeter_params),
+                module_ref(&module_params), holder_ref(&holder_params),
+                submodule_ref(&submodule_params);
+  holder.set_assembly(true);
+  submodule.set_assembly(true);
+
+  std::vector<TransformationMatrix> crystal_matrices(crystals);
+  for (int i = 0; i < crystals; ++i) {
+    crystal_matrices[i].SetTranslation(-6.75 + 4.5*i, 0, 0);
+    submodule.PlaceDaughter(&crystal, &crystal_matrices[i]);
+    submodule_ref.PlaceDaughter(&crystal, &crystal_matrices[i]);
+  }
+  // The second submodule is turned around to exercise composed rotations
+  TransformationMatrix submodule_matrices[2] = {
+    TransformationMatrix(0, -4.5, 0),
+    TransformationMatrix(0, 4.5, 0, 180, 0, 0)
+  };
+  for (int i = 0; i < 2; ++i) {
+    holder.PlaceDaughter(&submodule, &submodule_matrices[i]);
+    holder_ref.PlaceDaughter(&submodule_ref, &submodule_matrices[i]);
+  }
+  TransformationMatrix holder_matrix(0, 0, 1.);
+  module.PlaceDaughter(&holder, &holder_matrix);
+  module_ref.PlaceDaughter(&holder_ref, &holder_matrix);
+  std::vector<TransformationMatrix> module_matrices(grid*grid);
+  for (int i = 0; i < grid*grid; ++i) {
+    module_matrices[i].SetTranslation(-30. + 20.*(i % grid),
+                                      -30. + 20.*(i / grid), 0);
+    if (i % 2) module_matrices[i].SetRotation(90, 0, 0);
+    calorimeter.PlaceDaughter(&module, &module_matrices[i]);
+    calorimeter_ref.PlaceDaughter(&module_ref, &module_matrices[i]);
+  }
+  world.PlaceDaughter(&calorimeter, &origin);
+  world_ref.PlaceDaughter(&calorimeter_ref, &origin);
+
+  VPlacedVolume const *const placed =
+      world_params.PlaceVolume(&world, &origin);
+  VPlacedVolume const *const placed_ref =
+      world_params.PlaceVolume(&world_ref, &origin);
+  GeoManager::Instance().set_flatten_assemblies(true);
+  GeoManager::Instance().CloseGeometry();
+
+  int mismatches = 0;
+
+  // The crystals are now placed directly in the module and remember the
+  // crystal they were copied from
+  if (module.daughters().size() != 2*crystals) ++mismatches;
+  for (Iterator<Daughter> i = module.daughters().begin();
+       i != module.daughters().end(); ++i) {
+    FlattenedOrigin const *const flattened =
+        GeoManager::Instance().Origin(*i);
+    if (!flattened || (*i)->logical_volume() != &crystal ||
+        GeoManager::Instance().volumes()[flattened->original]
+            ->logical_volume() != &crystal) {
+      ++mismatches;
+    }
+  }
+  if (module_ref.daughters().size() != 1) ++mismatches;
+
+  srand(1);
+  std::vector<Vector3D<Precision> > points(tracks), directions(tracks);
+  for (int i = 0; i < tracks; ++i) {
+    for (int j = 0; j < 3; ++j) points[i][j] = 40.*(2.*RandomUniform() - 1.);
+    directions[i] = RandomDirection();
+  }
+
+  SimpleNavigator navigator;
+  const int max_level = 6;
+  std::vector<NavigationState> states(tracks, NavigationState(max_level)),
+                               states_ref(tracks, NavigationState(max_level));
+  Stopwatch timer;
+  double elapsed[2];
+  elapsed[0] = LocateAll(navigator, placed, points, states);
+  elapsed[1] = LocateAll(navigator, placed_ref, points, states_ref);
+  int in_crystals = 0;
+  for (int i = 0; i < tracks; ++i) {
+    LogicalVolume const *const top = states[i].Top()->logical_volume();
+    LogicalVolume const *const top_ref =
+        states_ref[i].Top()->logical_volume();
+    if (top_ref == &crystal) {
+      // Crystals are two levels closer to the world
+      ++in_crystals;
+      const bool match = top == &crystal &&
+          states[i].level() == states_ref[i].level() - 2 &&
+          (states[i].GlobalToLocal(points[i])
+           - states_ref[i].GlobalToLocal(points[i])).Length() < 1e-9;
+      if (!match) ++mismatches;
+    } else if (top_ref == &holder_ref || top_ref == &submodule_ref) {
+      // Gaps of assemblies belong to their mother
+      if (top != &module) ++mismatches;
+    } else {
+      LogicalVolume const *const expected =
+          (top_ref == &world_ref) ? &world
+          : (top_ref == &calorimeter_ref) ? &calorimeter : &module;
+      if (top != expected) ++mismatches;
+    }
+  }
+  std::cout << "Locate: " << 1e9*elapsed[0]/tracks << " ns flattened, "
+            << 1e9*elapsed[1]/tracks << " ns with assemblies, "
+            << in_crystals << " of " << tracks << " points in crystals.\n";
+
+  // Tracks cross the same crystals in both geometries, so they must travel
+  // the same lengths through crystals and in total, and leave the world at
+  // the same point. The assemblies add boundaries to the reference, each
+  // step of which moves the track by an extra push distance.
+  std::vector<int> steps(2, 0);
+  std::vector<Precision> lengths[2], crystal_lengths[2];
+  std::vector<Vector3D<Precision> > exits[2];
+  NavigationState current(max_level), next(max_level);
+  for (int ref = 0; ref < 2; ++ref) {
+    lengths[ref].assign(tracks, 0);
+    crystal_lengths[ref].assign(tracks, 0);
+    exits[ref].resize(tracks);
+    timer.Start();
+    for (int i = 0; i < tracks; ++i) {
+      Vector3D<Precision> point = points[i];
+      current = (ref) ? states_ref[i] : states[i];
+      while (!current.IsOutside()) {
+        const Precision step = navigator.FindNextBoundaryAndStep(
+          point, directions[i], current, next, kInfinity
+        );
+        point += directions[i]*(step + SimpleNavigator::kPushDistance);
+        lengths[ref][i] += step;
+        if (current.Top()->logical_volume() == &crystal) {
+          crystal_lengths[ref][i] += step;
+        }
+        current = next;
+        ++steps[ref];
+      }
+      exits[ref][i] = point;
+    }
+    elapsed[ref] = timer.Stop();
+  }
+  for (int i = 0; i < tracks; ++i) {
+    const Precision tolerance = 1e-6;
+    if (std::fabs(lengths[0][i] - lengths[1][i]) > tolerance ||
+        std::fabs(crystal_lengths[0][i] - crystal_lengths[1][i]) > tolerance ||
+        (exits[0][i] - exits[1][i]).Length() > tolerance) {
+      ++mismatches;
+    }
+  }
+  if (steps[0] >= steps[1]) ++mismatches;
+  std::cout << "Transport: " << 1e9*elapsed[0]/tracks << " ns per track in "
+            << steps[0] << " steps flattened, " << 1e9*elapsed[1]/tracks
+            << " ns in " << steps[1] << " steps with assemblies.\n";
+
+  // Closing the geometry again keeps the flattened daughters and their
+  // origins
+  GeoManager::Instance().CloseGeometry();
+  if (module.daughters().size() != 2*crystals ||
+      !GeoManager::Instance().Origin(*module.daughters().begin())) {
+    ++mismatches;
+  }
+
+  std::cout << mismatches << " mismatches.\n";
+  return (mismatches == 0) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "base/vector3d.h"
+#include "base/soa3d.h"
+#include "base/specialized_matrix.h"
+#include "backend/avx512_backend.h"
+#include "volumes/kernel/box_kernel.h"
+#include "volumes/logical_volume.h"
+#include "volumes/box.h"
+
+using namespace vecgeom;
+
+int main() {
+  Avx512Precision scalar;
+  Vector3D<double> scalar_v;
+  Vector3D<Avx512Precision> vector_v;
+  SOA3D<Avx512Precision> soa;
+  TransformationMatrix matrix;
+  Avx512Bool output_inside;
+  Avx512Precision output_distance;
+  UnplacedBox world_unplaced = UnplacedBox(scalar_v);
+  UnplacedBox box_unplaced = UnplacedBox(scalar_v);
+  LogicalVolume world = LogicalVolume(&world_unplaced);
+  LogicalVolume box = LogicalVolume(&box_unplaced);
+  world.PlaceDaughter(&box, &matrix);
+  return 0;
+}
\ No newline at end of file
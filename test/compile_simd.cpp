@@ -1,7 +1,7 @@
 #include "base/vector3d.h"
 #include "base/soa3d.h"
 #include "base/specialized_matrix.h"
-#include "backend/cilk_backend.h"
+#include "backend/simd_backend.h"
 #include "volumes/kernel/box_kernel.h"
 #include "volumes/logical_volume.h"
 #include "volumes/box.h"
@@ -9,13 +9,13 @@
 using namespace vecgeom;
 
 int main() {
-  CilkPrecision scalar;
+  SimdPrecision scalar;
   Vector3D<double> scalar_v;
-  Vector3D<CilkPrecision> vector_v;
-  SOA3D<CilkPrecision> soa;
+  Vector3D<SimdPrecision> vector_v;
+  SOA3D<SimdPrecision> soa;
   TransformationMatrix matrix;
-  CilkBool output_inside;
-  CilkPrecision output_distance;
+  SimdBool output_inside;
+  SimdPrecision output_distance;
   UnplacedBox world_unplaced = UnplacedBox(scalar_v);
   UnplacedBox box_unplaced = UnplacedBox(scalar_v);
   LogicalVolume world = LogicalVolume(&world_unplaced);
@@ -0,0 +1,85 @@
+#include <cassert>
+#include <set>
+#include <thread>
+#include <vector>
+#include "management/geo_manager.h"
+#include "volumes/logical_volume.h"
+#include "volumes/box.h"
+
+using namespace vecgeom;
+
+int main() {
+
+  const int n_threads = 8;
+  const int n_placements = 1000;
+
+  UnplacedBox world_params = UnplacedBox(100., 100., 100.);
+  UnplacedBox box_params = UnplacedBox(0.1, 0.1, 0.1);
+  LogicalVolume world = LogicalVolume(&world_params);
+  LogicalVolume box = LogicalVolume(&box_params);
+  std::vector<TransformationMatrix> matrices(n_threads*n_placements);
+  // Volumes created and deleted before the geometry is closed
+  std::vector<int> deleted_ids(n_threads);
+
+  // Volumes constructed on a single thread are listed before closing
+  VPlacedVolume *const single = box_params.PlaceVolume(&box, &matrices[0]);
+  const bool listed =
+      static_cast<int>(GeoManager::Instance().volumes().size()) > single->id()
+      && GeoManager::Instance().volumes()[single->id()] == single;
+  delete single;
+
+  const int ids_before = GeoManager::Instance().volume_count();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < n_threads; ++t) {
+    threads.push_back(std::thread([&, t]() {
+      for (int i = 0; i < n_placements; ++i) {
+        TransformationMatrix &matrix = matrices[t*n_placements + i];
+        matrix.SetTranslation(t, 0.2*i - 100, 0);
+        world.PlaceDaughterConcurrently(&box, &matrix);
+      }
+      VPlacedVolume *const deleted = box_params.PlaceVolume(&box, &matrices[0]);
+      deleted_ids[t] = deleted->id();
+      delete deleted;
+    }));
+  }
+  for (int t = 0; t < n_threads; ++t) threads[t].join();
+
+  // Nothing is visible before the geometry is closed
+  assert(world.daughters().size() == 0);
+  GeoManager::Instance().CloseGeometry();
+
+  std::vector<VPlacedVolume const*> const &volumes =
+      GeoManager::Instance().volumes();
+  const int placed = world.daughters().size();
+  std::set<int> ids;
+  int previous_id = -1;
+  bool ordered = true;
+  for (Iterator<Daughter> i = world.daughters().begin();
+       i != world.daughters().end(); ++i) {
+    ids.insert((*i)->id());
+    ordered &= (*i)->id() > previous_id;
+    previous_id = (*i)->id();
+    assert(volumes[(*i)->id()] == *i);
+  }
+
+  bool deleted_removed = true;
+  for (int t = 0; t < n_threads; ++t) {
+    deleted_removed &= !volumes[deleted_ids[t]];
+  }
+
+  std::cout << "Placed " << placed << " volumes from " << n_threads
+            << " threads.\n";
+
+  assert(placed == n_threads*n_placements);
+  assert(static_cast<int>(ids.size()) == placed);
+  assert(ordered);
+  assert(deleted_removed);
+  assert(listed);
+  assert(GeoManager::Instance().volume_count() - ids_before
+         == placed + n_threads);
+
+  return (placed == n_threads*n_placements &&
+          static_cast<int>(ids.size()) == placed && ordered &&
+          deleted_removed && listed) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include <cassert>
+#include <cstdio>
+#include "management/gdml_importer.h"
+#include "volumes/logical_volume.h"
+#include "volumes/box.h"
+
+using namespace vecgeom;
+
+int main() {
+
+  char const *const file_name = "gdml_import_test.gdml";
+  FILE *const file = fopen(file_name, "w");
+  fprintf(file,
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<gdml>\n"
+    "  <!-- Eight large boxes each containing a small box -->\n"
+    "  <define>\n"
+    "    <constant name=\"half\" value=\"0.5\"/>\n"
+    "    <position name=\"p1\" x=\"2\" y=\"2\" z=\"2\" lunit=\"cm\"/>\n"
+    "    <rotation name=\"r1\" z=\"90\" aunit=\"deg\"/>\n"
+    "  </define>\n"
+    "  <solids>\n"
+    "    <box name=\"world\" x=\"80\" y=\"80\" z=\"80\"/>\n"
+    "    <box name=\"large\" x=\"3\" y=\"3\" z=\"3\" lunit=\"cm\"/>\n"
+    "    <box name=\"large_copy\" x=\"30\" y=\"30\" z=\"30\"/>\n"
+    "    <box name=\"small\" x=\"10\" y=\"10\" z=\"10\"/>\n"
+    "  </solids>\n"
+    "  <structure>\n"
+    "    <volume name=\"Small\"><solidref ref=\"small\"/></volume>\n"
+    "    <volume name=\"Large\">\n"
+    "      <solidref ref=\"large\"/>\n"
+    "      <physvol><volumeref ref=\"Small\"/></physvol>\n"
+    "    </volume>\n"
+    "    <volume name=\"LargeCopy\">\n"
+    "      <solidref ref=\"large_copy\"/>\n"
+    "      <physvol>\n"
+    "        <volumeref ref=\"Small\"/>\n"
+    "        <position name=\"inline\" x=\"half\" y=\"0\" z=\"0\"/>\n"
+    "      </physvol>\n"
+    "    </volume>\n"
+    "    <volume name=\"World\">\n"
+    "      <solidref ref=\"world\"/>\n"
+    "      <physvol>\n"
+    "        <volumeref ref=\"Large\"/>\n"
+    "        <positionref ref=\"p1\"/>\n"
+    "        <rotationref ref=\"r1\"/>\n"
+    "      </physvol>\n"
+    "      <physvol>\n"
+    "        <volumeref ref=\"LargeCopy\"/>\n"
+    "        <position name=\"p2\" x=\"-20\" y=\"-20\" z=\"-20\"/>\n"
+    "      </physvol>\n"
+    "      <physvol>\n"
+    "        <volumeref ref=\"Large\"/>\n"
+    "        <position name=\"p3\" x=\"20\" y=\"20\" z=\"20\"/>\n"
+    "        <rotation name=\"r3\" z=\"1.5707963267948966\"/>\n"
+    "      </physvol>\n"
+    "    </volume>\n"
+    "  </structure>\n"
+    "  <setup name=\"Default\" version=\"1.0\">\n"
+    "    <world ref=\"World\"/>\n"
+    "  </setup>\n"
+    "</gdml>\n"
+  );
+  fclose(file);
+
+  GdmlImporter importer;
+  importer.set_threads(4);
+  LogicalVolume const *const world = importer.Import(file_name);
+  remove(file_name);
+  assert(world != NULL);
+
+  std::cerr << "Printing imported world content:\n";
+  world->PrintContent();
+
+  // Large and LargeCopy share a solid, and the placements of Large in World
+  // at p1/r1 and p3/r3 share a matrix.
+  assert(importer.logical_count() == 4);
+  assert(importer.unplaced_count() == 3);
+  assert(importer.matrix_count() == 4);
+  assert(world->daughters().size() == 3);
+
+  UnplacedBox const *const world_box =
+      static_cast<UnplacedBox const*>(world->unplaced_volume());
+  assert(world_box->x() == 40.);
+  assert((*world->daughters().begin())->Inside(
+    Vector3D<Precision>(20, 20, 20)
+  ));
+
+  return (world && importer.unplaced_count() == 3 &&
+          importer.matrix_count() == 4) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <vector>
+#include "management/geometry_image.h"
+#include "navigation/daughter_bounds.h"
+#include "volumes/logical_volume.h"
+#include "volumes/box.h"
+
+using namespace vecgeom;
+
+bool CompareVolumes(LogicalVolume const *const a,
+                    LogicalVolume const *const b) {
+  UnplacedBox const *const box_a =
+      static_cast<UnplacedBox const*>(a->unplaced_volume());
+  UnplacedBox const *const box_b =
+      static_cast<UnplacedBox const*>(b->unplaced_volume());
+  for (int i = 0; i < 3; ++i) {
+    if (box_a->dimensions()[i] != box_b->dimensions()[i]) return false;
+  }
+  if (a->daughters().size() != b->daughters().size()) return false;
+  // Acceleration structures are built when loading or attaching
+  if (!b->daughter_bounds() || !b->face_neighbors() ||
+      b->daughter_bounds()->size() != b->daughters().size()) {
+    return false;
+  }
+  if ((a->replica() == NULL) != (b->replica() == NULL)) return false;
+  if (a->replica() &&
+      (a->replica()->axis() != b->replica()->axis() ||
+       a->replica()->copies() != b->replica()->copies() ||
+       a->replica()->pitch() != b->replica()->pitch() ||
+       a->replica()->offset() != b->replica()->offset() ||
+       b->replica()->cell() != *b->daughters().begin() ||
+       a->replica()->Locate(Vector3D<Precision>(1., 0, 0))
+       != b->replica()->Locate(Vector3D<Precision>(1., 0, 0)))) {
+    return false;
+  }
+  Iterator<Daughter> j = b->daughters().begin();
+  for (Iterator<Daughter> i = a->daughters().begin();
+       i != a->daughters().end(); ++i, ++j) {
+    for (int k = 0; k < 3; ++k) {
+      if ((*i)->matrix()->Translation(k) != (*j)->matrix()->Translation(k)) {
+        return false;
+      }
+    }
+    const Vector3D<Precision> point = (*i)->matrix()->Translation();
+    if ((*i)->Inside(point) != (*j)->Inside(point)) return false;
+    if (!CompareVolumes((*i)->logical_volume(), (*j)->logical_volume())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+
+  UnplacedBox world_params = UnplacedBox(4., 4., 4.);
+  UnplacedBox largebox_params = UnplacedBox(1.5, 1.5, 1.5);
+  UnplacedBox smallbox_params = UnplacedBox(0.5, 0.5, 0.5);
+  UnplacedBox row_params = UnplacedBox(1.5, 0.5, 0.5);
+
+  LogicalVolume world = LogicalVolume(&world_params);
+  LogicalVolume largebox = LogicalVolume(&largebox_params);
+  LogicalVolume smallbox = LogicalVolume(&smallbox_params);
+  LogicalVolume row = LogicalVolume(&row_params);
+
+  TransformationMatrix origin = TransformationMatrix();
+  TransformationMatrix box1 = TransformationMatrix( 2,  2,  2);
+  TransformationMatrix box2 = TransformationMatrix(-2,  2,  2, 90, 0, 0);
+  TransformationMatrix box3 = TransformationMatrix( 2, -2, -2, 0, 45, 0);
+  TransformationMatrix box4 = TransformationMatrix(-2, -2, -2);
+
+  largebox.PlaceDaughter(&smallbox, &origin);
+  world.PlaceDaughter(&largebox, &box1);
+  world.PlaceDaughter(&largebox, &box2);
+  world.PlaceDaughter(&largebox, &box3);
+  row.PlaceReplica(&smallbox, kReplicaX, 3, 1.);
+  world.PlaceDaughter(&row, &box4);
+
+  // Attaching process started below, which may run at another load address
+  if (argc == 3 && !strcmp(argv[1], "attach")) {
+    GeometryImage attached;
+    LogicalVolume const *const shared = attached.AttachShared(argv[2]);
+    return (shared && CompareVolumes(&world, shared)) ? 0 : 1;
+  }
+
+  char const *const file_name = "geometry_image_test.vgi";
+  const bool written = GeometryImage::Write(&world, file_name);
+  assert(written);
+
+  GeometryImage image;
+  LogicalVolume const *const loaded = image.Load(file_name);
+  assert(loaded != NULL);
+  assert(CompareVolumes(&world, loaded));
+
+  std::cerr << "Printing world content loaded from " << image.size()
+            << " byte image:\n";
+  loaded->PrintContent();
+
+  // An image with a daughter offset outside the placed volume section is
+  // rejected before anything is constructed in it.
+
+  std::vector<uint64_t> corrupt((image.size() + 7) / 8);
+  FILE *const file = fopen(file_name, "rb");
+  const bool read_back =
+      file && fread(&corrupt[0], 1, image.size(), file) == image.size();
+  if (file) fclose(file);
+  assert(read_back);
+  ImageHeader header;
+  memcpy(&header, &corrupt[0], sizeof(header));
+  const uint64_t outside = header.placed.offset + 1;
+  memcpy(reinterpret_cast<char*>(&corrupt[0]) + header.daughters.offset,
+         &outside, sizeof(outside));
+  const std::vector<uint64_t> before(corrupt);
+  const bool rejected = read_back &&
+      !GeometryImage::Relocate(&corrupt[0], image.size()) &&
+      corrupt == before;
+  assert(rejected);
+
+  // Shared memory: a new process executing this test attaches to the
+  // geometry placed in the segment by this process.
+
+  std::ostringstream segment_stream;
+  segment_stream << "/vecgeom_image_test_" << getpid();
+  const std::string segment_name = segment_stream.str();
+  int ready[2];
+  if (pipe(ready) != 0) return 1;
+  const pid_t child = fork();
+  if (child == 0) {
+    char signal;
+    close(ready[1]);
+    if (read(ready[0], &signal, 1) != 1 || signal != 1) _exit(1);
+    execl("/proc/self/exe", argv[0], "attach", segment_name.c_str(),
+          static_cast<char*>(NULL));
+    _exit(1);
+  }
+  close(ready[0]);
+  GeometryImage shared_image;
+  LogicalVolume const *const shared =
+      shared_image.CreateShared(file_name, segment_name.c_str());
+  const char signal = (shared) ? 1 : 0;
+  if (write(ready[1], &signal, 1) != 1) return 1;
+  close(ready[1]);
+  int status = 1;
+  waitpid(child, &status, 0);
+  GeometryImage::RemoveShared(segment_name.c_str());
+  assert(shared != NULL);
+  assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  remove(file_name);
+
+  return (written && loaded && CompareVolumes(&world, loaded) && rejected &&
+          shared && WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <typeinfo>
+#include <vector>
+#include "base/soa3d.h"
+#include "management/geo_manager.h"
+#include "management/isa_dispatch.h"
+#include "volumes/logical_volume.h"
+#include "volumes/box.h"
+
+using namespace vecgeom;
+
+#ifdef VECGEOM_ISA_DISPATCH
+
+namespace {
+
+BoxBasketKernels bound;
+int inside_calls = 0;
+int distance_to_in_calls = 0;
+
+void CountingInside(Vector3D<Precision> const &dimensions,
+                    TransformationMatrix const &matrix,
+                    SOA3D<Precision> const &points, bool *const output) {
+  ++inside_calls;
+  bound.inside(dimensions, matrix, points, output);
+}
+
+void CountingDistanceToIn(Vector3D<Precision> const &dimensions,
+                          TransformationMatrix const &matrix,
+                          SOA3D<Precision> const &positions,
+                          SOA3D<Precision> const &directions,
+                          Precision const *const step_max,
+                          Precision *const output) {
+  ++distance_to_in_calls;
+  bound.distance_to_in(dimensions, matrix, positions, directions, step_max,
+                       output);
+}
+
+} // End anonymous namespace
+
+int main() {
+
+  UnplacedBox world_params = UnplacedBox(10., 10., 10.);
+  UnplacedBox box_params = UnplacedBox(1.5, 2., 2.5);
+  LogicalVolume world = LogicalVolume(&world_params);
+  LogicalVolume box = LogicalVolume(&box_params);
+
+  // Placements covering identity, translation only, rotation around the
+  // z-axis and general transformations, all built by the volume factory
+  TransformationMatrix origin = TransformationMatrix();
+  TransformationMatrix translated = TransformationMatrix(5, 5, 5);
+  TransformationMatrix rotated = TransformationMatrix(-5, 5, -5, 30, 0, 0);
+  TransformationMatrix general = TransformationMatrix(5, -5, 5, 15, 30, 45);
+  world.PlaceDaughter(&box, &origin);
+  world.PlaceDaughter(&box, &translated);
+  world.PlaceDaughter(&box, &rotated);
+  world.PlaceDaughter(&box, &general);
+  GeoManager::Instance().CloseGeometry();
+  IsaDispatch::Instance().Print(std::cout);
+
+  bound = IsaDispatch::Instance().box();
+  if (!bound.inside || !bound.distance_to_in) {
+    std::cout << "No basket kernels bound on this processor.\n";
+    return 0;
+  }
+  BoxBasketKernels counting = bound;
+  counting.inside = &CountingInside;
+  counting.distance_to_in = &CountingDistanceToIn;
+  IsaDispatch::Instance().set_box(counting);
+
+  const int n_points = 256;
+  SOA3D<Precision> points(n_points), directions(n_points);
+  std::vector<Precision> steps(n_points, kInfinity);
+  for (int i = 0; i < n_points; ++i) {
+    Vector3D<Precision> point, direction;
+    for (int j = 0; j < 3; ++j) {
+      point[j] = 20.*rand()/RAND_MAX - 10.;
+      direction[j] = 2.*rand()/RAND_MAX - 1.;
+    }
+    direction.Normalize();
+    points.Set(i, point);
+    directions.Set(i, direction);
+  }
+
+  int mismatches = 0;
+  int daughters = 0;
+  bool specialized = true;
+  bool inside[n_points];
+  Precision distances[n_points];
+  for (Iterator<Daughter> d = world.daughters().begin();
+       d != world.daughters().end(); ++d, ++daughters) {
+    specialized &= typeid(**d) != typeid(PlacedBox);
+    (*d)->Inside(points, inside);
+    (*d)->DistanceToIn(points, directions, &steps[0], distances);
+    for (int i = 0; i < n_points; ++i) {
+      if (inside[i] != (*d)->Inside(points[i])) ++mismatches;
+      const Precision scalar =
+          (*d)->DistanceToIn(points[i], directions[i], steps[i]);
+      // Misses are compared by magnitude, as comparisons against infinity
+      // are not reliable with -ffast-math
+      const bool miss = scalar > 1e30;
+      if (miss != (distances[i] > 1e30) ||
+          (!miss && std::fabs(scalar - distances[i])
+                    > 1e-9*(1. + std::fabs(scalar)))) {
+        ++mismatches;
+      }
+    }
+  }
+  IsaDispatch::Instance().set_box(bound);
+
+  std::cout << daughters << " specialized placements called the bound "
+            << "kernels " << inside_calls << " and " << distance_to_in_calls
+            << " times with " << mismatches << " mismatches.\n";
+
+  assert(specialized);
+  assert(inside_calls == daughters);
+  assert(distance_to_in_calls == daughters);
+  assert(!mismatches);
+
+  return (specialized && inside_calls == daughters &&
+          distance_to_in_calls == daughters && !mismatches) ? 0 : 1;
+}
+
+#else
+
+int main() {
+  std::cout << "Built without runtime instruction set dispatch.\n";
+  return 0;
+}
+
+#endif
\ No newline at end of file
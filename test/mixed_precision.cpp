@@ -0,0 +1,95 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "backend/backend.h"
+#include "base/soa3d.h"
+#include "volumes/kernel/box_kernel.h"
+#include "test/navigation_test.h"
+
+using namespace vecgeom;
+
+#if defined(VECGEOM_SIMD) && !defined(VECGEOM_FLOAT_PRECISION)
+
+/**
+ * Compares the mixed precision box kernels with the double precision kernels
+ * for points within 1e-6 of the surfaces of a rotated and translated box,
+ * well inside the band where single precision results are refined.
+ */
+int main() {
+
+  const Vector3D<Precision> dimensions(1.5, 2., 2.5);
+  const TransformationMatrix matrix(5, -5, 5, 15, 30, 45);
+  const Precision offset = 1e-6;
+
+  const int n_points = 1024;
+  SOA3D<Precision> points(n_points), directions(n_points);
+  std::vector<Precision> steps(n_points, kInfinity);
+  for (int i = 0; i < n_points; ++i) {
+    // Point on a random face in the local frame, moved off the face by up to
+    // the offset, then transformed back to the frame of the mother
+    Vector3D<Precision> local;
+    for (int j = 0; j < 3; ++j) {
+      local[j] = (2.*RandomUniform() - 1.)*dimensions[j];
+    }
+    const int face = i % 3;
+    local[face] = ((i / 3) % 2 ? 1 : -1)*dimensions[face]
+                  + (2.*RandomUniform() - 1.)*offset;
+    Vector3D<Precision> point;
+    for (int j = 0; j < 3; ++j) {
+      point[j] = matrix.Translation(j);
+      for (int k = 0; k < 3; ++k) {
+        point[j] += matrix.Rotation(3*j + k)*local[k];
+      }
+    }
+    points.Set(i, point);
+    directions.Set(i, RandomDirection());
+  }
+
+  bool inside_mixed[n_points], inside_double[n_points];
+  Precision distance_mixed[n_points], distance_double[n_points];
+  BoxInsideMixedBasket<1, 0, kSimdFloat, kVectorImpl>(
+    dimensions, matrix, points, inside_mixed
+  );
+  BoxInsideBasket<1, 0, kVectorImpl>(dimensions, matrix, points,
+                                     inside_double);
+  BoxDistanceToInMixedBasket<1, 0, kSimdFloat, kVectorImpl>(
+    dimensions, matrix, points, directions, &steps[0], distance_mixed
+  );
+  BoxDistanceToInBasket<1, 0, kVectorImpl>(
+    dimensions, matrix, points, directions, &steps[0], distance_double
+  );
+
+  int inside = 0;
+  int mismatches = 0;
+  for (int i = 0; i < n_points; ++i) {
+    if (inside_double[i]) ++inside;
+    if (inside_mixed[i] != inside_double[i]) ++mismatches;
+    // Misses are compared by magnitude, as comparisons against infinity are
+    // not reliable with -ffast-math
+    const bool miss = distance_double[i] > 1e30;
+    if (miss != (distance_mixed[i] > 1e30) ||
+        (!miss && std::fabs(distance_mixed[i] - distance_double[i])
+                  > 1e-9*(1. + std::fabs(distance_double[i])))) {
+      ++mismatches;
+    }
+  }
+
+  std::cout << n_points << " points within " << offset << " of the surface, "
+            << inside << " inside, classified and intersected with "
+            << mismatches << " mismatches.\n";
+
+  assert(inside > 0 && inside < n_points);
+  assert(!mismatches);
+
+  return (inside > 0 && inside < n_points && !mismatches) ? 0 : 1;
+}
+
+#else
+
+int main() {
+  std::cout << "Built without the Simd backend in double precision.\n";
+  return 0;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,597 @@
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "base/instrumentation.h"
+#include "base/perf_counters.h"
+#include "base/soa3d.h"
+#include "base/stopwatch.h"
+#include "management/geo_manager.h"
+#include "management/geometry_generator.h"
+#include "management/thread_pool.h"
+#include "navigation/basketizer.h"
+#include "navigation/global_bvh.h"
+#include "navigation/global_transform_cache.h"
+#include "navigation/navigation_state.h"
+#include "navigation/simple_navigator.h"
+#include "navigation/track_scheduler.h"
+#include "test/navigation_test.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+using namespace vecgeom;
+
+// Benchmarks navigation in generated geometries. Each scenario prints one line
+// of JSON to standard output. Usage:
+//   navigation_benchmark [--depth n] [--daughters n] [--mix cube,slab,bar]
+//                        [--rotation fraction] [--tracks n]
+//                        [--repetitions n] [--seed n] [--threads n]
+//                        [--basket-size n] [--max-steps n] [--deadline n]
+//                        [--short-steps n] [--step-length fraction]
+
+namespace {
+
+struct Options {
+  int depth;
+  int daughters;
+  Precision mix[kGeneratedShapeCount];
+  Precision rotation;
+  int tracks;
+  int repetitions;
+  unsigned seed;
+  int threads;
+  int basket_size;
+  int max_steps;
+  int deadline;
+  int short_steps;
+  Precision step_length;
+};
+
+bool ParseOptions(int argc, char *argv[], Options *const options) {
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for option " << argv[i] << ".\n";
+      return false;
+    }
+    char const *const value = argv[++i];
+    if (!strcmp(argv[i-1], "--depth")) {
+      options->depth = atoi(value);
+    } else if (!strcmp(argv[i-1], "--daughters")) {
+      options->daughters = atoi(value);
+    } else if (!strcmp(argv[i-1], "--mix")) {
+      char *end = const_cast<char*>(value);
+      for (int j = 0; j < kGeneratedShapeCount; ++j) {
+        options->mix[j] = strtod(end, &end);
+        if (*end == ',') ++end;
+      }
+    } else if (!strcmp(argv[i-1], "--rotation")) {
+      options->rotation = atof(value);
+    } else if (!strcmp(argv[i-1], "--tracks")) {
+      options->tracks = atoi(value);
+    } else if (!strcmp(argv[i-1], "--repetitions")) {
+      options->repetitions = atoi(value);
+    } else if (!strcmp(argv[i-1], "--seed")) {
+      options->seed = atoi(value);
+    } else if (!strcmp(argv[i-1], "--threads")) {
+      options->threads = atoi(value);
+    } else if (!strcmp(argv[i-1], "--basket-size")) {
+      options->basket_size = atoi(value);
+    } else if (!strcmp(argv[i-1], "--max-steps")) {
+      options->max_steps = atoi(value);
+    } else if (!strcmp(argv[i-1], "--deadline")) {
+      options->deadline = atoi(value);
+    } else if (!strcmp(argv[i-1], "--short-steps")) {
+      options->short_steps = atoi(value);
+    } else if (!strcmp(argv[i-1], "--step-length")) {
+      options->step_length = atof(value);
+    } else {
+      std::cerr << "Unknown option " << argv[i-1] << ".\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+void PrintResult(char const *const scenario, Options const &options,
+                 GeometryGenerator const &generator, const double elapsed,
+                 PerfCounters const &counters, const double checksum,
+                 const int mismatches) {
+  const double calls =
+      static_cast<double>(options.tracks) * options.repetitions;
+  std::cout << "{\"scenario\": \"" << scenario << "\""
+            << ", \"depth\": " << options.depth
+            << ", \"daughters\": " << options.daughters
+            << ", \"mix\": [" << options.mix[0] << ", " << options.mix[1]
+            << ", " << options.mix[2] << "]"
+            << ", \"rotation_fraction\": " << options.rotation
+            << ", \"logical_volumes\": " << generator.logical_count()
+            << ", \"touchable_volumes\": " << generator.TouchableCount()
+            << ", \"tracks\": " << options.tracks
+            << ", \"repetitions\": " << options.repetitions
+            << ", \"elapsed\": " << elapsed
+            << ", \"calls_per_second\": " << calls / elapsed
+            << ", \"ns_per_call\": " << 1e9 * elapsed / calls;
+  PerfSample::Create(counters, calls).PrintJson(std::cout);
+  std::cout << ", \"checksum\": " << checksum
+            << ", \"mismatches\": " << mismatches << "}" << std::endl;
+}
+
+} // End anonymous namespace
+
+int main(int argc, char *argv[]) {
+
+  Options options = {3, 8, {1., 1., 1.}, 0.3, 1<<12, 16, 1, 0, 16,
+                     1000, 64, 32, 1e-3};
+  if (!ParseOptions(argc, argv, &options)) return 1;
+
+  GeometryGenerator generator;
+  generator.set_depth(options.depth);
+  generator.set_daughters(options.daughters);
+  for (int i = 0; i < kGeneratedShapeCount; ++i) {
+    generator.set_shape_mix(static_cast<GeneratedShape>(i), options.mix[i]);
+  }
+  generator.set_rotation_fraction(options.rotation);
+  generator.set_seed(options.seed);
+  VPlacedVolume const *const world = generator.Generate();
+  if (!world) return 1;
+
+  const int tracks = options.tracks;
+  const int max_level = options.depth + 1;
+  const Precision size = generator.world_size();
+  SimpleNavigator navigator;
+  PerfCounters counters;
+
+  srand(options.seed);
+  std::vector<Vector3D<Precision> > points(tracks), directions(tracks);
+  for (int i = 0; i < tracks; ++i) {
+    for (int j = 0; j < 3; ++j) points[i][j] = size*(2.*RandomUniform() - 1.);
+    directions[i] = RandomDirection();
+  }
+
+  // Locate
+
+  std::vector<NavigationState> states(tracks, NavigationState(max_level));
+  Vector3D<Precision> local;
+  double checksum = 0;
+  Stopwatch timer;
+  counters.Reset();
+  counters.Start();
+  timer.Start();
+  for (int r = 0; r < options.repetitions; ++r) {
+    for (int i = 0; i < tracks; ++i) {
+      states[i].Clear();
+      navigator.LocatePoint(world, points[i], local, states[i]);
+    }
+  }
+  timer.Stop();
+  counters.Stop();
+  for (int i = 0; i < tracks; ++i) checksum += states[i].level();
+  PrintResult("locate", options, generator, timer.Elapsed(), counters,
+              checksum, 0);
+
+  // Locate through the global BVH, which must find the same paths
+
+  GlobalBvh bvh(world);
+  std::vector<NavigationState> states_bvh(tracks, NavigationState(max_level));
+  navigator.set_global_bvh(&bvh);
+  counters.Reset();
+  counters.Start();
+  timer.Start();
+  for (int r = 0; r < options.repetitions; ++r) {
+    for (int i = 0; i < tracks; ++i) {
+      states_bvh[i].Clear();
+      navigator.LocatePoint(world, points[i], local, states_bvh[i]);
+    }
+  }
+  timer.Stop();
+  counters.Stop();
+  navigator.set_global_bvh(NULL);
+  checksum = 0;
+  int bvh_mismatches = 0;
+  for (int i = 0; i < tracks; ++i) {
+    checksum += states_bvh[i].level();
+    if (states_bvh[i] != states[i]) ++bvh_mismatches;
+  }
+  PrintResult("locate_bvh", options, generator, timer.Elapsed(), counters,
+              checksum, bvh_mismatches);
+  std::cerr << "Global BVH over " << bvh.touchable_count()
+            << " touchable volumes in " << bvh.node_count() << " nodes uses "
+            << bvh.memory_size() << " bytes.\n";
+
+  // Scalar step
+
+  std::vector<NavigationState> next_scalar(tracks, NavigationState(max_level));
+  std::vector<Precision> steps_scalar(tracks);
+  counters.Reset();
+  counters.Start();
+  timer.Start();
+  for (int r = 0; r < options.repetitions; ++r) {
+    for (int i = 0; i < tracks; ++i) {
+      steps_scalar[i] = navigator.FindNextBoundaryAndStep(
+        points[i], directions[i], states[i], next_scalar[i], kInfinity
+      );
+    }
+  }
+  timer.Stop();
+  counters.Stop();
+  checksum = 0;
+  for (int i = 0; i < tracks; ++i) {
+    if (steps_scalar[i] < kInfinity) checksum += steps_scalar[i];
+  }
+  PrintResult("step", options, generator, timer.Elapsed(), counters,
+              checksum, 0);
+
+  // Scalar step without culling daughters by their bounding spheres
+
+  std::vector<NavigationState> next_unculled(tracks,
+                                             NavigationState(max_level));
+  std::vector<Precision> steps_unculled(tracks);
+  navigator.set_culling(false);
+  counters.Reset();
+  counters.Start();
+  timer.Start();
+  for (int r = 0; r < options.repetitions; ++r) {
+    for (int i = 0; i < tracks; ++i) {
+      steps_unculled[i] = navigator.FindNextBoundaryAndStep(
+        points[i], directions[i], states[i], next_unculled[i], kInfinity
+      );
+    }
+  }
+  timer.Stop();
+  counters.Stop();
+  navigator.set_culling(true);
+  checksum = 0;
+  int unculled_mismatches = 0;
+  for (int i = 0; i < tracks; ++i) {
+    if (steps_unculled[i] < kInfinity) checksum += steps_unculled[i];
+    if (steps_unculled[i] != steps_scalar[i] ||
+        next_unculled[i] != next_scalar[i]) {
+      ++unculled_mismatches;
+    }
+  }
+  PrintResult("step_unculled", options, generator, timer.Elapsed(), counters,
+              checksum, unculled_mismatches);
+
+  // Scalar step relocating tracks that leave a daughter from the mother,
+  // without first testing the sibling bordering the exit face
+
+  std::vector<NavigationState> next_unneighbored(tracks,
+                                                 NavigationState(max_level));
+  std::vector<Precision> steps_unneighbored(tracks);
+  navigator.set_neighbor_lookup(false);
+  counters.Reset();
+  counters.Start();
+  timer.Start();
+  for (int r = 0; r < options.repetitions; ++r) {
+    for (int i = 0; i < tracks; ++i) {
+      steps_unneighbored[i] = navigator.FindNextBoundaryAndStep(
+        points[i], directions[i], states[i], next_unneighbored[i], kInfinity
+      );
+    }
+  }
+  timer.Stop();
+  counters.Stop();
+  navigator.set_neighbor_lookup(true);
+  checksum = 0;
+  int unneighbored_mismatches = 0;
+  for (int i = 0; i < tracks; ++i) {
+    if (steps_unneighbored[i] < kInfinity) checksum += steps_unneighbored[i];
+    if (steps_unneighbored[i] != steps_scalar[i] ||
+        next_unneighbored[i] != next_scalar[i]) {
+      ++unneighbored_mismatches;
+    }
+  }
+  PrintResult("step_without_neighbors", options, generator, timer.Elapsed(),
+              counters, checksum, unneighbored_mismatches);
+
+  // Scalar step converting global points with transformations cached per
+  // path. The cache is filled during the first repetition.
+
+  GlobalTransformCache transform_cache(world);
+  std::vector<NavigationState> next_cached(tracks, NavigationState(max_level));
+  std::vector<Precision> steps_cached(tracks);
+  navigator.set_transform_cache(&transform_cache);
+  counters.Reset();
+  counters.Start();
+  timer.Start();
+  for (int r = 0; r < options.repetitions; ++r) {
+    for (int i = 0; i < tracks; ++i) {
+      steps_cached[i] = navigator.FindNextBoundaryAndStep(
+        points[i], directions[i], states[i], next_cached[i], kInfinity
+      );
+    }
+  }
+  timer.Stop();
+  counters.Stop();
+  navigator.set_transform_cache(NULL);
+  checksum = 0;
+  int cached_mismatches = 0;
+  for (int i = 0; i < tracks; ++i) {
+    if (steps_cached[i] < kInfinity) checksum += steps_cached[i];
+    // Composed matrices round differently from transforming level by level
+    const bool steps_match = (steps_cached[i] < kInfinity)
+        ? std::abs(steps_cached[i] - steps_scalar[i])
+          <= 1e-9*(1. + std::abs(steps_scalar[i]))
+        : !(steps_scalar[i] < kInfinity);
+    if (!steps_match || next_cached[i] != next_scalar[i]) {
+      ++cached_mismatches;
+    }
+  }
+  PrintResult("step_cached_transform", options, generator, timer.Elapsed(),
+              counters, checksum, cached_mismatches);
+  std::cerr << "Cached " << transform_cache.filled() << " of "
+            << transform_cache.touchable_count()
+            << " global transformations.\n";
+
+  // Basket step. Tracks are grouped by logical volume, gathered into baskets
+  // in the local frame of their volume, and scattered back to be relocated.
+
+  std::vector<NavigationState> next_basket(tracks, NavigationState(max_level));
+  std::vector<Precision> steps_basket(tracks);
+  SOA3D<Precision> basket_points(tracks), basket_dirs(tracks);
+  std::vector<Precision> step_max(tracks, kInfinity);
+  std::vector<Precision> basket_steps(tracks);
+  std::vector<VPlacedVolume const*> next_volumes(tracks);
+  counters.Reset();
+  counters.Start();
+  timer.Start();
+  for (int r = 0; r < options.repetitions; ++r) {
+    std::map<LogicalVolume const*, std::vector<int> > baskets;
+    for (int i = 0; i < tracks; ++i) {
+      if (states[i].IsOutside()) {
+        next_basket[i] = states[i];
+        steps_basket[i] = kInfinity;
+        continue;
+      }
+      baskets[states[i].Top()->logical_volume()].push_back(i);
+    }
+    for (std::map<LogicalVolume const*, std::vector<int> >::const_iterator
+         basket = baskets.begin(); basket != baskets.end(); ++basket) {
+      std::vector<int> const &members = basket->second;
+      const int count = members.size();
+      for (int j = 0; j < count; ++j) {
+        const int i = members[j];
+        basket_points.Set(j, states[i].GlobalToLocal(points[i]));
+        basket_dirs.Set(j, states[i].GlobalToLocalDirection(directions[i]));
+      }
+      SOA3D<Precision> positions(basket_points.x(), basket_points.y(),
+                                 basket_points.z(), count);
+      SOA3D<Precision> dirs(basket_dirs.x(), basket_dirs.y(),
+                            basket_dirs.z(), count);
+      navigator.FindNextBoundary(states[members[0]].Top(), positions, dirs,
+                                 &step_max[0], &basket_steps[0],
+                                 &next_volumes[0]);
+      for (int j = 0; j < count; ++j) {
+        const int i = members[j];
+        steps_basket[i] = basket_steps[j];
+        next_basket[i] = states[i];
+        if (basket_steps[j] < kInfinity) {
+          navigator.Relocate(
+            points[i] + directions[i]*(basket_steps[j]
+                                       + SimpleNavigator::kPushDistance),
+            next_basket[i]
+          );
+        }
+      }
+    }
+  }
+  timer.Stop();
+  counters.Stop();
+  checksum = 0;
+  int mismatches = bvh_mismatches + unculled_mismatches
+                   + unneighbored_mismatches + cached_mismatches;
+  for (int i = 0; i < tracks; ++i) {
+    if (steps_basket[i] < kInfinity) checksum += steps_basket[i];
+    const bool step_mismatch =
+        std::fabs(steps_basket[i] - steps_scalar[i]) > kGTolerance &&
+        !(steps_basket[i] >= kInfinity && steps_scalar[i] >= kInfinity);
+    if (step_mismatch || next_basket[i] != next_scalar[i]) ++mismatches;
+  }
+  PrintResult("basket_step", options, generator, timer.Elapsed(), counters,
+              checksum,
+              mismatches);
+
+  // Basketizer step. Tracks are handed over one at a time and regrouped into
+  // baskets by the basketizer, which scatters the steps back to each track.
+
+  std::vector<Precision> steps_basketizer(tracks);
+  Basketizer basketizer(options.basket_size, options.deadline);
+  basketizer.set_output(&steps_basketizer[0], &next_volumes[0]);
+  counters.Reset();
+  counters.Start();
+  timer.Start();
+  for (int r = 0; r < options.repetitions; ++r) {
+    for (int i = 0; i < tracks; ++i) {
+      basketizer.Add(i, points[i], directions[i], states[i]);
+    }
+    basketizer.Flush();
+    for (int i = 0; i < tracks; ++i) {
+      next_basket[i] = states[i];
+      if (steps_basketizer[i] < kInfinity) {
+        navigator.Relocate(
+          points[i] + directions[i]*(steps_basketizer[i]
+                                     + SimpleNavigator::kPushDistance),
+          next_basket[i]
+        );
+      }
+    }
+  }
+  timer.Stop();
+  counters.Stop();
+  basketizer.PrintStatistics(std::cerr);
+  checksum = 0;
+  int basketizer_mismatches = 0;
+  for (int i = 0; i < tracks; ++i) {
+    if (steps_basketizer[i] < kInfinity) checksum += steps_basketizer[i];
+    const bool step_mismatch =
+        std::fabs(steps_basketizer[i] - steps_scalar[i]) > kGTolerance &&
+        !(steps_basketizer[i] >= kInfinity && steps_scalar[i] >= kInfinity);
+    if (step_mismatch || next_basket[i] != next_scalar[i]) {
+      ++basketizer_mismatches;
+    }
+  }
+  PrintResult("basketizer_step", options, generator, timer.Elapsed(),
+              counters, checksum, basketizer_mismatches);
+  mismatches += basketizer_mismatches;
+
+  // A deadline enabled while a bucket holds tracks applies to that bucket
+  {
+    int inside = 0;
+    while (inside < tracks && states[inside].IsOutside()) ++inside;
+    Basketizer late(4);
+    late.set_output(&steps_basketizer[0], &next_volumes[0]);
+    for (int slot = 0; slot < 2 && inside < tracks; ++slot) {
+      late.Add(slot, points[inside], directions[inside], states[inside]);
+      if (!slot) late.set_deadline(1);
+    }
+    if (late.pending()) {
+      std::cerr << "Deadline enabled late did not emit the open bucket.\n";
+      ++mismatches;
+    }
+  }
+
+  // Short steps. Every track takes a number of steps limited to a fraction of
+  // the world size, as in showers of many small steps, once without and once
+  // with the safety cached in the navigation state, and once with the states
+  // carrying the local points of the track instead.
+
+  const Precision step_length = options.step_length*size;
+  std::vector<Vector3D<Precision> > end_uncached(tracks), end_variant(tracks);
+  std::vector<NavigationState> state_uncached(tracks,
+                                              NavigationState(max_level));
+  NavigationState current(max_level), next(max_level);
+  NavigationState current_local(max_level, true), next_local(max_level, true);
+  char const *const short_labels[] = {"short_steps", "short_steps_cached",
+                                      "short_steps_local"};
+  for (int variant = 0; variant < 3; ++variant) {
+    const bool cached = variant == 1;
+    navigator.set_safety_caching(cached);
+    std::vector<Vector3D<Precision> > &end =
+        variant ? end_variant : end_uncached;
+    NavigationState &from = (variant == 2) ? current_local : current;
+    NavigationState &to = (variant == 2) ? next_local : next;
+    int short_mismatches = 0;
+    counters.Reset();
+    counters.Start();
+    timer.Start();
+    for (int r = 0; r < options.repetitions; ++r) {
+      for (int i = 0; i < tracks; ++i) {
+        Vector3D<Precision> point = points[i];
+        from = states[i];
+        from.InvalidateSafety();
+        for (int s = 0; s < options.short_steps && !from.IsOutside();
+             ++s) {
+          if (!cached) from.InvalidateSafety();
+          const Precision step = navigator.FindNextBoundaryAndStep(
+            point, directions[i], from, to, step_length
+          );
+          point += directions[i]*(step + SimpleNavigator::kPushDistance);
+          from = to;
+        }
+        end[i] = point;
+        if (!variant) {
+          state_uncached[i] = from;
+        } else if (r == 0 && from != state_uncached[i]) {
+          ++short_mismatches;
+        }
+      }
+    }
+    timer.Stop();
+    counters.Stop();
+    checksum = 0;
+    for (int i = 0; i < tracks; ++i) {
+      checksum += end[i].Length();
+      if ((end[i] - end_uncached[i]).Length() > kGTolerance) {
+        ++short_mismatches;
+      }
+    }
+    PrintResult(short_labels[variant], options, generator, timer.Elapsed(),
+                counters, checksum, short_mismatches);
+    mismatches += short_mismatches;
+  }
+  navigator.set_safety_caching(false);
+
+  // Scheduled transport. Tracks are transported until they leave the world by
+  // the multithreaded basket scheduler, and compared to scalar transport of
+  // each track in turn.
+
+  std::vector<int> steps_reference(tracks, 0);
+  std::vector<Precision> length_reference(tracks, 0);
+  for (int i = 0; i < tracks; ++i) {
+    Vector3D<Precision> point = points[i];
+    current.Clear();
+    navigator.LocatePoint(world, point, local, current);
+    while (!current.IsOutside() && steps_reference[i] < options.max_steps) {
+      const Precision step = navigator.FindNextBoundaryAndStep(
+        point, directions[i], current, next, kInfinity
+      );
+      point += directions[i]*(step + SimpleNavigator::kPushDistance);
+      length_reference[i] += step;
+      ++steps_reference[i];
+      current = next;
+    }
+  }
+  double transport_elapsed = 0;
+  int transport_mismatches = 0;
+  checksum = 0;
+  counters.Reset();
+  for (int r = 0; r < options.repetitions; ++r) {
+    TrackScheduler scheduler(world, max_level);
+    scheduler.set_threads(options.threads);
+    scheduler.set_basket_size(options.basket_size);
+    scheduler.set_max_steps(options.max_steps);
+    for (int i = 0; i < tracks; ++i) {
+      scheduler.AddTrack(points[i], directions[i]);
+    }
+    counters.Start();
+    timer.Start();
+    scheduler.Transport();
+    transport_elapsed += timer.Stop();
+    counters.Stop();
+    if (r > 0) continue;
+    for (int i = 0; i < tracks; ++i) {
+      checksum += scheduler.length(i);
+      if (scheduler.steps(i) != steps_reference[i] ||
+          std::fabs(scheduler.length(i) - length_reference[i])
+          > kGTolerance*(1 + steps_reference[i])) {
+        ++transport_mismatches;
+      }
+    }
+    scheduler.PrintStatistics(std::cerr);
+  }
+  PrintResult("scheduled_transport", options, generator, transport_elapsed,
+              counters, checksum, transport_mismatches);
+  mismatches += transport_mismatches;
+
+  // Transport started from within pool tasks is processed by the calling
+  // threads and must give the same result
+  std::vector<int> chunk_mismatches(2, 0);
+  ThreadPool pool(2);
+  pool.Run(2, [&](const int chunk) {
+    TrackScheduler scheduler(world, max_level);
+    scheduler.set_threads(2);
+    scheduler.set_basket_size(options.basket_size);
+    scheduler.set_max_steps(options.max_steps);
+    for (int i = chunk; i < tracks; i += 2) {
+      scheduler.AddTrack(points[i], directions[i]);
+    }
+    scheduler.Transport();
+    for (int j = 0, i = chunk; i < tracks; ++j, i += 2) {
+      if (scheduler.steps(j) != steps_reference[i]) ++chunk_mismatches[chunk];
+    }
+  });
+  const int nested_mismatches = chunk_mismatches[0] + chunk_mismatches[1];
+  if (nested_mismatches) {
+    std::cerr << nested_mismatches << " mismatches in nested transport.\n";
+  }
+  mismatches += nested_mismatches;
+
+  #ifdef VECGEOM_INSTRUMENTATION
+  GeoManager::Instance().CloseGeometry();
+  Instrumentation::Print(std::cerr);
+  #endif
+
+  return mismatches ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef VECGEOM_TEST_NAVIGATIONTEST_H_
+#define VECGEOM_TEST_NAVIGATIONTEST_H_
+
+#include <stdlib.h>
+#include <vector>
+#include "base/global.h"
+#include "base/stopwatch.h"
+#include "base/vector3d.h"
+#include "navigation/navigation_state.h"
+#include "navigation/simple_navigator.h"
+#include "volumes/placed_volume.h"
+
+namespace vecgeom {
+
+// Helpers shared by the navigation tests and benchmarks, most of which build
+// a geometry in two ways and compare navigating through both
+
+inline Precision RandomUniform() {
+  return static_cast<Precision>(rand()) / RAND_MAX;
+}
+
+inline Vector3D<Precision> RandomDirection() {
+  Vector3D<Precision> direction;
+  Precision length;
+  do {
+    for (int i = 0; i < 3; ++i) direction[i] = 2.*RandomUniform() - 1.;
+    length = direction.Length();
+  } while (length > 1. || length < kNearZero);
+  direction /= length;
+  return direction;
+}
+
+/**
+ * States in two geometries match if they have the same depth and the same
+ * point in the frame of their top volume.
+ */
+inline bool Matches(NavigationState const &a, NavigationState const &b,
+                    Vector3D<Precision> const &point) {
+  if (a.level() != b.level()) return false;
+  return (a.GlobalToLocal(point) - b.GlobalToLocal(point)).Length()
+         <= 1e-9*(1. + point.Length());
+}
+
+/**
+ * Locates every point in the world.
+ * \return Elapsed time in seconds.
+ */
+inline double LocateAll(SimpleNavigator const &navigator,
+                        VPlacedVolume const *const world,
+                        std::vector<Vector3D<Precision> > const &points,
+                        std::vector<NavigationState> &states) {
+  Vector3D<Precision> local;
+  Stopwatch timer;
+  timer.Start();
+  for (unsigned i = 0; i < points.size(); ++i) {
+    states[i].Clear();
+    navigator.LocatePoint(world, points[i], local, states[i]);
+  }
+  return timer.Stop();
+}
+
+/**
+ * Transports every track from its located state until it leaves the world.
+ * \param steps Output number of steps per track.
+ * \param lengths Output length travelled per track, excluding push
+ *                distances.
+ * \return Elapsed time in seconds.
+ */
+inline double TransportAll(SimpleNavigator const &navigator,
+                           std::vector<Vector3D<Precision> > const &points,
+                           std::vector<Vector3D<Precision> > const &directions,
+                           std::vector<NavigationState> const &states,
+                           std::vector<int> &steps,
+                           std::vector<Precision> &lengths) {
+  const int max_level = states.empty() ? 1 : states[0].max_level();
+  NavigationState current(max_level), next(max_level);
+  steps.assign(points.size(), 0);
+  lengths.assign(points.size(), 0);
+  Stopwatch timer;
+  timer.Start();
+  for (unsigned i = 0; i < points.size(); ++i) {
+    Vector3D<Precision> point = points[i];
+    current = states[i];
+    while (!current.IsOutside()) {
+      const Precision step = navigator.FindNextBoundaryAndStep(
+        point, directions[i], current, next, kInfinity
+      );
+      point += directions[i]*(step + SimpleNavigator::kPushDistance);
+      lengths[i] += step;
+      current = next;
+      ++steps[i];
+    }
+  }
+  return timer.Stop();
+}
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_TEST_NAVIGATIONTEST_H_
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include "base/soa3d.h"
+#include "base/stopwatch.h"
+#include "management/geometry_generator.h"
+#include "management/parallel_basket.h"
+#include "navigation/navigation_state.h"
+#include "navigation/simple_navigator.h"
+#include "test/navigation_test.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+using namespace vecgeom;
+
+/**
+ * Compares the parallel basket entry points to their serial counterparts for
+ * both schedules, and reports the speedup on all hardware threads.
+ */
+int main() {
+
+  const int depth = 3;
+  const int points_count = 1<<20;
+
+  GeometryGenerator generator;
+  generator.set_depth(depth);
+  VPlacedVolume const *const world = generator.Generate();
+  if (!world) return 1;
+  VPlacedVolume const *const daughter =
+      *world->logical_volume()->daughters().begin();
+  const Precision size = generator.world_size();
+
+  srand(1);
+  SOA3D<Precision> points(points_count), directions(points_count);
+  Precision *step_max = static_cast<Precision*>(
+    _mm_malloc(points_count*sizeof(Precision), kAlignmentBoundary)
+  );
+  for (int i = 0; i < points_count; ++i) {
+    Vector3D<Precision> direction;
+    for (int j = 0; j < 3; ++j) direction[j] = 2.*RandomUniform() - 1.;
+    direction /= direction.Length();
+    points.Set(i, size*(2.*RandomUniform() - 1.),
+                  size*(2.*RandomUniform() - 1.),
+                  size*(2.*RandomUniform() - 1.));
+    directions.Set(i, direction);
+    step_max[i] = kInfinity;
+  }
+
+  // Serial references
+
+  std::vector<char> inside_serial(points_count);
+  std::vector<Precision> distance_serial(points_count);
+  std::vector<VPlacedVolume const*> located_serial(points_count);
+  Stopwatch timer;
+  timer.Start();
+  daughter->Inside(points, reinterpret_cast<bool*>(&inside_serial[0]));
+  daughter->DistanceToIn(points, directions, step_max, &distance_serial[0]);
+  SimpleNavigator navigator;
+  NavigationState state(depth + 1);
+  Vector3D<Precision> local;
+  for (int i = 0; i < points_count; ++i) {
+    state.Clear();
+    located_serial[i] = navigator.LocatePoint(world, points[i], local, state);
+  }
+  const double serial = timer.Stop();
+
+  ParallelBasket parallel;
+  const Schedule schedules[] = {kScheduleStatic, kScheduleDynamic};
+  char const *const labels[] = {"static", "dynamic"};
+  int mismatches = 0;
+  for (int s = 0; s < 2; ++s) {
+    parallel.set_schedule(schedules[s]);
+    std::vector<char> inside(points_count);
+    std::vector<Precision> distance(points_count);
+    std::vector<VPlacedVolume const*> located(points_count);
+    timer.Start();
+    parallel.Inside(*daughter, points, reinterpret_cast<bool*>(&inside[0]));
+    parallel.DistanceToIn(*daughter, points, directions, step_max,
+                          &distance[0]);
+    parallel.Locate(world, points, depth + 1, &located[0]);
+    const double elapsed = timer.Stop();
+    int schedule_mismatches = 0;
+    for (int i = 0; i < points_count; ++i) {
+      schedule_mismatches += inside[i] != inside_serial[i];
+      schedule_mismatches += distance[i] != distance_serial[i];
+      schedule_mismatches += located[i] != located_serial[i];
+    }
+    std::cout << "Parallel " << labels[s] << " on "
+              << parallel.pool().threads() << " threads: " << elapsed
+              << "s, " << serial / elapsed << "x speedup, "
+              << schedule_mismatches << " mismatches.\n";
+    mismatches += schedule_mismatches;
+  }
+
+  _mm_free(step_max);
+  return mismatches != 0;
+}
\ No newline at end of file
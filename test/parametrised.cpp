@@ -0,0 +1,128 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "base/soa3d.h"
+#include "management/geo_manager.h"
+#include "management/geometry_image.h"
+#include "test/navigation_test.h"
+#include "volumes/box.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+using namespace vecgeom;
+
+/**
+ * Builds a barrel of tilted staves arranged in rings along z, once as a
+ * parametrised placement and once with every stave placed individually, and
+ * compares locating points and transporting tracks through both.
+ */
+int main() {
+
+  const int staves = 48;
+  const int rings = 16;
+  const int copies = staves*rings;
+  const int tracks = 1<<12;
+  const Precision radius = 40.;
+  const Precision tilt = 10.;
+  const Precision ring_pitch = 5.;
+
+  UnplacedBox world_params(100., 100., 100.);
+  UnplacedBox barrel_params(50., 50., 0.5*rings*ring_pitch);
+  UnplacedBox stave_params(0.5, 2.4, 0.5*ring_pitch - 0.1);
+  TransformationMatrix origin;
+
+  // Every stave of a ring has its own angle, shared by all rings
+  std::vector<Precision> angles(staves);
+  for (int i = 0; i < staves; ++i) angles[i] = 360.*i/staves + tilt;
+  SOA3D<Precision> translations(copies);
+  std::vector<int> angle_index(copies);
+  for (int ring = 0; ring < rings; ++ring) {
+    for (int i = 0; i < staves; ++i) {
+      const Precision phi = kDegToRad*360.*i/staves;
+      const int copy = ring*staves + i;
+      translations.Set(copy, radius*cos(phi), radius*sin(phi),
+                       (ring - 0.5*(rings - 1))*ring_pitch);
+      angle_index[copy] = i;
+    }
+  }
+
+  LogicalVolume world(&world_params), barrel(&barrel_params),
+                stave(&stave_params);
+  barrel.PlaceParametrised(&stave, translations, &angle_index[0], angles);
+  world.PlaceDaughter(&barrel, &origin);
+
+  LogicalVolume world_ref(&world_params), barrel_ref(&barrel_params);
+  std::vector<TransformationMatrix> matrices(copies);
+  for (int i = 0; i < copies; ++i) {
+    matrices[i].SetTranslation(translations[i]);
+    matrices[i].SetRotation(angles[angle_index[i]], 0, 0);
+    barrel_ref.PlaceDaughter(&stave, &matrices[i]);
+  }
+  world_ref.PlaceDaughter(&barrel_ref, &origin);
+
+  VPlacedVolume const *const placed =
+      world_params.PlaceVolume(&world, &origin);
+  VPlacedVolume const *const placed_ref =
+      world_params.PlaceVolume(&world_ref, &origin);
+  GeoManager::Instance().CloseGeometry();
+
+  // Parametrisations are the only content of their mother
+  const bool rejected =
+      !barrel.PlaceParametrised(&stave, translations, &angle_index[0],
+                                angles) &&
+      !world.PlaceParametrised(&stave, translations, &angle_index[0], angles);
+  // Geometry images cannot store parametrisations
+  const bool not_written = !GeometryImage::Write(&world, "parametrised.vgi");
+
+  srand(1);
+  std::vector<Vector3D<Precision> > points(tracks), directions(tracks);
+  for (int i = 0; i < tracks; ++i) {
+    // Points are sampled in the shell of the staves, so most locate in one
+    const Precision phi = 2.*M_PI*RandomUniform();
+    const Precision r = radius + 4.*(2.*RandomUniform() - 1.);
+    points[i] = Vector3D<Precision>(
+      r*cos(phi), r*sin(phi), 0.5*rings*ring_pitch*(2.*RandomUniform() - 1.)
+    );
+    directions[i] = RandomDirection();
+  }
+
+  SimpleNavigator navigator;
+  const int max_level = 4;
+  std::vector<NavigationState> states(tracks, NavigationState(max_level)),
+                               states_ref(tracks, NavigationState(max_level));
+  int mismatches = 0, inside = 0;
+
+  double elapsed[2];
+  elapsed[0] = LocateAll(navigator, placed, points, states);
+  elapsed[1] = LocateAll(navigator, placed_ref, points, states_ref);
+  for (int i = 0; i < tracks; ++i) {
+    if (!Matches(states[i], states_ref[i], points[i])) ++mismatches;
+    if (states[i].level() == 3) ++inside;
+  }
+  std::cout << "Locate: " << 1e9*elapsed[0]/tracks
+            << " ns parametrised, " << 1e9*elapsed[1]/tracks
+            << " ns with placements, " << inside << " of " << tracks
+            << " points in a stave.\n";
+
+  // Transports every track until it leaves the world
+  std::vector<int> steps, steps_ref;
+  std::vector<Precision> lengths, lengths_ref;
+  elapsed[0] = TransportAll(navigator, points, directions, states, steps,
+                            lengths);
+  elapsed[1] = TransportAll(navigator, points, directions, states_ref,
+                            steps_ref, lengths_ref);
+  int total_steps = 0;
+  for (int i = 0; i < tracks; ++i) {
+    total_steps += steps[i];
+    if (steps[i] != steps_ref[i] ||
+        std::fabs(lengths[i] - lengths_ref[i]) > 1e-9*(1. + lengths[i])) {
+      ++mismatches;
+    }
+  }
+  std::cout << "Transport: " << 1e9*elapsed[0]/total_steps
+            << " ns per step parametrised, " << 1e9*elapsed[1]/total_steps
+            << " ns with placements, " << total_steps << " steps.\n";
+
+  std::cout << mismatches << " mismatches.\n";
+  return (mismatches == 0 && rejected && not_written) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "management/geo_manager.h"
+#include "navigation/global_bvh.h"
+#include "navigation/global_transform_cache.h"
+#include "test/navigation_test.h"
+#include "volumes/box.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+using namespace vecgeom;
+
+/**
+ * Builds a calorimeter of cells replicated along x and y, and the same layout
+ * with every cell placed individually, and compares locating points and
+ * transporting tracks through both. Copies of a replica share a placement, so
+ * the replicated layout is also navigated with the global index, the
+ * transformation cache and neighbor lookup, which all track the copy index.
+ */
+int main() {
+
+  const int slabs = 50;
+  const int cells = 50;
+  const int tracks = 1<<12;
+  const Precision pitch = 2.;
+
+  UnplacedBox world_params(100., 100., 100.);
+  UnplacedBox calorimeter_params(0.5*slabs*pitch, 0.5*cells*pitch, 50.);
+  UnplacedBox slab_params(0.5*pitch, 0.5*cells*pitch, 50.);
+  UnplacedBox cell_params(0.5*pitch, 0.5*pitch, 50.);
+  TransformationMatrix origin;
+
+  LogicalVolume world(&world_params), calorimeter(&calorimeter_params),
+                slab(&slab_params), cell(&cell_params);
+  calorimeter.PlaceReplica(&slab, kReplicaX, slabs, pitch);
+  slab.PlaceReplica(&cell, kReplicaY, cells, pitch);
+  world.PlaceDaughter(&calorimeter, &origin);
+
+  LogicalVolume world_ref(&world_params), calorimeter_ref(&calorimeter_params),
+                slab_ref(&slab_params);
+  std::vector<TransformationMatrix> slab_matrices(slabs), cell_matrices(cells);
+  for (int i = 0; i < slabs; ++i) {
+    slab_matrices[i].SetTranslation((i - 0.5*(slabs - 1))*pitch, 0, 0);
+    calorimeter_ref.PlaceDaughter(&slab_ref, &slab_matrices[i]);
+  }
+  for (int i = 0; i < cells; ++i) {
+    cell_matrices[i].SetTranslation(0, (i - 0.5*(cells - 1))*pitch, 0);
+    slab_ref.PlaceDaughter(&cell, &cell_matrices[i]);
+  }
+  world_ref.PlaceDaughter(&calorimeter_ref, &origin);
+
+  VPlacedVolume const *const placed =
+      world_params.PlaceVolume(&world, &origin);
+  VPlacedVolume const *const placed_ref =
+      world_params.PlaceVolume(&world_ref, &origin);
+  GeoManager::Instance().CloseGeometry();
+
+  // Replicas are the only content of their mother
+  const bool rejected = !slab.PlaceReplica(&cell, kReplicaY, cells, pitch) &&
+                        !world.PlaceReplica(&cell, kReplicaZ, 10, 3*pitch);
+
+  srand(1);
+  std::vector<Vector3D<Precision> > points(tracks), directions(tracks);
+  for (int i = 0; i < tracks; ++i) {
+    for (int j = 0; j < 3; ++j) points[i][j] = 60.*(2.*RandomUniform() - 1.);
+    directions[i] = RandomDirection();
+  }
+
+  SimpleNavigator navigator;
+  const int max_level = 5;
+  std::vector<NavigationState> states(tracks, NavigationState(max_level)),
+                               states_ref(tracks, NavigationState(max_level));
+  int mismatches = 0;
+
+  double elapsed[2];
+  elapsed[0] = LocateAll(navigator, placed, points, states);
+  elapsed[1] = LocateAll(navigator, placed_ref, points, states_ref);
+  for (int i = 0; i < tracks; ++i) {
+    if (!Matches(states[i], states_ref[i], points[i])) ++mismatches;
+  }
+  std::cout << "Locate: " << 1e9*elapsed[0]/tracks << " ns with replicas, "
+            << 1e9*elapsed[1]/tracks << " ns with placements.\n";
+
+  // Transports every track until it leaves the world
+  std::vector<int> steps, steps_ref;
+  std::vector<Precision> lengths, lengths_ref;
+  elapsed[0] = TransportAll(navigator, points, directions, states, steps,
+                            lengths);
+  elapsed[1] = TransportAll(navigator, points, directions, states_ref,
+                            steps_ref, lengths_ref);
+  int total_steps = 0;
+  for (int i = 0; i < tracks; ++i) {
+    total_steps += steps[i];
+    if (steps[i] != steps_ref[i] ||
+        std::fabs(lengths[i] - lengths_ref[i]) > 1e-9*(1. + lengths[i])) {
+      ++mismatches;
+    }
+  }
+  std::cout << "Transport: " << 1e9*elapsed[0]/total_steps
+            << " ns per step with replicas, " << 1e9*elapsed[1]/total_steps
+            << " ns with placements, " << total_steps << " steps.\n";
+
+  GlobalBvh bvh(placed);
+  GlobalTransformCache cache(placed);
+  SimpleNavigator accelerated;
+  accelerated.set_global_bvh(&bvh);
+  accelerated.set_transform_cache(&cache);
+  accelerated.set_neighbor_lookup(true);
+  std::vector<NavigationState> states_accelerated(tracks,
+                                                  NavigationState(max_level));
+  LocateAll(accelerated, placed, points, states_accelerated);
+  for (int i = 0; i < tracks; ++i) {
+    if (!Matches(states_accelerated[i], states_ref[i], points[i])) {
+      ++mismatches;
+    }
+  }
+  std::vector<int> steps_accelerated;
+  std::vector<Precision> lengths_accelerated;
+  TransportAll(accelerated, points, directions, states_accelerated,
+               steps_accelerated, lengths_accelerated);
+  for (int i = 0; i < tracks; ++i) {
+    if (steps_accelerated[i] != steps_ref[i] ||
+        std::fabs(lengths_accelerated[i] - lengths_ref[i])
+        > 1e-9*(1. + lengths_ref[i])) {
+      ++mismatches;
+    }
+  }
+  std::cout << bvh.touchable_count() << " touchables indexed, "
+            << cache.touchable_count() << " cached.\n";
+
+  std::cout << mismatches << " mismatches.\n";
+  return (mismatches == 0 && rejected) ? 0 : 1;
+}
\ No newline at end of file
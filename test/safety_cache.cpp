@@ -0,0 +1,69 @@
+#include <cmath>
+#include <iostream>
+#include "management/geo_manager.h"
+#include "navigation/navigation_state.h"
+#include "navigation/simple_navigator.h"
+#include "volumes/box.h"
+#include "volumes/logical_volume.h"
+#include "volumes/placed_volume.h"
+
+using namespace vecgeom;
+
+/**
+ * Steps a track towards the wall of a box with the safety cached, and checks
+ * that steps are only taken from the cache while the pushed end point stays
+ * within the safety.
+ */
+int main() {
+
+  UnplacedBox world_params(10., 10., 10.);
+  UnplacedBox box_params(2., 2., 2.);
+  TransformationMatrix origin;
+  LogicalVolume world(&world_params), box(&box_params);
+  world.PlaceDaughter(&box, &origin);
+  VPlacedVolume const *const placed =
+      world_params.PlaceVolume(&world, &origin);
+  GeoManager::Instance().CloseGeometry();
+
+  SimpleNavigator navigator;
+  const int max_level = 3;
+  NavigationState current(max_level), next(max_level);
+  Vector3D<Precision> local;
+  const Vector3D<Precision> start(1., 0, 0), direction(1., 0, 0);
+  navigator.LocatePoint(placed, start, local, current);
+  const Precision safety = navigator.ComputeSafety(start, current);
+  int failures = 0;
+
+  // Short of the safety by more than the push distance, the step is taken
+  // from the cache and the track stays in the box
+  const Precision short_step = 0.5*safety;
+  Precision step = navigator.FindNextBoundaryAndStep(
+    start, direction, current, next, short_step
+  );
+  if (step != short_step || next != current) ++failures;
+  if (next.RemainingSafety(start + direction*step) <= 0) ++failures;
+
+  // A step reaching the safety ends on the wall of the box and is pushed
+  // across it, so it must be computed and leave the box
+  step = navigator.FindNextBoundaryAndStep(
+    start, direction, current, next, safety
+  );
+  if (std::fabs(step - safety) > 1e-9 || next.level() != 1) ++failures;
+
+  // Steps limited by step_max from a state without a cached safety only
+  // compute and cache it once safety caching is enabled
+  NavigationState uncached(max_level);
+  navigator.LocatePoint(placed, start, local, uncached);
+  navigator.FindNextBoundaryAndStep(start, direction, uncached, next,
+                                    short_step);
+  if (next.RemainingSafety(start) > 0) ++failures;
+  navigator.set_safety_caching(true);
+  navigator.FindNextBoundaryAndStep(start, direction, uncached, next,
+                                    short_step);
+  if (std::fabs(next.RemainingSafety(start) - safety) > 1e-9) ++failures;
+
+  std::cout << "Safety " << safety << " cached with " << failures
+            << " failures.\n";
+
+  return failures ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <cstdlib>
+#include "base/lane_statistics.h"
+#include "comparison/shape_tester.h"
+#include "management/geo_manager.h"
+#include "management/isa_dispatch.h"
+#include "volumes/logical_volume.h"
+#include "volumes/box.h"
+
+using namespace vecgeom;
+
+int main(int argc, char *argv[]) {
+
+  UnplacedBox world_params = UnplacedBox(10., 10., 10.);
+  UnplacedBox box_params = UnplacedBox(1.5, 2., 2.5);
+
+  LogicalVolume world = LogicalVolume(&world_params);
+  LogicalVolume box = LogicalVolume(&box_params);
+
+  TransformationMatrix origin = TransformationMatrix();
+  TransformationMatrix translated = TransformationMatrix(5, 5, 5);
+  TransformationMatrix rotated = TransformationMatrix(-5, 5, -5, 30, 0, 0);
+  TransformationMatrix general = TransformationMatrix(5, -5, 5, 15, 30, 45);
+  TransformationMatrix diagonal = TransformationMatrix(-5, -5, 5, 180, 0, 0);
+
+  world.PlaceDaughter(&box, &origin);
+  world.PlaceDaughter(&box, &translated);
+  world.PlaceDaughter(&box, &rotated);
+  world.PlaceDaughter(&box, &general);
+  world.PlaceDaughter(&box, &diagonal);
+
+  GeoManager::Instance().CloseGeometry();
+  #ifdef VECGEOM_ISA_DISPATCH
+  IsaDispatch::Instance().Print(std::cout);
+  #endif
+
+  ShapeTester tester(&world);
+  tester.set_n_points(argc > 1 ? atoi(argv[1]) : 1<<10);
+  tester.set_repetitions(argc > 2 ? atoi(argv[2]) : 1<<8);
+  tester.set_pool_multiplier(argc > 3 ? atoi(argv[3]) : 4);
+  tester.set_verbose(1);
+
+  const unsigned mismatches = tester.BenchmarkAll();
+
+  std::vector<ShapeBenchmark> results = tester.PopResults();
+  for (unsigned i = 0; i < results.size(); ++i) {
+    std::cout << results[i] << std::endl;
+  }
+
+  #ifdef VECGEOM_LANE_STATISTICS
+  LaneStatistics::Print(std::cerr);
+  #endif
+
+  return mismatches ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef VECGEOM_VOLUMES_KERNEL_BASKET_H_
+#define VECGEOM_VOLUMES_KERNEL_BASKET_H_
+
+#include "base/global.h"
+#include "base/soa3d.h"
+#include "base/vector3d.h"
+
+namespace vecgeom {
+
+/**
+ * Loads a chunk of up to the vector size of the backend from a basket. Chunks
+ * at the end of the basket are padded with zeros, so kernels can process
+ * baskets of any size without a scalar remainder loop.
+ */
+template <ImplType it>
+VECGEOM_INLINE
+Vector3D<typename Impl<it>::precision_v> LoadBasketChunk(
+    SOA3D<Precision> const &basket, const int offset, const int lanes) {
+  typedef typename Impl<it>::precision_v Float;
+  if (lanes == Impl<it>::kVectorSize) {
+    return Vector3D<Float>(Impl<it>::LoadUnaligned(basket.x() + offset),
+                           Impl<it>::LoadUnaligned(basket.y() + offset),
+                           Impl<it>::LoadUnaligned(basket.z() + offset));
+  }
+  Precision padded[3][Impl<it>::kVectorSize];
+  for (int i = 0; i < Impl<it>::kVectorSize; ++i) {
+    const bool valid = i < lanes;
+    padded[0][i] = valid ? basket.x(offset + i) : 0;
+    padded[1][i] = valid ? basket.y(offset + i) : 0;
+    padded[2][i] = valid ? basket.z(offset + i) : 0;
+  }
+  return Vector3D<Float>(Impl<it>::LoadUnaligned(padded[0]),
+                         Impl<it>::LoadUnaligned(padded[1]),
+                         Impl<it>::LoadUnaligned(padded[2]));
+}
+
+template <ImplType it>
+VECGEOM_INLINE
+typename Impl<it>::precision_v LoadBasketChunk(Precision const *const basket,
+                                               const int offset,
+                                               const int lanes) {
+  if (lanes == Impl<it>::kVectorSize) {
+    return Impl<it>::LoadUnaligned(basket + offset);
+  }
+  Precision padded[Impl<it>::kVectorSize];
+  for (int i = 0; i < Impl<it>::kVectorSize; ++i) {
+    padded[i] = (i < lanes) ? basket[offset + i] : 0;
+  }
+  return Impl<it>::LoadUnaligned(padded);
+}
+
+/**
+ * Stores the first lanes of a vector, discarding padded lanes.
+ */
+template <ImplType it>
+VECGEOM_INLINE
+void StoreBasketChunk(typename Impl<it>::precision_v const &value,
+                      const int offset, const int lanes,
+                      Precision *const basket) {
+  if (lanes == Impl<it>::kVectorSize) {
+    Impl<it>::StoreUnaligned(value, basket + offset);
+    return;
+  }
+  Precision padded[Impl<it>::kVectorSize];
+  Impl<it>::StoreUnaligned(value, padded);
+  for (int i = 0; i < lanes; ++i) basket[offset + i] = padded[i];
+}
+
+template <ImplType it>
+VECGEOM_INLINE
+void StoreBasketChunk(typename Impl<it>::bool_v const &value,
+                      const int offset, const int lanes,
+                      bool *const basket) {
+  for (int i = 0; i < lanes; ++i) basket[offset + i] = value[i];
+}
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_VOLUMES_KERNEL_BASKET_H_
\ No newline at end of file
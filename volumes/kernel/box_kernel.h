@@ -2,8 +2,11 @@
 #define VECGEOM_VOLUMES_KERNEL_BOXKERNEL_H_
 
 #include "base/global.h"
+#include "base/lane_statistics.h"
 #include "base/vector3d.h"
 #include "base/transformation_matrix.h"
+#include "volumes/kernel/basket.h"
+#include "volumes/kernel/mixed_precision.h"
 
 namespace vecgeom {
 
@@ -15,6 +18,8 @@ void BoxInside(Vector3D<Precision> const &dimensions,
                Vector3D<typename Impl<it>::precision_v> const &point,
                typename Impl<it>::bool_v *const inside) {
 
+  VECGEOM_LANE_SCOPE(it, kInstrumentedBox, kKernelInside);
+
   const Vector3D<typename Impl<it>::precision_v> local =
       matrix.Transform<trans_code, rot_code>(point);
 
@@ -22,7 +27,7 @@ void BoxInside(Vector3D<Precision> const &dimensions,
   for (int i = 0; i < 3; ++i) {
     inside_dim[i] = Abs(local[i]) < dimensions[i];
     if (Impl<it>::early_returns) {
-      if (!inside_dim[i]) {
+      if (!IsFull(inside_dim[i])) {
         *inside = Impl<it>::kFalse;
         return;
       }
@@ -50,6 +55,8 @@ void BoxDistanceToIn(
   typedef typename Impl<it>::precision_v Float;
   typedef typename Impl<it>::bool_v Bool;
 
+  VECGEOM_LANE_SCOPE(it, kInstrumentedBox, kKernelDistanceToIn);
+
   Vector3D<Float> safety;
   Vector3D<Float> pos_local;
   Vector3D<Float> dir_local;
@@ -67,7 +74,7 @@ void BoxDistanceToIn(
   done |= (safety[0] >= step_max ||
            safety[1] >= step_max ||
            safety[2] >= step_max);
-  if (done == true) return;
+  if (IsFull(done)) return;
 
   Float next, coord1, coord2;
 
@@ -81,7 +88,7 @@ void BoxDistanceToIn(
         Abs(coord2) <= dimensions[2];
   MaskedAssign(!done && hit, next, distance);
   done |= hit;
-  if (done == true) return;
+  if (IsFull(done)) return;
 
   // y
   next = safety[1] / Abs(dir_local[1] + kTiny);
@@ -93,7 +100,7 @@ void BoxDistanceToIn(
         Abs(coord2) <= dimensions[2];
   MaskedAssign(!done && hit, next, distance);
   done |= hit;
-  if (done == true) return;
+  if (IsFull(done)) return;
 
   // z
   next = safety[2] / Abs(dir_local[2] + kTiny);
@@ -107,6 +114,288 @@ void BoxDistanceToIn(
 
 }
 
+/**
+ * Computes the distance to leave the box from a point inside it. Position and
+ * direction are given in the local frame of the box. Points outside the box
+ * yield zero. If requested, also reports the face through which the point
+ * leaves, numbered 2*axis for the face at -dimensions[axis] and 2*axis+1 for
+ * the face at +dimensions[axis]. Faces are held in floating point lanes so
+ * every backend can report them.
+ */
+template <ImplType it>
+VECGEOM_INLINE
+VECGEOM_CUDA_HEADER_BOTH
+void BoxDistanceToOut(
+    Vector3D<Precision> const &dimensions,
+    Vector3D<typename Impl<it>::precision_v> const &pos,
+    Vector3D<typename Impl<it>::precision_v> const &dir,
+    typename Impl<it>::precision_v *const distance,
+    typename Impl<it>::precision_v *const face = NULL) {
+
+  typedef typename Impl<it>::precision_v Float;
+  typedef typename Impl<it>::bool_v Bool;
+
+  VECGEOM_LANE_SCOPE(it, kInstrumentedBox, kKernelDistanceToOut);
+
+  *distance = kInfinity;
+  if (face) *face = -1;
+
+  for (int i = 0; i < 3; ++i) {
+    const Float safety_plus = dimensions[i] + pos[i];
+    const Float safety_minus = dimensions[i] - pos[i];
+    const Bool backward = dir[i] < 0;
+    Float next;
+    CondAssign(backward, safety_plus, safety_minus, &next);
+    next /= Abs(dir[i]) + kTiny;
+    const Bool closer = next < *distance;
+    MaskedAssign(closer, next, distance);
+    if (face) {
+      Float side;
+      CondAssign(backward, Float(2*i), Float(2*i + 1), &side);
+      MaskedAssign(closer, side, face);
+    }
+  }
+
+  MaskedAssign(*distance < 0, Impl<it>::kZero, distance);
+}
+
+/**
+ * Computes a lower bound of the distance from a point outside the box to the
+ * box, given in the frame of its mother. Points inside the box yield a
+ * negative value.
+ */
+template <TranslationCode trans_code, RotationCode rot_code, ImplType it>
+VECGEOM_INLINE
+VECGEOM_CUDA_HEADER_BOTH
+void BoxSafetyToIn(Vector3D<Precision> const &dimensions,
+                   TransformationMatrix const &matrix,
+                   Vector3D<typename Impl<it>::precision_v> const &point,
+                   typename Impl<it>::precision_v *const safety) {
+
+  typedef typename Impl<it>::precision_v Float;
+
+  VECGEOM_LANE_SCOPE(it, kInstrumentedBox, kKernelSafetyToIn);
+
+  const Vector3D<Float> local = matrix.Transform<trans_code, rot_code>(point);
+
+  *safety = Abs(local[0]) - dimensions[0];
+  for (int i = 1; i < 3; ++i) {
+    const Float safety_dim = Abs(local[i]) - dimensions[i];
+    MaskedAssign(safety_dim > *safety, safety_dim, safety);
+  }
+}
+
+/**
+ * Computes a lower bound of the distance from a point inside the box to its
+ * surface, given in the local frame of the box. Points outside the box yield a
+ * negative value.
+ */
+template <ImplType it>
+VECGEOM_INLINE
+VECGEOM_CUDA_HEADER_BOTH
+void BoxSafetyToOut(Vector3D<Precision> const &dimensions,
+                    Vector3D<typename Impl<it>::precision_v> const &point,
+                    typename Impl<it>::precision_v *const safety) {
+
+  typedef typename Impl<it>::precision_v Float;
+
+  VECGEOM_LANE_SCOPE(it, kInstrumentedBox, kKernelSafetyToOut);
+
+  *safety = dimensions[0] - Abs(point[0]);
+  for (int i = 1; i < 3; ++i) {
+    const Float safety_dim = dimensions[i] - Abs(point[i]);
+    MaskedAssign(safety_dim < *safety, safety_dim, safety);
+  }
+}
+
+/**
+ * Basket loops over the kernels above for a vector backend. They instantiate
+ * no scalar code, so they can be compiled for a different instruction set
+ * than the rest of the library.
+ */
+template <TranslationCode trans_code, RotationCode rot_code, ImplType it>
+VECGEOM_INLINE
+void BoxInsideBasket(Vector3D<Precision> const &dimensions,
+                     TransformationMatrix const &matrix,
+                     SOA3D<Precision> const &points,
+                     bool *const output) {
+  const int size = points.size();
+  for (int i = 0; i < size; i += Impl<it>::kVectorSize) {
+    const int lanes = (size - i < Impl<it>::kVectorSize)
+                      ? size - i : Impl<it>::kVectorSize;
+    typename Impl<it>::bool_v inside;
+    BoxInside<trans_code, rot_code, it>(
+      dimensions, matrix, LoadBasketChunk<it>(points, i, lanes), &inside
+    );
+    StoreBasketChunk<it>(inside, i, lanes, output);
+  }
+}
+
+template <TranslationCode trans_code, RotationCode rot_code, ImplType it>
+VECGEOM_INLINE
+void BoxDistanceToInBasket(Vector3D<Precision> const &dimensions,
+                           TransformationMatrix const &matrix,
+                           SOA3D<Precision> const &positions,
+                           SOA3D<Precision> const &directions,
+                           Precision const *const step_max,
+                           Precision *const output) {
+  const int size = positions.size();
+  for (int i = 0; i < size; i += Impl<it>::kVectorSize) {
+    const int lanes = (size - i < Impl<it>::kVectorSize)
+                      ? size - i : Impl<it>::kVectorSize;
+    typename Impl<it>::precision_v distance;
+    BoxDistanceToIn<trans_code, rot_code, it>(
+      dimensions, matrix,
+      LoadBasketChunk<it>(positions, i, lanes),
+      LoadBasketChunk<it>(directions, i, lanes),
+      LoadBasketChunk<it>(step_max, i, lanes),
+      &distance
+    );
+    StoreBasketChunk<it>(distance, i, lanes, output);
+  }
+}
+
+/**
+ * Positions and directions are given in the local frame of the box.
+ */
+template <ImplType it>
+VECGEOM_INLINE
+void BoxDistanceToOutBasket(Vector3D<Precision> const &dimensions,
+                            SOA3D<Precision> const &positions,
+                            SOA3D<Precision> const &directions,
+                            Precision *const output) {
+  const int size = positions.size();
+  for (int i = 0; i < size; i += Impl<it>::kVectorSize) {
+    const int lanes = (size - i < Impl<it>::kVectorSize)
+                      ? size - i : Impl<it>::kVectorSize;
+    typename Impl<it>::precision_v distance;
+    BoxDistanceToOut<it>(
+      dimensions,
+      LoadBasketChunk<it>(positions, i, lanes),
+      LoadBasketChunk<it>(directions, i, lanes),
+      &distance
+    );
+    StoreBasketChunk<it>(distance, i, lanes, output);
+  }
+}
+
+/**
+ * Mixed precision variant of BoxInsideBasket. Points are classified with the
+ * single precision backend, and points within the band around the surface,
+ * scaled by the magnitude of each point, are classified again with the double
+ * precision backend.
+ */
+template <TranslationCode trans_code, RotationCode rot_code,
+          ImplType single_it, ImplType double_it>
+VECGEOM_INLINE
+void BoxInsideMixedBasket(Vector3D<Precision> const &dimensions,
+                          TransformationMatrix const &matrix,
+                          SOA3D<Precision> const &points,
+                          bool *const output) {
+  typedef typename Impl<single_it>::precision_v Float;
+  typedef typename Impl<single_it>::bool_v Bool;
+  const int chunk = Impl<single_it>::kVectorSize;
+  MixedPrecisionRefinement<chunk> refinement;
+  bool refined[2*chunk];
+  const Float scale = MixedPrecisionScale(dimensions, matrix);
+  const int size = points.size();
+  for (int i = 0; i < size; i += chunk) {
+    const int lanes = (size - i < chunk) ? size - i : chunk;
+    const Vector3D<Float> point = LoadBasketChunk<single_it>(points, i, lanes);
+    const Float band = kMixedPrecisionBand
+        * (Abs(point[0]) + Abs(point[1]) + Abs(point[2]) + scale);
+    const Vector3D<Float> local =
+        matrix.Transform<trans_code, rot_code>(point);
+    Bool inside(true);
+    Bool uncertain(false);
+    for (int j = 0; j < 3; ++j) {
+      const Float safety = Abs(local[j]) - dimensions[j];
+      inside &= safety < 0;
+      uncertain |= Abs(safety) < band;
+    }
+    StoreBasketChunk<single_it>(inside, i, lanes, output);
+    refinement.Gather(uncertain, i, lanes, points);
+    if (refinement.Full() || (i + chunk >= size && refinement.size())) {
+      const SOA3D<Precision> gathered(
+        refinement.position(0), refinement.position(1),
+        refinement.position(2), refinement.size()
+      );
+      BoxInsideBasket<trans_code, rot_code, double_it>(dimensions, matrix,
+                                                       gathered, refined);
+      refinement.Scatter(refined, output);
+      refinement.Clear();
+    }
+  }
+}
+
+/**
+ * Mixed precision variant of BoxDistanceToInBasket. Rays are first
+ * intersected in single precision with the box enlarged by the band, which
+ * any ray hitting the box also hits. Only lanes hitting the enlarged box or
+ * starting inside it are computed again in double precision, while the
+ * remaining lanes miss the box for certain.
+ */
+template <TranslationCode trans_code, RotationCode rot_code,
+          ImplType single_it, ImplType double_it>
+VECGEOM_INLINE
+void BoxDistanceToInMixedBasket(Vector3D<Precision> const &dimensions,
+                                TransformationMatrix const &matrix,
+                                SOA3D<Precision> const &positions,
+                                SOA3D<Precision> const &directions,
+                                Precision const *const step_max,
+                                Precision *const output) {
+  typedef typename Impl<single_it>::precision_v Float;
+  typedef typename Impl<single_it>::bool_v Bool;
+  const int chunk = Impl<single_it>::kVectorSize;
+  MixedPrecisionRefinement<chunk> refinement;
+  Precision refined[2*chunk];
+  const Vector3D<Precision> enlarged = dimensions
+      + MixedPrecisionBand<single_it>(dimensions, matrix, positions);
+  const int size = positions.size();
+  for (int i = 0; i < size; i += chunk) {
+    const int lanes = (size - i < chunk) ? size - i : chunk;
+    const Vector3D<Float> pos =
+        LoadBasketChunk<single_it>(positions, i, lanes);
+    const Vector3D<Float> pos_local =
+        matrix.Transform<trans_code, rot_code>(pos);
+    const Vector3D<Float> dir_local = matrix.TransformRotation<rot_code>(
+      LoadBasketChunk<single_it>(directions, i, lanes)
+    );
+    // The step limit is widened by the band as well, so lanes are only
+    // discarded if they exceed it in double precision too
+    const Float step = LoadBasketChunk<single_it>(step_max, i, lanes)
+                       * Float(1. + kMixedPrecisionBand);
+    Bool uncertain(true);
+    for (int j = 0; j < 3; ++j) {
+      uncertain &= Abs(pos_local[j]) < enlarged[j];
+    }
+    // Points are already in the local frame, so the matrix is not used
+    Float distance;
+    BoxDistanceToIn<translation::kOrigin, rotation::kIdentity, single_it>(
+      enlarged, matrix, pos_local, dir_local, step, &distance
+    );
+    uncertain |= distance < kMixedPrecisionMiss;
+    StoreBasketChunk<single_it>(distance, i, lanes, output);
+    refinement.Gather(uncertain, i, lanes, positions, directions, step_max);
+    if (refinement.Full() || (i + chunk >= size && refinement.size())) {
+      const SOA3D<Precision> gathered_positions(
+        refinement.position(0), refinement.position(1),
+        refinement.position(2), refinement.size()
+      );
+      const SOA3D<Precision> gathered_directions(
+        refinement.direction(0), refinement.direction(1),
+        refinement.direction(2), refinement.size()
+      );
+      BoxDistanceToInBasket<trans_code, rot_code, double_it>(
+        dimensions, matrix, gathered_positions, gathered_directions,
+        refinement.step_max(), refined
+      );
+      refinement.Scatter(refined, output);
+      refinement.Clear();
+    }
+  }
+}
+
 } // End namespace vecgeom
 
 #endif // VECGEOM_VOLUMES_KERNEL_BOXKERNEL_H_
\ No newline at end of file
@@ -0,0 +1,173 @@
+#ifndef VECGEOM_VOLUMES_KERNEL_MIXEDPRECISION_H_
+#define VECGEOM_VOLUMES_KERNEL_MIXEDPRECISION_H_
+
+#include <limits>
+#include "base/global.h"
+#include "base/soa3d.h"
+#include "base/transformation_matrix.h"
+#include "base/vector3d.h"
+#include "volumes/kernel/basket.h"
+
+/**
+ * Support for mixed precision basket kernels, enabled by configuring with
+ * -DMIXED_PRECISION=ON. Kernels first run with single precision lanes, twice
+ * as many per vector as in double precision. Lanes whose result could be
+ * affected by the rounding of single precision, because they lie within a
+ * band around a surface, are gathered and recomputed in double precision.
+ */
+
+namespace vecgeom {
+
+/**
+ * Width of the band around surfaces relative to the magnitude of the
+ * coordinates involved. Roughly a hundred times the rounding error of single
+ * precision, which leaves a margin for the error accumulated by the
+ * transformation and by intersecting rays.
+ */
+const Precision kMixedPrecisionBand = 1e-5;
+
+/**
+ * Single precision distances below this value are hits. Used instead of
+ * comparing to infinity, which the compiler may assume never occurs when
+ * building with finite math only.
+ */
+const float kMixedPrecisionMiss = std::numeric_limits<float>::max();
+
+/**
+ * \return Magnitude of the placement and extent of a volume, to which the
+ *         magnitude of a point in the frame of the mother is added to scale
+ *         the band.
+ */
+VECGEOM_INLINE
+Precision MixedPrecisionScale(Vector3D<Precision> const &dimensions,
+                              TransformationMatrix const &matrix) {
+  Precision scale = 0;
+  for (int i = 0; i < 3; ++i) {
+    scale += std::abs(matrix.Translation(i)) + dimensions[i];
+  }
+  return scale;
+}
+
+/**
+ * \return Absolute width of the band for a basket, covering the rounding
+ *         error of single precision for all of its points.
+ */
+template <ImplType it>
+VECGEOM_INLINE
+Precision MixedPrecisionBand(Vector3D<Precision> const &dimensions,
+                             TransformationMatrix const &matrix,
+                             SOA3D<Precision> const &points) {
+  typedef typename Impl<it>::precision_v Float;
+  const int size = points.size();
+  Float magnitude = Impl<it>::kZero;
+  for (int i = 0; i < size; i += Impl<it>::kVectorSize) {
+    const int lanes = (size - i < Impl<it>::kVectorSize)
+                      ? size - i : Impl<it>::kVectorSize;
+    const Vector3D<Float> point = LoadBasketChunk<it>(points, i, lanes);
+    const Float sum = Abs(point[0]) + Abs(point[1]) + Abs(point[2]);
+    MaskedAssign(sum > magnitude, sum, &magnitude);
+  }
+  Precision scale = 0;
+  for (int i = 0; i < Impl<it>::kVectorSize; ++i) {
+    if (magnitude[i] > scale) scale = magnitude[i];
+  }
+  return kMixedPrecisionBand
+         * (scale + MixedPrecisionScale(dimensions, matrix));
+}
+
+/**
+ * Collects lanes flagged for refinement from chunks of single precision
+ * kernels, so they can be recomputed together by the double precision basket
+ * kernels and scattered back to the output. Holds up to two chunks of lanes,
+ * and should be flushed whenever Full() returns true.
+ */
+template <int chunk_size>
+class MixedPrecisionRefinement {
+
+private:
+
+  static const int kCapacity = 2*chunk_size;
+
+  int size_;
+  int index_[kCapacity];
+  Precision position_[3][kCapacity];
+  Precision direction_[3][kCapacity];
+  Precision step_max_[kCapacity];
+
+public:
+
+  MixedPrecisionRefinement() : size_(0) {}
+
+  int size() const { return size_; }
+
+  /**
+   * \return True if another chunk might not fit in the buffer.
+   */
+  bool Full() const { return size_ > kCapacity - chunk_size; }
+
+  void Clear() { size_ = 0; }
+
+  /**
+   * Appends the flagged lanes among the first lanes of the chunk starting at
+   * the offset of the basket.
+   */
+  template <typename Mask>
+  void Gather(Mask const &refine, const int offset, const int lanes,
+              SOA3D<Precision> const &positions) {
+    if (refine.isEmpty()) return;
+    for (int i = 0; i < lanes; ++i) {
+      if (!refine[i]) continue;
+      const int index = offset + i;
+      index_[size_] = index;
+      position_[0][size_] = positions.x(index);
+      position_[1][size_] = positions.y(index);
+      position_[2][size_] = positions.z(index);
+      ++size_;
+    }
+  }
+
+  template <typename Mask>
+  void Gather(Mask const &refine, const int offset, const int lanes,
+              SOA3D<Precision> const &positions,
+              SOA3D<Precision> const &directions,
+              Precision const *const step_max) {
+    if (refine.isEmpty()) return;
+    for (int i = 0; i < lanes; ++i) {
+      if (!refine[i]) continue;
+      const int index = offset + i;
+      index_[size_] = index;
+      position_[0][size_] = positions.x(index);
+      position_[1][size_] = positions.y(index);
+      position_[2][size_] = positions.z(index);
+      direction_[0][size_] = directions.x(index);
+      direction_[1][size_] = directions.y(index);
+      direction_[2][size_] = directions.z(index);
+      step_max_[size_] = step_max[index];
+      ++size_;
+    }
+  }
+
+  /**
+   * Gathered coordinates, to be viewed as baskets of size() elements.
+   */
+  Precision* position(const int coordinate) { return position_[coordinate]; }
+
+  Precision* direction(const int coordinate) {
+    return direction_[coordinate];
+  }
+
+  Precision const* step_max() const { return step_max_; }
+
+  /**
+   * Writes the refined results back to the lanes they were gathered from.
+   */
+  template <typename Type>
+  void Scatter(Type const *const refined, Type *const output) const {
+    for (int i = 0; i < size_; ++i) output[index_[i]] = refined[i];
+  }
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_VOLUMES_KERNEL_MIXEDPRECISION_H_
\ No newline at end of file
@@ -1,36 +1,57 @@
 #ifndef VECGEOM_VOLUMES_LOGICALVOLUME_H_
 #define VECGEOM_VOLUMES_LOGICALVOLUME_H_
 
+#include <deque>
 #include <iostream>
 #include <string>
 #include "base/global.h"
+#include "base/soa3d.h"
 #include "base/vector.h"
+#include "volumes/parametrised_placement.h"
+#include "volumes/replica_placement.h"
 #include "volumes/unplaced_volume.h"
 
 namespace vecgeom {
 
 typedef VPlacedVolume const* Daughter;
 
+class DaughterBounds;
+class FaceNeighbors;
+
 class LogicalVolume {
 
 private:
 
   VUnplacedVolume const *unplaced_volume_;
   Container<Daughter> *daughters_;
+  // Host only, NULL on the GPU
+  DaughterBounds *daughter_bounds_;
+  FaceNeighbors *face_neighbors_;
+  // NULL unless the daughters are the copies of a replica
+  ReplicaPlacement *replica_;
+  // NULL unless the daughters are the copies of a parametrisation, which then
+  // owns them
+  ParametrisedPlacement *parametrisation_;
+  // Whether the volume only groups its daughters
+  bool assembly_;
+  // Composed matrices of daughters taken over from assemblies, NULL if none
+  std::deque<TransformationMatrix> *flattened_matrices_;
 
   friend class CudaManager;
+  friend class GeoManager;
+  friend class GeometryImage;
 
 public:
 
-  LogicalVolume(VUnplacedVolume const *const unplaced_volume__)
-      : unplaced_volume_(unplaced_volume__) {
-    daughters_ = new Vector<Daughter>();
-  }
+  LogicalVolume(VUnplacedVolume const *const unplaced_volume__);
 
-  VECGEOM_CUDA_HEADER_DEVICE
+  VECGEOM_CUDA_HEADER_BOTH
   LogicalVolume(VUnplacedVolume const *const unplaced_volume,
                 Container<Daughter> *daughters)
-      : unplaced_volume_(unplaced_volume), daughters_(daughters) {}
+      : unplaced_volume_(unplaced_volume), daughters_(daughters),
+        daughter_bounds_(NULL), face_neighbors_(NULL), replica_(NULL),
+        parametrisation_(NULL), assembly_(false),
+        flattened_matrices_(NULL) {}
 
   ~LogicalVolume();
 
@@ -42,9 +63,113 @@ public:
   VECGEOM_INLINE
   Container<Daughter> const& daughters() const { return *daughters_; }
 
+  /**
+   * \return Bounding spheres of the daughters in the order of daughters(),
+   *         or NULL on the GPU.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  DaughterBounds const* daughter_bounds() const { return daughter_bounds_; }
+
+  /**
+   * \return Neighbors across the faces of the daughters as of the last call
+   *         to GeoManager::CloseGeometry(), or NULL on the GPU.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  FaceNeighbors const* face_neighbors() const { return face_neighbors_; }
+
+  /**
+   * \return Replica filling this volume, or NULL if the daughters were placed
+   *         individually.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  ReplicaPlacement const* replica() const { return replica_; }
+
+  /**
+   * \return Parametrised placement filling this volume, or NULL if the
+   *         daughters were placed individually.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  ParametrisedPlacement const* parametrisation() const {
+    return parametrisation_;
+  }
+
+  /**
+   * \return Whether this volume is an assembly, which only groups its
+   *         daughters.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  bool assembly() const { return assembly_; }
+
+  /**
+   * Marks this volume as an assembly, whose shape only bounds its daughters.
+   * This only affects flattening: placements of assemblies are replaced by
+   * their daughters when closing the geometry with assembly flattening
+   * enabled, see GeoManager::set_flatten_assemblies(), after which points
+   * outside all daughters belong to the mother. Placements which are not
+   * flattened are navigated as regular volumes, so such points then belong
+   * to the assembly.
+   */
+  void set_assembly(const bool assembly) { assembly_ = assembly; }
+
   void PlaceDaughter(LogicalVolume const *const volume,
                      TransformationMatrix const *const matrix);
 
+  /**
+   * Places multiple daughters at once, allocating space for all of them in
+   * advance.
+   * \param volumes Array of volumes to place.
+   * \param matrices Array of transformations of the same length.
+   */
+  void PlaceDaughters(LogicalVolume const *const *const volumes,
+                      TransformationMatrix const *const *const matrices,
+                      const int count);
+
+  /**
+   * Divides a region of this volume into copies of a box volume along an
+   * axis, as described by ReplicaPlacement. The replica must be the only
+   * content of this volume, so it can neither be combined with other
+   * daughters nor placed twice. The single daughter is the placement shared
+   * by all copies.
+   * \param volume Volume to replicate, which must be a box whose length
+   *               along the axis equals the pitch.
+   * \param offset Position of the center of the replicated region along the
+   *               axis.
+   * \return False if the replica cannot be placed.
+   */
+  bool PlaceReplica(LogicalVolume const *const volume, const ReplicaAxis axis,
+                    const int copies, const Precision pitch,
+                    const Precision offset = 0);
+
+  /**
+   * Places copies of a box volume at computed positions, as described by
+   * ParametrisedPlacement. Like a replica, the parametrisation must be the
+   * only content of this volume.
+   * \param volume Volume to place, which must be a box.
+   * \param translations Position of each copy in the frame of this volume.
+   * \param angle_index Index into the angles for each copy.
+   * \param angles Rotations around the z-axis in degrees.
+   * \return False if the copies cannot be placed.
+   */
+  bool PlaceParametrised(LogicalVolume const *const volume,
+                         SOA3D<Precision> const &translations,
+                         int const *const angle_index,
+                         std::vector<Precision> const &angles);
+
+  /**
+   * Thread-safe version of PlaceDaughter(). The placed volume is held in a
+   * staging buffer of the calling thread and is only added to the daughters
+   * of this volume by GeoManager::CloseGeometry().
+   * \return The new placed volume.
+   */
+  VPlacedVolume const* PlaceDaughterConcurrently(
+      LogicalVolume const *const volume,
+      TransformationMatrix const *const matrix);
+
   VECGEOM_CUDA_HEADER_BOTH
   int CountVolumes() const;
 
@@ -64,6 +189,52 @@ public:
                            LogicalVolume *const gpu_ptr) const;
   #endif
 
+private:
+
+  /**
+   * Adds a placed volume to the daughters and its bounding sphere to the
+   * daughter bounds.
+   */
+  void AppendDaughter(VPlacedVolume const *const daughter);
+
+  /**
+   * Builds daughter bounds and face neighbors from the current daughters
+   * into the given objects, for volumes constructed without them, such as
+   * those loaded from a geometry image. The objects are not deleted with the
+   * volume, which is never destructed in that case.
+   */
+  void BuildAcceleration(DaughterBounds *const bounds,
+                         FaceNeighbors *const neighbors);
+
+  /**
+   * Rebuilds the face neighbors from the current daughters. Only derived data
+   * is modified, so it can be called on volumes reached through placements.
+   */
+  void BuildFaceNeighbors() const;
+
+  /**
+   * Replaces daughters which are assemblies by the daughters of the assembly,
+   * recursively through chains of assemblies, with their matrices composed.
+   * Volumes filled by a replica or parametrisation are left unchanged.
+   * \param max_daughters Maximum number of daughters a single assembly
+   *                     placement may be replaced by.
+   */
+  void FlattenAssemblies(const int max_daughters);
+
+  /**
+   * \return Number of daughters an assembly expands into when flattened.
+   */
+  static int CountFlattened(LogicalVolume const *const assembly);
+
+  /**
+   * Places the daughters of an assembly in this volume.
+   * \param matrix Placement of the assembly in this volume.
+   * \param assembly_id Id of the outermost assembly placement replaced.
+   */
+  void AppendFlattened(LogicalVolume const *const assembly,
+                       TransformationMatrix const &matrix,
+                       const int assembly_id);
+
 };
 
 } // End namespace vecgeom
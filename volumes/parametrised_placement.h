@@ -0,0 +1,153 @@
+#ifndef VECGEOM_VOLUMES_PARAMETRISEDPLACEMENT_H_
+#define VECGEOM_VOLUMES_PARAMETRISEDPLACEMENT_H_
+
+#include <vector>
+#include "base/global.h"
+#include "base/soa3d.h"
+#include "base/transformation_matrix.h"
+#include "base/vector3d.h"
+#include "backend/backend.h"
+#include "navigation/daughter_bounds.h"
+
+namespace vecgeom {
+
+/**
+ * Copies of a box volume whose placements follow a formula, such as tilted
+ * staves, without forming a regular replica. Each copy is described by a
+ * translation and an index into a table of rotation angles around the z-axis,
+ * given in degrees as for TransformationMatrix::SetRotation(phi, 0, 0).
+ *
+ * The parameters are kept as padded structure of arrays, from which the vector
+ * backend transforms points into the frames of a whole vector of copies at
+ * once. The copies are still placed volumes, as navigation states identify
+ * volumes by their placement, but their matrices are held in a single array
+ * and the placed volumes are constructed into a single pool owned by the
+ * parametrisation rather than allocated one by one. The copies live as long
+ * as the parametrisation and must not be deleted individually.
+ */
+class ParametrisedPlacement {
+
+public:
+
+  /**
+   * Number of copies evaluated into a buffer on the stack at a time.
+   */
+  static const int kChunkSize = 64;
+
+  /**
+   * Number of copies evaluated at once by the vector backend, or one without
+   * a vector backend.
+   */
+  #ifdef VECGEOM_VECTOR_BACKEND
+  static const int kLanes = Impl<kVectorImpl>::kVectorSize;
+  #else
+  static const int kLanes = 1;
+  #endif
+
+private:
+
+  int copies_;
+  Vector3D<Precision> dimensions_;
+  std::vector<Precision> x_, y_, z_;
+  std::vector<int> angle_index_;
+  std::vector<Precision> angles_;
+  // Derived from the angle index, so vectors of copies are loaded contiguously
+  std::vector<Precision> cos_, sin_;
+  std::vector<TransformationMatrix> matrices_;
+  std::vector<VPlacedVolume const*> cells_;
+  void *pool_;
+  // Bounding spheres of the copies, culling copies during DistanceToIn()
+  DaughterBounds bounds_;
+
+public:
+
+  /**
+   * Places the copies of a box volume.
+   * \param volume Logical volume of the copies, which must be a box.
+   * \param translations Position of each copy in the frame of the mother.
+   * \param angle_index Index into the angles for each copy.
+   * \param angles Rotations around the z-axis in degrees.
+   */
+  ParametrisedPlacement(LogicalVolume const *const volume,
+                        SOA3D<Precision> const &translations,
+                        int const *const angle_index,
+                        std::vector<Precision> const &angles);
+
+  /**
+   * Destroys the copies, which must not be deleted individually.
+   */
+  ~ParametrisedPlacement();
+
+  int copies() const { return copies_; }
+
+  Vector3D<Precision> translation(const int copy) const {
+    return Vector3D<Precision>(x_[copy], y_[copy], z_[copy]);
+  }
+
+  /**
+   * \return Rotation of the copy around the z-axis in degrees.
+   */
+  Precision angle(const int copy) const {
+    return angles_[angle_index_[copy]];
+  }
+
+  TransformationMatrix const* matrix(const int copy) const {
+    return &matrices_[copy];
+  }
+
+  /**
+   * \return Placed volume of the copy, owned by the parametrisation.
+   */
+  VPlacedVolume const* cell(const int copy) const { return cells_[copy]; }
+
+  /**
+   * \param point Point in the frame of the mother.
+   * \return First copy containing the point, or NULL if none does.
+   */
+  VPlacedVolume const* Locate(Vector3D<Precision> const &point) const;
+
+  /**
+   * Finds the first copy hit by a ray from a point outside all copies. Copies
+   * whose bounding spheres are not closer than the step are skipped, the
+   * others are evaluated a vector at a time, and those estimated to beat the
+   * step are confirmed with the scalar method of the placed copy.
+   * \param step Distance to beat, updated if a copy is hit before it.
+   * \param hit Output copy hit before the step, left unchanged otherwise.
+   */
+  void DistanceToIn(Vector3D<Precision> const &point,
+                    Vector3D<Precision> const &direction,
+                    Precision *const step,
+                    VPlacedVolume const **const hit) const;
+
+  /**
+   * \return Minimum safety from a point in the frame of the mother to any
+   *         copy.
+   */
+  Precision SafetyToIn(Vector3D<Precision> const &point) const;
+
+private:
+
+  ParametrisedPlacement(ParametrisedPlacement const&);
+  ParametrisedPlacement& operator=(ParametrisedPlacement const&);
+
+  /**
+   * Computes the distances to enter the kLanes copies starting at the given
+   * copy, ignoring distances beyond the step.
+   */
+  void DistanceToInLanes(Vector3D<Precision> const &point,
+                         Vector3D<Precision> const &direction,
+                         const Precision step, const int first,
+                         Precision *const output) const;
+
+  /**
+   * Computes the safeties to the copies of the chunk starting at the given
+   * copy, which are negative for copies containing the point.
+   */
+  void SafetyToInChunk(Vector3D<Precision> const &point, const int first,
+                       Precision *const output) const;
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_VOLUMES_PARAMETRISEDPLACEMENT_H_
\ No newline at end of file
@@ -2,7 +2,7 @@
 #define VECGEOM_VOLUMES_PLACEDBOX_H_
 
 #include "base/global.h"
-#include "backend/scalar_backend.h"
+#include "backend/backend.h"
 #include "volumes/placed_volume.h"
 #include "volumes/unplaced_box.h"
 #include "volumes/kernel/box_kernel.h"
@@ -54,6 +54,29 @@ public:
   virtual Precision DistanceToOut(Vector3D<Precision> const &position,
                                   Vector3D<Precision> const &direction) const;
 
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Precision DistanceToOut(Vector3D<Precision> const &position,
+                                  Vector3D<Precision> const &direction,
+                                  int *const face) const;
+
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Precision SafetyToIn(Vector3D<Precision> const &position) const;
+
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Precision SafetyToOut(Vector3D<Precision> const &position) const;
+
+  virtual void Inside(SOA3D<Precision> const &points,
+                      bool *const output) const;
+
+  virtual void DistanceToIn(SOA3D<Precision> const &positions,
+                            SOA3D<Precision> const &directions,
+                            Precision const *const step_max,
+                            Precision *const output) const;
+
+  virtual void DistanceToOut(SOA3D<Precision> const &positions,
+                             SOA3D<Precision> const &directions,
+                             Precision *const output) const;
+
 protected:
 
   // Templates to interact with common kernel
@@ -72,6 +95,27 @@ protected:
       Vector3D<typename Impl<it>::precision_v> const &direction,
       const typename Impl<it>::precision_v step_max) const;
 
+  template <TranslationCode trans_code, RotationCode rot_code, ImplType it>
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  typename Impl<it>::precision_v SafetyToInTemplate(
+      Vector3D<typename Impl<it>::precision_v> const &position) const;
+
+  /**
+   * Loops over a basket of points with the vector backend if one is
+   * available, and with the scalar kernel otherwise.
+   */
+  template <TranslationCode trans_code, RotationCode rot_code>
+  VECGEOM_INLINE
+  void InsideBasket(SOA3D<Precision> const &points, bool *const output) const;
+
+  template <TranslationCode trans_code, RotationCode rot_code>
+  VECGEOM_INLINE
+  void DistanceToInBasket(SOA3D<Precision> const &positions,
+                          SOA3D<Precision> const &directions,
+                          Precision const *const step_max,
+                          Precision *const output) const;
+
   /**
    * Retrieves the unplaced volume pointer from the logical volume and casts it
    * to an unplaced box.
@@ -144,6 +188,68 @@ typename Impl<it>::precision_v PlacedBox::DistanceToInTemplate(
   return output;
 }
 
+template <TranslationCode trans_code, RotationCode rot_code, ImplType it>
+VECGEOM_CUDA_HEADER_BOTH
+VECGEOM_INLINE
+typename Impl<it>::precision_v PlacedBox::SafetyToInTemplate(
+    Vector3D<typename Impl<it>::precision_v> const &position) const {
+
+  typename Impl<it>::precision_v output;
+
+  BoxSafetyToIn<trans_code, rot_code, it>(
+    AsUnplacedBox()->dimensions(),
+    *this->matrix(),
+    position,
+    &output
+  );
+
+  return output;
+}
+
+template <TranslationCode trans_code, RotationCode rot_code>
+VECGEOM_INLINE
+void PlacedBox::InsideBasket(SOA3D<Precision> const &points,
+                             bool *const output) const {
+  #if defined(VECGEOM_MIXED_PRECISION)
+  BoxInsideMixedBasket<trans_code, rot_code, kSimdFloat, kVectorImpl>(
+    AsUnplacedBox()->dimensions(), *this->matrix(), points, output
+  );
+  #elif defined(VECGEOM_VECTOR_BACKEND)
+  BoxInsideBasket<trans_code, rot_code, kVectorImpl>(
+    AsUnplacedBox()->dimensions(), *this->matrix(), points, output
+  );
+  #else
+  for (int i = 0, i_max = points.size(); i < i_max; ++i) {
+    output[i] = InsideTemplate<trans_code, rot_code, kScalar>(points[i]);
+  }
+  #endif
+}
+
+template <TranslationCode trans_code, RotationCode rot_code>
+VECGEOM_INLINE
+void PlacedBox::DistanceToInBasket(SOA3D<Precision> const &positions,
+                                   SOA3D<Precision> const &directions,
+                                   Precision const *const step_max,
+                                   Precision *const output) const {
+  #if defined(VECGEOM_MIXED_PRECISION)
+  BoxDistanceToInMixedBasket<trans_code, rot_code, kSimdFloat, kVectorImpl>(
+    AsUnplacedBox()->dimensions(), *this->matrix(), positions, directions,
+    step_max, output
+  );
+  #elif defined(VECGEOM_VECTOR_BACKEND)
+  BoxDistanceToInBasket<trans_code, rot_code, kVectorImpl>(
+    AsUnplacedBox()->dimensions(), *this->matrix(), positions, directions,
+    step_max, output
+  );
+  #else
+  for (int i = 0, i_max = positions.size(); i < i_max; ++i) {
+    output[i] = DistanceToInTemplate<trans_code, rot_code, kScalar>(
+      positions[i], directions[i], step_max[i]
+    );
+  }
+  #endif
+}
+
 VECGEOM_CUDA_HEADER_BOTH
 VECGEOM_INLINE
 UnplacedBox const* PlacedBox::AsUnplacedBox() const {
@@ -2,6 +2,7 @@
 #define VECGEOM_VOLUMES_PLACEDVOLUME_H_
 
 #include "base/global.h"
+#include "base/soa3d.h"
 #include "base/transformation_matrix.h"
 #include "management/geo_manager.h"
 #include "volumes/logical_volume.h"
@@ -12,7 +13,7 @@ class VPlacedVolume {
 
 private:
 
-  // int id;
+  int id_;
 
   friend class CudaManager;
 
@@ -23,12 +24,29 @@ protected:
 
 public:
 
+  /**
+   * Volumes constructed on the host are registered with the GeoManager, which
+   * assigns them a unique id. Safe to call from multiple threads.
+   */
   VECGEOM_CUDA_HEADER_BOTH
   VPlacedVolume(LogicalVolume const *const logical_volume,
                 TransformationMatrix const *const matrix)
-      : logical_volume_(logical_volume), matrix_(matrix) {}
+      : logical_volume_(logical_volume), matrix_(matrix) {
+    #ifndef VECGEOM_NVCC
+    id_ = GeoManager::Instance().RegisterVolume(this);
+    #else
+    id_ = -1;
+    #endif
+  }
+
+  virtual ~VPlacedVolume();
 
-  virtual ~VPlacedVolume() {}
+  /**
+   * \return Globally unique id assigned at construction.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  VECGEOM_INLINE
+  int id() const { return id_; }
 
   VECGEOM_CUDA_HEADER_BOTH
   VECGEOM_INLINE
@@ -73,6 +91,56 @@ public:
                                  Vector3D<Precision> const &direction,
                                  const Precision step_max) const =0;
 
+  /**
+   * Computes the distance to leave the volume from a point inside it. Unlike
+   * the other methods, position and direction are given in the local frame of
+   * the volume.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Precision DistanceToOut(
+      Vector3D<Precision> const &position,
+      Vector3D<Precision> const &direction) const =0;
+
+  /**
+   * Variant of DistanceToOut() that also reports the face through which the
+   * point leaves, as numbered by VUnplacedVolume::FacePoint(), or -1 if it
+   * cannot be determined.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Precision DistanceToOut(Vector3D<Precision> const &position,
+                                  Vector3D<Precision> const &direction,
+                                  int *const face) const =0;
+
+  /**
+   * \return Lower bound of the distance from a point outside the volume to
+   *         the volume in any direction, negative if the point is inside.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Precision SafetyToIn(Vector3D<Precision> const &position) const =0;
+
+  /**
+   * \return Lower bound of the distance from a point inside the volume to
+   *         its surface in any direction, negative if the point is outside.
+   *         Like DistanceToOut(), the point is given in the local frame.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Precision SafetyToOut(Vector3D<Precision> const &position) const =0;
+
+  // Basket methods. Process all points of the input in one call, using the
+  // vector backend if available.
+
+  virtual void Inside(SOA3D<Precision> const &points,
+                      bool *const output) const =0;
+
+  virtual void DistanceToIn(SOA3D<Precision> const &positions,
+                            SOA3D<Precision> const &directions,
+                            Precision const *const step_max,
+                            Precision *const output) const =0;
+
+  virtual void DistanceToOut(SOA3D<Precision> const &positions,
+                             SOA3D<Precision> const &directions,
+                             Precision *const output) const =0;
+
   #ifdef VECGEOM_CUDA
   virtual VPlacedVolume* CopyToGpu(LogicalVolume const *const logical_volume,
                                    TransformationMatrix const *const matrix,
@@ -0,0 +1,131 @@
+#ifndef VECGEOM_VOLUMES_REPLICAPLACEMENT_H_
+#define VECGEOM_VOLUMES_REPLICAPLACEMENT_H_
+
+#include "base/global.h"
+#include "base/transformation_matrix.h"
+#include "base/vector3d.h"
+
+namespace vecgeom {
+
+enum ReplicaAxis { kReplicaX = 0, kReplicaY = 1, kReplicaZ = 2 };
+
+/**
+ * Regular division of a region of a mother volume into identical box cells
+ * along one Cartesian axis. Copy i is centered at
+ * offset + (i - (copies - 1)/2)*pitch along the axis and at the origin of the
+ * mother along the other axes, without rotation, so the cells fill a box
+ * envelope without gaps.
+ *
+ * All copies share a single placement of the cell at the origin of the
+ * mother, and navigation states carry the index of the copy along with it.
+ * Nothing is stored per copy: the translation of a copy follows from its
+ * index, and the copy containing a point or entered along a ray is computed
+ * by integer division instead of testing every copy.
+ */
+class ReplicaPlacement {
+
+private:
+
+  ReplicaAxis axis_;
+  int copies_;
+  Precision pitch_;
+  Precision offset_;
+  // Lower edge of the first copy along the axis
+  Precision start_;
+  Vector3D<Precision> envelope_;
+  TransformationMatrix envelope_matrix_;
+  // Identity, at which the shared placement of the cell stands
+  TransformationMatrix cell_matrix_;
+  VPlacedVolume const *cell_;
+
+public:
+
+  /**
+   * \param dimensions Half lengths of the box cell, which must be half the
+   *                   pitch along the axis.
+   */
+  ReplicaPlacement(Vector3D<Precision> const &dimensions,
+                   const ReplicaAxis axis, const int copies,
+                   const Precision pitch, const Precision offset);
+
+  ReplicaAxis axis() const { return axis_; }
+
+  int copies() const { return copies_; }
+
+  Precision pitch() const { return pitch_; }
+
+  Precision offset() const { return offset_; }
+
+  /**
+   * \return Half lengths of the box filled by all copies.
+   */
+  Vector3D<Precision> const& envelope() const { return envelope_; }
+
+  TransformationMatrix const* cell_matrix() const { return &cell_matrix_; }
+
+  /**
+   * \return Placement of the cell shared by all copies.
+   */
+  VPlacedVolume const* cell() const { return cell_; }
+
+  void set_cell(VPlacedVolume const *const cell) { cell_ = cell; }
+
+  /**
+   * \return Position of the center of the given copy along the axis.
+   */
+  Precision Center(const int copy) const {
+    return start_ + (copy + 0.5)*pitch_;
+  }
+
+  /**
+   * \return Point in the frame of the mother moved to the frame in which the
+   *         shared placement of the cell stands for the given copy.
+   */
+  Vector3D<Precision> ToCopy(Vector3D<Precision> point, const int copy) const {
+    point[axis_] -= Center(copy);
+    return point;
+  }
+
+  /**
+   * \return Translation of the given copy, composed on request.
+   */
+  TransformationMatrix Matrix(const int copy) const;
+
+  /**
+   * \return Index of the copy whose slice along the axis contains the point,
+   *         which is outside [0, copies()) for points beyond the envelope.
+   */
+  int Index(Vector3D<Precision> const &point) const;
+
+  /**
+   * \param point Point in the frame of the mother.
+   * \return Index of the copy containing the point, or -1 if none does. Only
+   *         the copy selected by Index() is tested.
+   */
+  int Locate(Vector3D<Precision> const &point) const;
+
+  /**
+   * Finds the first copy hit by a ray from a point outside all copies. As the
+   * copies fill the envelope, a ray from outside enters the copy at the point
+   * where it enters the envelope. Points inside the envelope lie on the
+   * boundary between two copies, and enter the copy ahead of the closest
+   * boundary along the axis.
+   * \param step Distance to beat, updated if a copy is hit before it.
+   * \param copy Output index of the copy hit before the step, left unchanged
+   *             otherwise.
+   */
+  void DistanceToIn(Vector3D<Precision> const &point,
+                    Vector3D<Precision> const &direction,
+                    Precision *const step, int *const copy) const;
+
+  /**
+   * \return Lower bound of the distance from a point in the frame of the
+   *         mother to any copy, given by the distance to the envelope.
+   */
+  Precision SafetyToIn(Vector3D<Precision> const &point) const;
+
+};
+
+} // End namespace vecgeom
+
+#endif // VECGEOM_VOLUMES_REPLICAPLACEMENT_H_
\ No newline at end of file
@@ -2,8 +2,10 @@
 #define VECGEOM_VOLUMES_SPECIALIZEDBOX_H_
 
 #include "base/global.h"
+#include "base/instrumentation.h"
 #include "backend/scalar_backend.h"
 #include "base/transformation_matrix.h"
+#include "management/isa_dispatch.h"
 #include "volumes/placed_box.h"
 #ifdef VECGEOM_CUDA
 #include <stdio.h>
@@ -30,6 +32,17 @@ public:
                                  Vector3D<Precision> const &direction,
                                  const Precision step_max) const;
 
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Precision SafetyToIn(Vector3D<Precision> const &position) const;
+
+  virtual void Inside(SOA3D<Precision> const &points,
+                      bool *const output) const;
+
+  virtual void DistanceToIn(SOA3D<Precision> const &positions,
+                            SOA3D<Precision> const &directions,
+                            Precision const *const step_max,
+                            Precision *const output) const;
+
   virtual int memory_size() const { return sizeof(*this); }
 
   #ifdef VECGEOM_CUDA
@@ -47,6 +60,7 @@ template <TranslationCode trans_code, RotationCode rot_code>
 VECGEOM_CUDA_HEADER_BOTH
 bool SpecializedBox<trans_code, rot_code>::Inside(
     Vector3D<Precision> const &point) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelInside, this->id(), 1);
   return PlacedBox::template InsideTemplate<trans_code, rot_code, kScalar>(
            point
          );
@@ -58,13 +72,60 @@ Precision SpecializedBox<trans_code, rot_code>::DistanceToIn(
     Vector3D<Precision> const &position,
     Vector3D<Precision> const &direction,
     const Precision step_max) const {
-
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelDistanceToIn, this->id(), 1);
   return PlacedBox::template DistanceToInTemplate<trans_code, rot_code,
                                                   kScalar>(position, direction,
                                                            step_max);
                                                   
 }
 
+template <TranslationCode trans_code, RotationCode rot_code>
+VECGEOM_CUDA_HEADER_BOTH
+Precision SpecializedBox<trans_code, rot_code>::SafetyToIn(
+    Vector3D<Precision> const &position) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelSafetyToIn, this->id(), 1);
+  return PlacedBox::template SafetyToInTemplate<trans_code, rot_code,
+                                                kScalar>(position);
+}
+
+template <TranslationCode trans_code, RotationCode rot_code>
+void SpecializedBox<trans_code, rot_code>::Inside(
+    SOA3D<Precision> const &points, bool *const output) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelInsideBasket, this->id(),
+                     points.size());
+  #ifdef VECGEOM_ISA_DISPATCH
+  // Kernels bound at runtime handle general transformations, and are preferred
+  // over the specialized baseline for their wider vectors
+  if (BoxBasketKernels::InsideKernel kernel =
+          IsaDispatch::Instance().box().inside) {
+    kernel(this->dimensions(), *this->matrix(), points, output);
+    return;
+  }
+  #endif
+  PlacedBox::template InsideBasket<trans_code, rot_code>(points, output);
+}
+
+template <TranslationCode trans_code, RotationCode rot_code>
+void SpecializedBox<trans_code, rot_code>::DistanceToIn(
+    SOA3D<Precision> const &positions,
+    SOA3D<Precision> const &directions,
+    Precision const *const step_max,
+    Precision *const output) const {
+  VECGEOM_INSTRUMENT(kInstrumentedBox, kKernelDistanceToInBasket, this->id(),
+                     positions.size());
+  #ifdef VECGEOM_ISA_DISPATCH
+  if (BoxBasketKernels::DistanceToInKernel kernel =
+          IsaDispatch::Instance().box().distance_to_in) {
+    kernel(this->dimensions(), *this->matrix(), positions, directions,
+           step_max, output);
+    return;
+  }
+  #endif
+  PlacedBox::template DistanceToInBasket<trans_code, rot_code>(
+    positions, directions, step_max, output
+  );
+}
+
 #ifdef VECGEOM_CUDA
 
 namespace {
@@ -55,19 +55,45 @@ public:
     return 4.0*dimensions_[0]*dimensions_[1]*dimensions_[2];
   }
 
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Precision BoundingRadius() const { return dimensions_.Length(); }
+
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Vector3D<Precision> BoundingExtent() const { return dimensions_; }
+
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual int FaceCount() const { return 6; }
+
+  /**
+   * Faces are numbered 2*axis for the face at -dimensions[axis] and 2*axis+1
+   * for the face at +dimensions[axis]. The point is the center of the face.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual void FacePoint(const int face, Vector3D<Precision> &point,
+                         Vector3D<Precision> &normal) const {
+    const int axis = face / 2;
+    const Precision sign = (face % 2) ? 1 : -1;
+    point = Vector3D<Precision>(0, 0, 0);
+    normal = Vector3D<Precision>(0, 0, 0);
+    point[axis] = sign*dimensions_[axis];
+    normal[axis] = sign;
+  }
+
   VECGEOM_CUDA_HEADER_BOTH
   virtual void Print() const;
 
   template <TranslationCode trans_code, RotationCode rot_code>
   static VPlacedVolume* Create(LogicalVolume const *const logical_volume,
-                               TransformationMatrix const *const matrix);
+                               TransformationMatrix const *const matrix,
+                               VPlacedVolume *const placement = NULL);
   
 private:
 
   virtual VPlacedVolume* SpecializedVolume(
       LogicalVolume const *const volume,
       TransformationMatrix const *const matrix,
-      const TranslationCode trans_code, const RotationCode rot_code) const;
+      const TranslationCode trans_code, const RotationCode rot_code,
+      VPlacedVolume *const placement) const;
 
   virtual void Print(std::ostream &os) const {
     os << "Box {" << dimensions_ << "}";
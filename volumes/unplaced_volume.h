@@ -15,6 +15,8 @@ private:
 
 public:
 
+  virtual ~VUnplacedVolume() {}
+
   /**
    * Uses the virtual print method.
    * \sa print(std::ostream &ps)
@@ -36,15 +38,61 @@ public:
   virtual VUnplacedVolume* CopyToGpu(VUnplacedVolume *const gpu_ptr) const =0;
   #endif
 
+  /**
+   * \return Radius of a sphere around the origin of the local frame that
+   *         contains the volume.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Precision BoundingRadius() const =0;
+
+  /**
+   * \return Half lengths of an axis-aligned box centered on the origin of the
+   *         local frame that contains the volume.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual Vector3D<Precision> BoundingExtent() const =0;
+
+  /**
+   * \return Number of faces reported by the face variant of
+   *         VPlacedVolume::DistanceToOut().
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual int FaceCount() const =0;
+
+  /**
+   * \return Point on the given face and outward unit normal of the face at
+   *         that point, in the local frame.
+   */
+  VECGEOM_CUDA_HEADER_BOTH
+  virtual void FacePoint(const int face, Vector3D<Precision> &point,
+                         Vector3D<Precision> &normal) const =0;
+
   /**
    * C-style printing for CUDA purposes.
    */
   VECGEOM_CUDA_HEADER_BOTH
   virtual void Print() const =0;
 
+  /**
+   * Creates a specialized placed volume for the given transformation.
+   * \param placement Optional memory in which to construct the placed volume.
+   *                  Must be at least as large as the memory_size() of the
+   *                  created object. If NULL, the volume is heap allocated.
+   */
   VPlacedVolume* PlaceVolume(
       LogicalVolume const *const volume,
-      TransformationMatrix const *const matrix) const;
+      TransformationMatrix const *const matrix,
+      VPlacedVolume *const placement = NULL) const;
+
+  /**
+   * Creates a placed volume using the general transformation kernels, ignoring
+   * any properties of the matrix. Mainly useful to measure the benefit of
+   * specialization.
+   */
+  VPlacedVolume* PlaceVolumeUnspecialized(
+      LogicalVolume const *const volume,
+      TransformationMatrix const *const matrix,
+      VPlacedVolume *const placement = NULL) const;
 
 private:
 
@@ -57,7 +105,8 @@ private:
   virtual VPlacedVolume* SpecializedVolume(
       LogicalVolume const *const volume,
       TransformationMatrix const *const matrix,
-      const TranslationCode trans_code, const RotationCode rot_code) const =0;
+      const TranslationCode trans_code, const RotationCode rot_code,
+      VPlacedVolume *const placement) const =0;
 
 };
 